@@ -11,6 +11,7 @@
 #include <optional>
 #include <sstream>
 #include <stdio.h>
+#include <string_view>
 #include <vector>
 
 #include <GL/glew.h> // Initialize with glewInit()
@@ -26,8 +27,12 @@ import Lateralus.Core.EncodingConversion;
 import Lateralus.Platform;
 #if ENABLE_IMGUI
 import Lateralus.Platform.ImGuiWidget.Core;
+import Lateralus.Platform.ImGuiWidget.Memory;
+import Lateralus.Platform.ImGuiWidget.Profiler;
 #endif
+import Lateralus.Platform.PerfCounters;
 import Lateralus.Platform.Platform;
+import Lateralus.Platform.ProfileCapture;
 import Lateralus.Platform.Window;
 
 using namespace Lateralus::Core;
@@ -115,7 +120,7 @@ void create_triangle(unsigned int &vbo, unsigned int &vao, unsigned int &ebo)
     glBindVertexArray(0);
 }
 
-int main(int, char **)
+int main(int argc, char **argv)
 {
     using namespace std;
     using namespace Lateralus;
@@ -162,6 +167,21 @@ int main(int, char **)
         return 4;
     }
 
+    // For soak tests: save the seconds before any frame that takes over a tenth of a second. Also
+    // available from the profiler widget.
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (string_view(argv[arg]) == "--capture-hitches")
+        {
+            Lateralus::Platform::ProfileCapture::EnableHitchCapture({});
+        }
+    }
+
+    if (auto err = Lateralus::Platform::PerfCounters::Enable(); err.has_value())
+    {
+        LOG_WARN("Profiling without hardware counters: {}", err.value().GetErrorMessage());
+    }
+
     // create our geometries
     unsigned int vbo, vao, ebo;
     create_triangle(vbo, vao, ebo);
@@ -205,6 +225,8 @@ int main(int, char **)
         ImGui::End();
 
         Lateralus::Platform::ImGuiWidget::Core();
+        Lateralus::Platform::ImGuiWidget::Memory();
+        Lateralus::Platform::ImGuiWidget::Profiler();
 
         ImGui::Begin("Conan logo");
         // render_conan_logo();
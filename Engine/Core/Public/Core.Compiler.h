@@ -0,0 +1,10 @@
+#pragma once
+
+// Compiler specific attributes.
+
+// Keeps a function from being inlined into its callers.
+#if defined(_MSC_VER)
+#define LAT_NOINLINE __declspec(noinline)
+#else
+#define LAT_NOINLINE __attribute__((noinline))
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+
+// Instrumentation for Lateralus.Core.Profile, which has to be imported wherever these are used.
+// Macros can't be exported from a module, so they live here. In CONF_RETAIL they expand to nothing.
+//
+//     void Window::Render()
+//     {
+//         LAT_PROFILE_FUNCTION();
+//         {
+//             LAT_PROFILE_ZONE("Render ImGui");
+//             ...
+//         }
+//         LAT_PROFILE_COUNTER("Draw calls", drawCalls);
+//     }
+
+#define LAT_PROFILE_CONCAT_INNER(a, b) a##b
+#define LAT_PROFILE_CONCAT(a, b) LAT_PROFILE_CONCAT_INNER(a, b)
+
+#if !CONF_RETAIL
+// Times the rest of the enclosing scope. name must be a string literal, or outlive the program's
+// profiling.
+#define LAT_PROFILE_ZONE(name)                                                                     \
+    static constexpr ::Lateralus::Core::Profile::ZoneSite LAT_PROFILE_CONCAT(latZoneSite_,         \
+                                                                             __LINE__){            \
+        name, __FILE__, __LINE__};                                                                 \
+    ::Lateralus::Core::Profile::ScopedZone LAT_PROFILE_CONCAT(latZone_, __LINE__)(                 \
+        &LAT_PROFILE_CONCAT(latZoneSite_, __LINE__))
+#define LAT_PROFILE_FUNCTION() LAT_PROFILE_ZONE(__func__)
+// As LAT_PROFILE_ZONE, also recording hardware counters across the zone where the platform can
+// read them (see Core::Profile::SetHardwareCounterReader). Reading them costs far more than the
+// zone itself, so keep it to zones covering a whole system's work.
+#define LAT_PROFILE_ZONE_COUNTERS(name)                                                            \
+    static constexpr ::Lateralus::Core::Profile::ZoneSite LAT_PROFILE_CONCAT(latZoneSite_,         \
+                                                                             __LINE__){            \
+        name, __FILE__, __LINE__};                                                                 \
+    ::Lateralus::Core::Profile::ScopedCountedZone LAT_PROFILE_CONCAT(latZone_, __LINE__)(          \
+        &LAT_PROFILE_CONCAT(latZoneSite_, __LINE__))
+// Samples a counter, shown in captures as a graph over time. name has the same lifetime rules as
+// for LAT_PROFILE_ZONE; value is anything convertible to double, and isn't evaluated in retail.
+#define LAT_PROFILE_COUNTER(name, value)                                                           \
+    ::Lateralus::Core::Profile::SampleCounter(name, static_cast<double>(value))
+#else
+#define LAT_PROFILE_ZONE(name)
+#define LAT_PROFILE_FUNCTION()
+#define LAT_PROFILE_ZONE_COUNTERS(name)
+#define LAT_PROFILE_COUNTER(name, value)
+#endif
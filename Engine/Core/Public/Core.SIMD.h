@@ -0,0 +1,161 @@
+#pragma once
+
+// Compile time SIMD detection.
+// Macros can't be exported from a module, so this header is the single place the instruction set
+// a translation unit is compiled for gets decided. Lateralus.Core.SIMDSupport builds the
+// SSEVersion/NeonVersion enums from these values and Lateralus.Core.SIMD picks its register types
+// with them.
+
+#define LATERALUS_SSE_NONE 0x00
+#define LATERALUS_SSE1     0x10
+#define LATERALUS_SSE2     0x20
+#define LATERALUS_SSE3     0x30
+#define LATERALUS_SSSE3    0x31
+#define LATERALUS_SSE4_1   0x41
+#define LATERALUS_SSE4_2   0x42
+#define LATERALUS_AVX      0x50
+#define LATERALUS_AVX2     0x60
+#define LATERALUS_AVX512   0x70
+
+#if defined(_MSC_VER)
+#   if defined(__AVX512__) || defined(__AVX512F__) // the first define is a guess.
+#       define LATERALUS_SSE_CURRENT LATERALUS_AVX512
+#   elif defined(__AVX2__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_AVX2
+#   elif defined(__AVX__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_AVX
+#   elif defined(_M_X64) || defined(_M_AMD64)
+// _M_IX86_FP isn't defined for x64 targets, but SSE2 is part of the base x64 instruction set.
+#       define LATERALUS_SSE_CURRENT LATERALUS_SSE2
+#   elif defined(_M_IX86_FP)
+#       if _M_IX86_FP == 1
+#           define LATERALUS_SSE_CURRENT LATERALUS_SSE1
+#       elif _M_IX86_FP == 2
+#           define LATERALUS_SSE_CURRENT LATERALUS_SSE2
+#       else
+#           define LATERALUS_SSE_CURRENT LATERALUS_SSE1
+#       endif
+#   else
+#       define LATERALUS_SSE_CURRENT LATERALUS_SSE_NONE
+#       define LATERALUS_HAS_SSE 0
+#   endif
+#elif defined(__clang__) || defined (__GNUC__)
+#   if defined(__AVX512__) || defined(__AVX512F__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_AVX512
+#   elif defined(__AVX2__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_AVX2
+#   elif defined(__AVX__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_AVX
+#   elif defined(__SSE4_2__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_SSE4_2
+#   elif defined(__SSE4_1__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_SSE4_1
+#   elif defined(__SSSE3__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_SSSE3
+#   elif defined(__SSE3__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_SSE3
+#   elif defined(__SSE2__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_SSE2
+#   elif defined(__SSE__)
+#       define LATERALUS_SSE_CURRENT LATERALUS_SSE1
+#else
+#       define LATERALUS_SSE_CURRENT LATERALUS_SSE_NONE
+#       define LATERALUS_HAS_SSE 0
+#   endif
+#else
+#   define LATERALUS_SSE_CURRENT LATERALUS_SSE_NONE
+#   define LATERALUS_HAS_SSE 0
+#endif
+
+#if !defined(LATERALUS_HAS_SSE)
+#    define LATERALUS_HAS_SSE 1
+#endif
+
+// FMA3 shipped alongside AVX2 on every CPU we target. MSVC has no define for it so we assume it
+// with /arch:AVX2, gcc and clang tell us directly.
+#if defined(_MSC_VER)
+#   if LATERALUS_SSE_CURRENT >= LATERALUS_AVX2
+#       define LATERALUS_HAS_FMA 1
+#   endif
+#elif defined(__FMA__)
+#   define LATERALUS_HAS_FMA 1
+#endif
+
+#if !defined(LATERALUS_HAS_FMA)
+#    define LATERALUS_HAS_FMA 0
+#endif
+
+#define LATERALUS_NEON_NONE 0x00
+#define LATERALUS_NEON7     0x70
+
+#if LATERALUS_HAS_SSE == 0
+#   if defined(_MSC_VER)
+#       if defined(_M_ARM) || defined(_M_ARM64)
+#           define LATERALUS_NEON_CURRENT LATERALUS_NEON7
+#       else
+#           define LATERALUS_NEON_CURRENT LATERALUS_NEON_NONE
+#           define LATERALUS_HAS_NEON 0
+#       endif
+#   elif defined(__clang__) || defined (__GNUC__)
+#       if (defined(__arm__) && defined(__ARM_NEON__)) || defined(__ARM_NEON)
+#           define LATERALUS_NEON_CURRENT LATERALUS_NEON7
+#       else
+#           define LATERALUS_NEON_CURRENT LATERALUS_NEON_NONE
+#           define LATERALUS_HAS_NEON 0
+#       endif
+#   else
+#       define LATERALUS_NEON_CURRENT LATERALUS_NEON_NONE
+#       define LATERALUS_HAS_NEON 0
+#   endif
+#else
+#   define LATERALUS_NEON_CURRENT LATERALUS_NEON_NONE
+#   define LATERALUS_HAS_NEON 0
+#endif
+
+#if !defined(LATERALUS_HAS_NEON)
+#    define LATERALUS_HAS_NEON 1
+#endif
+
+// Which register backend Lateralus.Core.SIMD uses. Exactly one of these is 1.
+// SSE2 is the minimum we write x86 code paths for (it's the x64 baseline).
+#if LATERALUS_SSE_CURRENT >= LATERALUS_SSE2
+#   define LATERALUS_SIMD_SSE 1
+#   define LATERALUS_SIMD_NEON 0
+#   define LATERALUS_SIMD_SCALAR 0
+#elif LATERALUS_HAS_NEON
+#   define LATERALUS_SIMD_SSE 0
+#   define LATERALUS_SIMD_NEON 1
+#   define LATERALUS_SIMD_SCALAR 0
+#else
+#   define LATERALUS_SIMD_SSE 0
+#   define LATERALUS_SIMD_NEON 0
+#   define LATERALUS_SIMD_SCALAR 1
+#endif
+
+// 8-wide registers are native with AVX, otherwise Lateralus.Core.SIMD emulates them with pairs of
+// 4-wide registers.
+#if LATERALUS_SIMD_SSE && LATERALUS_SSE_CURRENT >= LATERALUS_AVX
+#   define LATERALUS_SIMD_AVX 1
+#else
+#   define LATERALUS_SIMD_AVX 0
+#endif
+
+// Function attributes for kernels that use a newer instruction set than the translation unit is
+// compiled for. Those kernels must only be reached through Lateralus.Core.Dispatch after the CPU
+// has been checked. MSVC allows any intrinsic in any function so the attributes are empty there.
+#if LATERALUS_SIMD_SSE && (defined(__clang__) || defined(__GNUC__))
+#   define LATERALUS_TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#   define LATERALUS_TARGET_AVX2 __attribute__((target("avx2,fma,bmi")))
+#   define LATERALUS_TARGET_AVX512                                                               \
+        __attribute__((target("avx2,fma,bmi,avx512f,avx512dq,avx512bw,avx512vl")))
+#else
+#   define LATERALUS_TARGET_SSE4_1
+#   define LATERALUS_TARGET_AVX2
+#   define LATERALUS_TARGET_AVX512
+#endif
+
+#if LATERALUS_SIMD_SSE
+#include <immintrin.h>
+#elif LATERALUS_SIMD_NEON
+#include <arm_neon.h>
+#endif
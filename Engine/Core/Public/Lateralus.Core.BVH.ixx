@@ -0,0 +1,676 @@
+module;
+
+#include <Core.Assert.h>
+
+export module Lateralus.Core.BVH;
+
+import <algorithm>;
+import <array>;
+import <bit>;
+import <limits>;
+import <optional>;
+import <span>;
+import <thread>;
+import <vector>;
+
+import Lateralus.Core;
+import Lateralus.Core.Frustum;
+import Lateralus.Core.Math;
+import Lateralus.Core.Vector;
+
+namespace Lateralus::Core
+{
+/// <summary>
+/// One node of a flattened BVH, two to a cache line. Nodes are stored in depth-first order, so an
+/// interior node's left child directly follows it and only the right child needs an index.
+/// </summary>
+export struct BVHNode
+{
+    Vector3 Min;
+    // Leaf: the first of its primitives in BVH::GetPrimitiveIndices. Interior: the right child.
+    uint32 Offset = 0;
+    Vector3 Max;
+    // Primitives in a leaf, 0 for interior nodes.
+    uint16 Count = 0;
+    // The axis an interior node was split along; orders children front to back for rays.
+    uint16 Axis = 0;
+
+    bool IsLeaf() const { return Count != 0; }
+};
+
+static_assert(sizeof(BVHNode) == 32);
+
+export struct Ray
+{
+    Vector3 Origin;
+    Vector3 Direction;
+    // Distances are measured in multiples of Direction.
+    float MaxDistance = std::numeric_limits<float>::max();
+};
+
+export struct BVHBuildSettings
+{
+    usz MaxLeafSize = 4;
+    // Candidate split planes per axis and node, at most 32.
+    usz BinCount = 16;
+    // Threads building the upper subtrees in parallel. 1 builds on the calling thread.
+    usz ThreadCount = 1;
+};
+
+export struct RayHit
+{
+    uint32 Primitive = 0;
+    float Distance = 0.0f;
+};
+
+constexpr usz k_MaxBins = 32;
+// Below this depth splits fall back to the median, which bounds the depth for any input: at most
+// 32 more levels for 2^32 primitives.
+constexpr usz k_MedianSplitDepth = 48;
+// The traversal stack holds at most one pending sibling per level, plus the two children pushed.
+constexpr usz k_StackSize = k_MedianSplitDepth + 32 + 2;
+// Relative cost of visiting a node compared to testing one primitive.
+constexpr float k_TraversalCost = 1.0f;
+// Subtrees smaller than this aren't worth a thread.
+constexpr usz k_MinParallelPrimitives = 4096;
+constexpr uint32 k_NoParent = ~0u;
+
+struct Bounds
+{
+    Vector3 Min{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                std::numeric_limits<float>::max()};
+    Vector3 Max{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                std::numeric_limits<float>::lowest()};
+
+    void Grow(Vector3 const &point)
+    {
+        Min = Vector3(Core::Min(Min.x, point.x), Core::Min(Min.y, point.y),
+                      Core::Min(Min.z, point.z));
+        Max = Vector3(Core::Max(Max.x, point.x), Core::Max(Max.y, point.y),
+                      Core::Max(Max.z, point.z));
+    }
+
+    void Grow(Vector3 const &min, Vector3 const &max)
+    {
+        Grow(min);
+        Grow(max);
+    }
+
+    // Half the surface area, which is all the SAH needs.
+    float HalfArea() const
+    {
+        Vector3 const size = Max - Min;
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+};
+
+float Component(Vector3 const &v, usz axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+// Narrows [enter, exit] to where the ray is between the box's planes on one axis. A ray parallel
+// to them has an infinite inverse direction, and starting on one of the planes would make that
+// 0 * inf = NaN, so it's either between them the whole way or never.
+bool ClipSlab(float min, float max, float origin, float inverseDirection, float &enter,
+              float &exit)
+{
+    if (Abs(inverseDirection) == std::numeric_limits<float>::infinity())
+    {
+        return min <= origin && origin <= max;
+    }
+    float const t0 = (min - origin) * inverseDirection;
+    float const t1 = (max - origin) * inverseDirection;
+    enter = Max(enter, Min(t0, t1));
+    exit = Min(exit, Max(t0, t1));
+    return true;
+}
+
+// Entry distance of the ray into the box, if it enters before maxDistance.
+bool IntersectRay(Vector3 const &min, Vector3 const &max, Vector3 const &origin,
+                  Vector3 const &inverseDirection, float maxDistance, float &entry)
+{
+    float enter = 0.0f;
+    float exit = maxDistance;
+    if (!ClipSlab(min.x, max.x, origin.x, inverseDirection.x, enter, exit) ||
+        !ClipSlab(min.y, max.y, origin.y, inverseDirection.y, enter, exit) ||
+        !ClipSlab(min.z, max.z, origin.z, inverseDirection.z, enter, exit))
+    {
+        return false;
+    }
+    entry = enter;
+    return enter <= exit;
+}
+
+bool IntersectSphere(Vector3 const &min, Vector3 const &max, BoundingSphere const &sphere)
+{
+    // Distance from the center to the closest point of the box.
+    Vector3 const &c = sphere.Center;
+    Vector3 const d(Max(min.x - c.x, 0.0f, c.x - max.x), Max(min.y - c.y, 0.0f, c.y - max.y),
+                    Max(min.z - c.z, 0.0f, c.z - max.z));
+    return d.LengthSq() <= sphere.Radius * sphere.Radius;
+}
+
+/// <summary>
+/// Bounding volume hierarchy over axis aligned boxes, for ray casts, sphere overlaps and frustum
+/// queries against many objects.
+///
+/// Build splits nodes with a binned surface area heuristic. Moving objects can be handled with
+/// Refit, which keeps the topology and only updates bounds; that's much cheaper than a build but
+/// the tree gets worse as objects move away from where they were built, so rebuild every so often.
+///
+/// Primitives are identified by their index in the span given to Build. Queries test the stored
+/// primitive boxes, so they report a primitive when its box is hit; exact tests against the real
+/// shape are up to the caller.
+/// </summary>
+export class BVH
+{
+public:
+    void Build(std::span<AABB const> bounds, BVHBuildSettings const &settings = {})
+    {
+        LAT_ASSERT(settings.MaxLeafSize >= 1 &&
+                   settings.MaxLeafSize <= std::numeric_limits<uint16>::max());
+        LAT_ASSERT(settings.BinCount >= 2 && settings.BinCount <= k_MaxBins);
+        LAT_ASSERT(bounds.size() < std::numeric_limits<uint32>::max());
+
+        m_Nodes.clear();
+        m_PrimitiveIndices.resize(bounds.size());
+        for (usz i = 0; i < bounds.size(); ++i)
+        {
+            m_PrimitiveIndices[i] = static_cast<uint32>(i);
+        }
+        if (bounds.empty())
+        {
+            m_PrimitiveBounds.clear();
+            m_Parents.clear();
+            m_PrimitiveLeaves.clear();
+            return;
+        }
+
+        std::vector<Vector3> centroids(bounds.size());
+        for (usz i = 0; i < bounds.size(); ++i)
+        {
+            centroids[i] = bounds[i].Center;
+        }
+        BuildContext const context{bounds, centroids, settings};
+        // Each parallel level doubles the number of threads working.
+        usz const parallelDepth =
+            settings.ThreadCount > 1 ? std::bit_width(settings.ThreadCount - 1) : 0;
+        m_Nodes.reserve(2 * bounds.size() / settings.MaxLeafSize + 1);
+        BuildNode(context, m_Nodes, 0, bounds.size(), 0, parallelDepth);
+
+        m_PrimitiveBounds.resize(bounds.size());
+        for (usz i = 0; i < bounds.size(); ++i)
+        {
+            m_PrimitiveBounds[i] = bounds[m_PrimitiveIndices[i]];
+        }
+        LinkNodes();
+    }
+
+    // Recomputes every node from bounds, which must be indexed like the span given to Build.
+    void Refit(std::span<AABB const> bounds)
+    {
+        LAT_ASSERT(bounds.size() == m_PrimitiveIndices.size());
+        for (usz i = 0; i < bounds.size(); ++i)
+        {
+            m_PrimitiveBounds[i] = bounds[m_PrimitiveIndices[i]];
+        }
+        // Children always come after their parent, so walking backwards sees them first.
+        for (usz i = m_Nodes.size(); i-- > 0;)
+        {
+            RefitNode(static_cast<uint32>(i));
+        }
+    }
+
+    /// <summary>
+    /// Updates only the primitives listed in changed and the nodes above them. Cheaper than a full
+    /// Refit when a small part of the scene moves.
+    /// </summary>
+    void Refit(std::span<AABB const> bounds, std::span<uint32 const> changed)
+    {
+        LAT_ASSERT(bounds.size() == m_PrimitiveIndices.size());
+        for (uint32 primitive : changed)
+        {
+            LAT_ASSERT(primitive < bounds.size());
+            uint32 const leaf = m_PrimitiveLeaves[primitive];
+            m_PrimitiveBounds[FindSlot(primitive)] = bounds[primitive];
+            // Walk up until a node doesn't change: everything above it depends only on its bounds.
+            for (uint32 index = leaf; index != k_NoParent; index = m_Parents[index])
+            {
+                if (!RefitNode(index))
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    /// Finds the closest primitive hit by the ray. hitTest is called as
+    /// hitTest(uint32 primitive, float maxDistance) -> std::optional<float> for every primitive
+    /// whose box the ray enters before the closest hit so far, and returns the distance where the
+    /// ray hits the primitive itself.
+    /// </summary>
+    template <typename HitTest>
+    std::optional<RayHit> Raycast(Ray const &ray, HitTest &&hitTest) const
+    {
+        return Traverse(ray, [&](usz slot, float, float maxDistance) {
+            return hitTest(m_PrimitiveIndices[slot], maxDistance);
+        });
+    }
+
+    // The closest primitive box hit by the ray.
+    std::optional<RayHit> Raycast(Ray const &ray) const
+    {
+        return Traverse(ray, [](usz, float entry, float) { return std::optional<float>(entry); });
+    }
+
+    // Calls visit(uint32 primitive) for every primitive whose box overlaps the sphere.
+    template <typename Visit> void OverlapSphere(BoundingSphere const &sphere, Visit &&visit) const
+    {
+        if (m_Nodes.empty())
+        {
+            return;
+        }
+        std::array<uint32, k_StackSize> stack;
+        usz stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            uint32 const index = stack[--stackSize];
+            BVHNode const &node = m_Nodes[index];
+            if (!IntersectSphere(node.Min, node.Max, sphere))
+            {
+                continue;
+            }
+            if (node.IsLeaf())
+            {
+                for (usz slot = node.Offset; slot < node.Offset + node.Count; ++slot)
+                {
+                    AABB const &box = m_PrimitiveBounds[slot];
+                    if (IntersectSphere(box.Min(), box.Max(), sphere))
+                    {
+                        visit(m_PrimitiveIndices[slot]);
+                    }
+                }
+                continue;
+            }
+            stack[stackSize++] = node.Offset;
+            stack[stackSize++] = index + 1;
+        }
+    }
+
+    /// <summary>
+    /// Calls visit(uint32 primitive) for every primitive whose box Frustum::Intersects. Subtrees
+    /// entirely inside the frustum are reported without testing anything below them.
+    /// </summary>
+    template <typename Visit> void QueryFrustum(Frustum const &frustum, Visit &&visit) const
+    {
+        if (m_Nodes.empty())
+        {
+            return;
+        }
+        // The top bit marks nodes already known to be inside.
+        constexpr uint32 insideFlag = 1u << 31;
+        std::array<uint32, k_StackSize> stack;
+        usz stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            uint32 const entry = stack[--stackSize];
+            uint32 const index = entry & ~insideFlag;
+            BVHNode const &node = m_Nodes[index];
+            bool inside = (entry & insideFlag) != 0;
+            if (!inside)
+            {
+                Frustum::Containment const containment =
+                    frustum.Classify(AABB::FromMinMax(node.Min, node.Max));
+                if (containment == Frustum::Containment::Outside)
+                {
+                    continue;
+                }
+                inside = containment == Frustum::Containment::Inside;
+            }
+            if (node.IsLeaf())
+            {
+                for (usz slot = node.Offset; slot < node.Offset + node.Count; ++slot)
+                {
+                    if (inside || frustum.Intersects(m_PrimitiveBounds[slot]))
+                    {
+                        visit(m_PrimitiveIndices[slot]);
+                    }
+                }
+                continue;
+            }
+            uint32 const flag = inside ? insideFlag : 0;
+            stack[stackSize++] = node.Offset | flag;
+            stack[stackSize++] = (index + 1) | flag;
+        }
+    }
+
+    std::span<BVHNode const> GetNodes() const { return m_Nodes; }
+    // Primitive indices in leaf order: a leaf holds [Offset, Offset + Count).
+    std::span<uint32 const> GetPrimitiveIndices() const { return m_PrimitiveIndices; }
+
+private:
+    // Ray traversal shared by the Raycast overloads. hitTest gets the primitive's slot in leaf
+    // order and the distance where the ray enters its box.
+    template <typename HitTest>
+    std::optional<RayHit> Traverse(Ray const &ray, HitTest &&hitTest) const
+    {
+        if (m_Nodes.empty())
+        {
+            return std::nullopt;
+        }
+        Vector3 const inverseDirection(1.0f / ray.Direction.x, 1.0f / ray.Direction.y,
+                                       1.0f / ray.Direction.z);
+        bool const negative[3] = {ray.Direction.x < 0.0f, ray.Direction.y < 0.0f,
+                                  ray.Direction.z < 0.0f};
+
+        std::optional<RayHit> closest;
+        float maxDistance = ray.MaxDistance;
+        std::array<uint32, k_StackSize> stack;
+        usz stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            uint32 const index = stack[--stackSize];
+            BVHNode const &node = m_Nodes[index];
+            float entry;
+            if (!IntersectRay(node.Min, node.Max, ray.Origin, inverseDirection, maxDistance, entry))
+            {
+                continue;
+            }
+            if (node.IsLeaf())
+            {
+                for (usz slot = node.Offset; slot < node.Offset + node.Count; ++slot)
+                {
+                    AABB const &box = m_PrimitiveBounds[slot];
+                    if (!IntersectRay(box.Min(), box.Max(), ray.Origin, inverseDirection,
+                                      maxDistance, entry))
+                    {
+                        continue;
+                    }
+                    std::optional<float> const distance = hitTest(slot, entry, maxDistance);
+                    if (distance && *distance <= maxDistance)
+                    {
+                        maxDistance = *distance;
+                        closest = RayHit{m_PrimitiveIndices[slot], *distance};
+                    }
+                }
+                continue;
+            }
+            // Visit the child on the near side of the split first so closer hits prune the other.
+            bool const rightFirst = negative[node.Axis];
+            stack[stackSize++] = rightFirst ? index + 1 : node.Offset;
+            stack[stackSize++] = rightFirst ? node.Offset : index + 1;
+        }
+        return closest;
+    }
+
+    struct BuildContext
+    {
+        std::span<AABB const> Bounds;
+        std::span<Vector3 const> Centroids;
+        BVHBuildSettings Settings;
+    };
+
+    struct Split
+    {
+        usz Axis = 0;
+        usz Bin = 0;
+        float Cost = std::numeric_limits<float>::max();
+    };
+
+    // Builds the subtree over m_PrimitiveIndices[begin, end) into nodes and returns its root.
+    uint32 BuildNode(BuildContext const &context, std::vector<BVHNode> &nodes, usz begin, usz end,
+                     usz depth, usz parallelDepth)
+    {
+        uint32 const index = static_cast<uint32>(nodes.size());
+        nodes.emplace_back();
+
+        Bounds bounds, centroidBounds;
+        for (usz i = begin; i < end; ++i)
+        {
+            uint32 const primitive = m_PrimitiveIndices[i];
+            AABB const &box = context.Bounds[primitive];
+            bounds.Grow(box.Min(), box.Max());
+            centroidBounds.Grow(context.Centroids[primitive]);
+        }
+        nodes[index].Min = bounds.Min;
+        nodes[index].Max = bounds.Max;
+
+        usz const count = end - begin;
+        usz const maxLeafSize = context.Settings.MaxLeafSize;
+        usz mid = begin;
+        usz axis = 0;
+        if (depth < k_MedianSplitDepth && count > 1)
+        {
+            Split const split = FindSplit(context, begin, end, centroidBounds);
+            float const leafCost = static_cast<float>(count);
+            float const splitCost = k_TraversalCost + split.Cost / bounds.HalfArea();
+            if (count <= maxLeafSize && (split.Cost == std::numeric_limits<float>::max() ||
+                                         leafCost <= splitCost))
+            {
+                return MakeLeaf(nodes, index, begin, count);
+            }
+            if (split.Cost != std::numeric_limits<float>::max())
+            {
+                axis = split.Axis;
+                mid = PartitionByBin(context, begin, end, centroidBounds, split);
+            }
+        }
+        else if (count <= maxLeafSize)
+        {
+            return MakeLeaf(nodes, index, begin, count);
+        }
+        if (mid == begin || mid == end)
+        {
+            // No useful plane: every centroid in one place, or too deep to trust the SAH.
+            axis = LongestAxis(centroidBounds);
+            mid = begin + count / 2;
+            std::nth_element(m_PrimitiveIndices.begin() + begin, m_PrimitiveIndices.begin() + mid,
+                             m_PrimitiveIndices.begin() + end, [&](uint32 a, uint32 b) {
+                                 return Component(context.Centroids[a], axis) <
+                                        Component(context.Centroids[b], axis);
+                             });
+        }
+        nodes[index].Axis = static_cast<uint16>(axis);
+
+        if (depth < parallelDepth && count >= k_MinParallelPrimitives)
+        {
+            // The two halves touch disjoint ranges of m_PrimitiveIndices, so only the node arrays
+            // need separating. The right subtree is appended after the left to keep the order.
+            std::vector<BVHNode> rightNodes;
+            std::thread right([&] {
+                BuildNode(context, rightNodes, mid, end, depth + 1, parallelDepth);
+            });
+            BuildNode(context, nodes, begin, mid, depth + 1, parallelDepth);
+            right.join();
+
+            uint32 const base = static_cast<uint32>(nodes.size());
+            nodes[index].Offset = base;
+            for (BVHNode node : rightNodes)
+            {
+                if (!node.IsLeaf())
+                {
+                    node.Offset += base;
+                }
+                nodes.push_back(node);
+            }
+        }
+        else
+        {
+            BuildNode(context, nodes, begin, mid, depth + 1, parallelDepth);
+            nodes[index].Offset = static_cast<uint32>(nodes.size());
+            BuildNode(context, nodes, mid, end, depth + 1, parallelDepth);
+        }
+        return index;
+    }
+
+    static uint32 MakeLeaf(std::vector<BVHNode> &nodes, uint32 index, usz begin, usz count)
+    {
+        nodes[index].Offset = static_cast<uint32>(begin);
+        nodes[index].Count = static_cast<uint16>(count);
+        return index;
+    }
+
+    static usz LongestAxis(Bounds const &bounds)
+    {
+        Vector3 const size = bounds.Max - bounds.Min;
+        return size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+    }
+
+    static usz BinOf(BuildContext const &context, Vector3 const &centroid,
+                     Bounds const &centroidBounds, usz axis)
+    {
+        float const min = Component(centroidBounds.Min, axis);
+        float const extent = Component(centroidBounds.Max, axis) - min;
+        float const binCount = static_cast<float>(context.Settings.BinCount);
+        usz const bin = static_cast<usz>((Component(centroid, axis) - min) * (binCount / extent));
+        return Min(bin, context.Settings.BinCount - 1);
+    }
+
+    // The cheapest split into bins [0, Bin] and (Bin, BinCount) on any axis, or a Split with the
+    // maximum cost when there's no axis to split.
+    Split FindSplit(BuildContext const &context, usz begin, usz end,
+                    Bounds const &centroidBounds) const
+    {
+        usz const binCount = context.Settings.BinCount;
+        Split best;
+        for (usz axis = 0; axis < 3; ++axis)
+        {
+            if (Component(centroidBounds.Max, axis) <= Component(centroidBounds.Min, axis))
+            {
+                continue;
+            }
+
+            std::array<Bounds, k_MaxBins> bins;
+            std::array<usz, k_MaxBins> counts{};
+            for (usz i = begin; i < end; ++i)
+            {
+                uint32 const primitive = m_PrimitiveIndices[i];
+                AABB const &box = context.Bounds[primitive];
+                usz const bin = BinOf(context, context.Centroids[primitive], centroidBounds, axis);
+                bins[bin].Grow(box.Min(), box.Max());
+                ++counts[bin];
+            }
+
+            // Sweep from the right to get the cost of everything after each plane...
+            std::array<float, k_MaxBins> rightCosts;
+            Bounds right;
+            usz rightCount = 0;
+            for (usz bin = binCount - 1; bin > 0; --bin)
+            {
+                if (counts[bin] > 0)
+                {
+                    right.Grow(bins[bin].Min, bins[bin].Max);
+                    rightCount += counts[bin];
+                }
+                rightCosts[bin - 1] =
+                    rightCount > 0 ? right.HalfArea() * static_cast<float>(rightCount) : 0.0f;
+            }
+            // ...then from the left, adding the two.
+            Bounds left;
+            usz leftCount = 0;
+            for (usz bin = 0; bin + 1 < binCount; ++bin)
+            {
+                if (counts[bin] > 0)
+                {
+                    left.Grow(bins[bin].Min, bins[bin].Max);
+                    leftCount += counts[bin];
+                }
+                usz const total = end - begin;
+                if (leftCount == 0 || leftCount == total)
+                {
+                    continue;
+                }
+                float const cost =
+                    left.HalfArea() * static_cast<float>(leftCount) + rightCosts[bin];
+                if (cost < best.Cost)
+                {
+                    best = Split{axis, bin, cost};
+                }
+            }
+        }
+        return best;
+    }
+
+    usz PartitionByBin(BuildContext const &context, usz begin, usz end,
+                       Bounds const &centroidBounds, Split const &split)
+    {
+        auto const mid = std::partition(
+            m_PrimitiveIndices.begin() + begin, m_PrimitiveIndices.begin() + end,
+            [&](uint32 primitive) {
+                return BinOf(context, context.Centroids[primitive], centroidBounds, split.Axis) <=
+                       split.Bin;
+            });
+        return static_cast<usz>(mid - m_PrimitiveIndices.begin());
+    }
+
+    // Fills in the links refits need: each node's parent and each primitive's leaf.
+    void LinkNodes()
+    {
+        m_Parents.assign(m_Nodes.size(), k_NoParent);
+        m_PrimitiveLeaves.resize(m_PrimitiveIndices.size());
+        for (usz i = 0; i < m_Nodes.size(); ++i)
+        {
+            BVHNode const &node = m_Nodes[i];
+            if (node.IsLeaf())
+            {
+                for (usz slot = node.Offset; slot < node.Offset + node.Count; ++slot)
+                {
+                    m_PrimitiveLeaves[m_PrimitiveIndices[slot]] = static_cast<uint32>(i);
+                }
+            }
+            else
+            {
+                m_Parents[i + 1] = static_cast<uint32>(i);
+                m_Parents[node.Offset] = static_cast<uint32>(i);
+            }
+        }
+    }
+
+    // Recomputes one node from its children or primitives. Returns whether its bounds changed.
+    bool RefitNode(uint32 index)
+    {
+        BVHNode &node = m_Nodes[index];
+        Bounds bounds;
+        if (node.IsLeaf())
+        {
+            for (usz slot = node.Offset; slot < node.Offset + node.Count; ++slot)
+            {
+                AABB const &box = m_PrimitiveBounds[slot];
+                bounds.Grow(box.Min(), box.Max());
+            }
+        }
+        else
+        {
+            BVHNode const &left = m_Nodes[index + 1];
+            BVHNode const &right = m_Nodes[node.Offset];
+            bounds.Grow(left.Min, left.Max);
+            bounds.Grow(right.Min, right.Max);
+        }
+        bool const changed =
+            !bounds.Min.ExactlyEquals(node.Min) || !bounds.Max.ExactlyEquals(node.Max);
+        node.Min = bounds.Min;
+        node.Max = bounds.Max;
+        return changed;
+    }
+
+    usz FindSlot(uint32 primitive) const
+    {
+        BVHNode const &leaf = m_Nodes[m_PrimitiveLeaves[primitive]];
+        usz slot = leaf.Offset;
+        while (m_PrimitiveIndices[slot] != primitive)
+        {
+            ++slot;
+        }
+        return slot;
+    }
+
+    std::vector<BVHNode> m_Nodes;
+    std::vector<uint32> m_PrimitiveIndices;
+    // Copies of the primitive boxes in leaf order, so leaves read them contiguously.
+    std::vector<AABB> m_PrimitiveBounds;
+    std::vector<uint32> m_Parents;
+    std::vector<uint32> m_PrimitiveLeaves;
+};
+} // namespace Lateralus::Core
@@ -76,6 +76,11 @@ export string Bytes_to_String(uint64 byteCount)
         uint64 const Bytes;
     } k_Suffixes[] = {{"TiB", 1_TiB}, {"GiB", 1_GiB}, {"MiB", 1_MiB}, {"KiB", 1_KiB}, {"B", 1ull}};
 
+    if (byteCount == 0)
+    {
+        return "0 B";
+    }
+
     for (auto const &suffixSize : k_Suffixes)
     {
         if (byteCount >= suffixSize.Bytes)
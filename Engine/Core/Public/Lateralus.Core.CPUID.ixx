@@ -30,11 +30,11 @@ export struct CPUID
         int32 &ebx = regs[1];
         int32 &ecx = regs[2];
         int32 &edx = regs[3];
-        auto cpuid = [&regs](int num) { __cpuid(regs, num); };
+        auto cpuid = [&regs](int num, int sub = 0) { __cpuidex(regs, num, sub); };
 #elif defined(__GNUC__) || defined(__clang__)
-        uint32 eax, ebx, ecx, edx;
-        auto cpuid = [&eax, &ebx, &ecx, &edx](int num) {
-            __get_cpuid(num, &eax, &ebx, &ecx, &edx);
+        uint32 eax = 0, ebx = 0, ecx = 0, edx = 0;
+        auto cpuid = [&eax, &ebx, &ecx, &edx](unsigned int num, unsigned int sub = 0) {
+            __get_cpuid_count(num, sub, &eax, &ebx, &ecx, &edx);
         };
 #else
 #error "Unsupported compiler"
@@ -55,14 +55,27 @@ export struct CPUID
             fn01.edx = bitset<32>(edx);
         }
 
+        // Leaf 7 has sub-leaves, the features we care about are in sub-leaf 0.
         if (fn00.HighestFunction >= 0x07)
         {
-            cpuid(0x07);
+            cpuid(0x07, 0);
             fn07.ebx = bitset<32>(ebx);
             fn07.ecx = bitset<32>(ecx);
             fn07.edx = bitset<32>(edx);
         }
 
+        // The OS has to save the wider registers on a context switch before AVX can be used.
+        if (fn01.ecx[27])
+        {
+#if defined(_MSC_VER)
+            xcr0 = _xgetbv(0);
+#else
+            uint32 xcr0Low, xcr0High;
+            __asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+            xcr0 = (static_cast<uint64>(xcr0High) << 32) | xcr0Low;
+#endif
+        }
+
         cpuid(0x80000000);
         // Higest extended function
         fn80000000.eax = eax;
@@ -89,6 +102,30 @@ export struct CPUID
     }
 
     bool HasPopcnt() const { return fn01.ecx[23]; }
+    bool HasSSE4_1() const { return fn01.ecx[19]; }
+    bool HasFMA() const { return fn01.ecx[12]; }
+    bool HasAVX2() const { return fn07.ebx[5]; }
+    bool HasBMI1() const { return fn07.ebx[3]; }
+
+    /// <summary>
+    /// The AVX-512 subsets every AVX-512 CPU since Skylake-SP supports: foundation, doubleword and
+    /// quadword, byte and word, and vector length extensions.
+    /// </summary>
+    bool HasAVX512Common() const
+    {
+        return fn07.ebx[16] && fn07.ebx[17] && fn07.ebx[30] && fn07.ebx[31];
+    }
+
+    /// <summary>
+    /// True when the OS saves the 256 bit (YMM) register state, see XCR0 bits 1 and 2.
+    /// The CPU feature bits alone don't mean AVX instructions can be used.
+    /// </summary>
+    bool OSSavesAVXState() const { return (xcr0 & 0x6) == 0x6; }
+
+    /// <summary>
+    /// True when the OS saves the 512 bit (ZMM) and mask register state, see XCR0 bits 5 to 7.
+    /// </summary>
+    bool OSSavesAVX512State() const { return OSSavesAVXState() && (xcr0 & 0xE0) == 0xE0; }
 
     SSEVersion GetSSEVersion() const
     {
@@ -194,6 +231,15 @@ export struct CPUID
         bitset<32> ebx, ecx, edx;
     } fn07;
 
+    //////////////////////////////////////////////////////////////////////////
+    // XCR0 - Extended control register (XGETBV)
+    // https://en.wikipedia.org/wiki/Control_register#XCR0_and_XSS
+
+    /// <summary>
+    /// Which register states the OS saves. Zero when the OS hasn't enabled XSAVE.
+    /// </summary>
+    uint64 xcr0 = 0;
+
     //////////////////////////////////////////////////////////////////////////
     // Function 80000000 - Highest extended function implemented
     // https://en.wikipedia.org/wiki/CPUID#EAX=80000000h:_Get_Highest_Extended_Function_Implemented
@@ -208,7 +254,7 @@ export struct CPUID
         /// </summary>
         union {
             uint32 HighestExtendedFunction = 0;
-            bitset<32> eax;
+            uint32 eax;
         };
 
         // unused
@@ -0,0 +1,219 @@
+module;
+
+#include <Core.Assert.h>
+#include <string.h>
+
+export module Lateralus.Core.Delegate;
+
+import <cstddef>;
+import <new>;
+import <type_traits>;
+import <utility>;
+
+import Lateralus.Core;
+import Lateralus.Core.Memory;
+
+namespace Lateralus::Core
+{
+export template <typename Signature> class Delegate;
+
+/// <summary>
+/// A callable with a fixed signature, like std::function, that doesn't allocate for the callables
+/// delegates usually hold: function pointers, bound member functions and lambdas capturing a few
+/// pointers or values.
+///
+/// Callables that are trivially copyable and fit in k_InlineSize bytes are stored inline. Anything
+/// else is allocated from the pool (see PoolAllocate) and the delegate stores the pointer. Either
+/// way the delegate's own bytes can be moved with memcpy, so moving one never calls into the
+/// callable and arrays of delegates grow as cheaply as arrays of pointers.
+///
+/// Example:
+///     Delegate<void(int)> onKey = [this](int key) { ... };
+///     Delegate<void(int)> onKey = Delegate<void(int)>::Bind<&Input::OnKey>(&input);
+/// </summary>
+export template <typename Result, typename... Args> class Delegate<Result(Args...)>
+{
+public:
+    static constexpr usz k_InlineSize = 4 * sizeof(void *);
+
+    Delegate() = default;
+    Delegate(std::nullptr_t) {}
+
+    template <typename Callable>
+        requires(!std::is_same_v<std::remove_cvref_t<Callable>, Delegate> &&
+                 !std::is_member_pointer_v<std::remove_cvref_t<Callable>> &&
+                 std::is_invocable_r_v<Result, std::remove_cvref_t<Callable> &, Args...>)
+    Delegate(Callable &&callable)
+    {
+        using Stored = std::remove_cvref_t<Callable>;
+        if constexpr (std::is_pointer_v<Stored>)
+        {
+            if (callable == nullptr)
+            {
+                return;
+            }
+        }
+        if constexpr (k_IsInline<Stored>)
+        {
+            new (m_Storage) Stored(std::forward<Callable>(callable));
+            m_Invoke = &InvokeInline<Stored>;
+        }
+        else
+        {
+            new (m_Storage) Stored *(PoolNew<Stored>(std::forward<Callable>(callable)));
+            m_Invoke = &InvokeAllocated<Stored>;
+            m_Manage = &ManageAllocated<Stored>;
+        }
+    }
+
+    // A delegate calling (object->*Method)(args...). Only the object pointer is stored, and object
+    // has to outlive the delegate.
+    template <auto Method, typename Object> static Delegate Bind(Object *object)
+    {
+        LAT_ASSERT(object != nullptr);
+        Delegate result;
+        new (result.m_Storage) Object *(object);
+        result.m_Invoke = &InvokeMethod<Method, Object>;
+        return result;
+    }
+
+    Delegate(Delegate const &other) : m_Invoke(other.m_Invoke), m_Manage(other.m_Manage)
+    {
+        if (m_Manage != nullptr)
+        {
+            m_Manage(Operation::Clone, m_Storage, other.m_Storage);
+        }
+        else
+        {
+            memcpy(m_Storage, other.m_Storage, k_InlineSize);
+        }
+    }
+
+    Delegate(Delegate &&other) noexcept { Relocate(other); }
+
+    Delegate &operator=(Delegate const &other)
+    {
+        if (this != &other)
+        {
+            Delegate copy(other);
+            Reset();
+            Relocate(copy);
+        }
+        return *this;
+    }
+
+    Delegate &operator=(Delegate &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            Relocate(other);
+        }
+        return *this;
+    }
+
+    ~Delegate() { Reset(); }
+
+    void Reset()
+    {
+        if (m_Manage != nullptr)
+        {
+            m_Manage(Operation::Destroy, m_Storage, nullptr);
+        }
+        m_Invoke = nullptr;
+        m_Manage = nullptr;
+    }
+
+    explicit operator bool() const { return m_Invoke != nullptr; }
+
+    // True when the callable is stored inside the delegate rather than allocated.
+    bool IsInline() const { return m_Manage == nullptr; }
+
+    // Like std::function, the callable is called as non-const even through a const delegate.
+    Result operator()(Args... args) const
+    {
+        LAT_ASSERT(m_Invoke != nullptr);
+        return m_Invoke(const_cast<std::byte *>(m_Storage), std::forward<Args>(args)...);
+    }
+
+private:
+    enum class Operation
+    {
+        Clone,
+        Destroy
+    };
+
+    using Invoker = Result (*)(void *storage, Args &&...args);
+    using Manager = void (*)(Operation operation, void *storage, void const *source);
+
+    template <typename Stored>
+    static constexpr bool k_IsInline =
+        sizeof(Stored) <= k_InlineSize && alignof(Stored) <= alignof(void *) &&
+        std::is_trivially_copyable_v<Stored> && std::is_trivially_destructible_v<Stored>;
+
+    // Takes over other's bytes and leaves it empty without destroying anything.
+    void Relocate(Delegate &other)
+    {
+        memcpy(m_Storage, other.m_Storage, k_InlineSize);
+        m_Invoke = other.m_Invoke;
+        m_Manage = other.m_Manage;
+        other.m_Invoke = nullptr;
+        other.m_Manage = nullptr;
+    }
+
+    template <typename Callable> static Result Call(Callable &callable, Args &&...args)
+    {
+        if constexpr (std::is_void_v<Result>)
+        {
+            callable(std::forward<Args>(args)...);
+        }
+        else
+        {
+            return callable(std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename Stored> static Result InvokeInline(void *storage, Args &&...args)
+    {
+        return Call(*static_cast<Stored *>(storage), std::forward<Args>(args)...);
+    }
+
+    template <typename Stored> static Result InvokeAllocated(void *storage, Args &&...args)
+    {
+        return Call(**static_cast<Stored **>(storage), std::forward<Args>(args)...);
+    }
+
+    template <typename Stored>
+    static void ManageAllocated(Operation operation, void *storage, void const *source)
+    {
+        if (operation == Operation::Clone)
+        {
+            Stored const *from = *static_cast<Stored *const *>(source);
+            new (storage) Stored *(PoolNew<Stored>(*from));
+        }
+        else
+        {
+            PoolDelete(*static_cast<Stored **>(storage));
+        }
+    }
+
+    template <auto Method, typename Object>
+    static Result InvokeMethod(void *storage, Args &&...args)
+    {
+        Object *object = *static_cast<Object **>(storage);
+        if constexpr (std::is_void_v<Result>)
+        {
+            (object->*Method)(std::forward<Args>(args)...);
+        }
+        else
+        {
+            return (object->*Method)(std::forward<Args>(args)...);
+        }
+    }
+
+    alignas(void *) std::byte m_Storage[k_InlineSize] = {};
+    Invoker m_Invoke = nullptr;
+    // Only set for allocated callables; inline ones are copied and destroyed as plain bytes.
+    Manager m_Manage = nullptr;
+};
+} // namespace Lateralus::Core
@@ -0,0 +1,176 @@
+module;
+
+#include <Core.Assert.h>
+
+export module Lateralus.Core.Dispatch;
+
+import <array>;
+import <initializer_list>;
+import <utility>;
+
+import Lateralus.Core;
+import Lateralus.Core.CPUID;
+import Lateralus.Core.SIMDSupport;
+
+namespace Lateralus::Core
+{
+namespace
+{
+// The instruction set the CPU we're running on can use, capped to the tiers we write kernels for.
+SSEVersion DetectDispatchVersion()
+{
+#if PLATFORM_IS_AMD64 || PLATFORM_IS_X86
+    CPUID const cpuid;
+    if (cpuid.OSSavesAVX512State() && cpuid.HasAVX512Common() && cpuid.HasAVX2() &&
+        cpuid.HasFMA() && cpuid.HasBMI1())
+    {
+        return SSEVersion::AVX512;
+    }
+    if (cpuid.OSSavesAVXState() && cpuid.HasAVX2() && cpuid.HasFMA() && cpuid.HasBMI1())
+    {
+        return SSEVersion::AVX2;
+    }
+    if (cpuid.HasSSE4_1())
+    {
+        return SSEVersion::SSE4_1;
+    }
+#endif
+    return SSEVersion::None;
+}
+
+SSEVersion &DispatchCeiling()
+{
+    static SSEVersion ceiling = DetectDispatchVersion();
+    return ceiling;
+}
+} // namespace
+
+/// <summary>
+/// The best instruction set dispatched kernels may use on this machine.
+/// SSEVersion::None means only the variant compiled for the build's own target is used.
+/// </summary>
+export SSEVersion GetDispatchVersion() { return DispatchCeiling(); }
+
+/// <summary>
+/// Shared part of DispatchedFunction: every instance links itself into one list so they can all be
+/// rebound when the ceiling changes.
+/// </summary>
+export class DispatchedFunctionBase
+{
+public:
+    DispatchedFunctionBase(DispatchedFunctionBase const &) = delete;
+    DispatchedFunctionBase &operator=(DispatchedFunctionBase const &) = delete;
+
+    SSEVersion GetBoundVersion() const { return m_BoundVersion; }
+
+    /// <summary>
+    /// Limits every dispatched function to variants at or below version, and never above what the
+    /// CPU supports. Used by tests to reach the lower variants and to rule out a variant while
+    /// debugging. Not thread safe: call it while no dispatched function is running.
+    /// </summary>
+    static void SetCeiling(SSEVersion version)
+    {
+        SSEVersion const detected = DetectDispatchVersion();
+        DispatchCeiling() = version < detected ? version : detected;
+        for (DispatchedFunctionBase *it = Head(); it != nullptr; it = it->m_Next)
+        {
+            it->Bind();
+        }
+    }
+
+protected:
+    DispatchedFunctionBase() : m_Next(Head()) { Head() = this; }
+    ~DispatchedFunctionBase()
+    {
+        for (DispatchedFunctionBase **it = &Head(); *it != nullptr; it = &(*it)->m_Next)
+        {
+            if (*it == this)
+            {
+                *it = m_Next;
+                break;
+            }
+        }
+    }
+
+    virtual void Bind() = 0;
+
+    SSEVersion m_BoundVersion = SSEVersion::None;
+
+private:
+    static DispatchedFunctionBase *&Head()
+    {
+        static DispatchedFunctionBase *head = nullptr;
+        return head;
+    }
+
+    DispatchedFunctionBase *m_Next;
+};
+
+export template <typename Signature> class DispatchedFunction;
+
+/// <summary>
+/// A function with one implementation per instruction set, bound once to the best variant the CPU
+/// supports. Calls go through a plain function pointer.
+///
+/// Variants are tagged with the SSEVersion they need. One variant must be tagged SSEVersion::None;
+/// it's compiled for the build's target and is always safe to call. The others are written with
+/// LATERALUS_TARGET_* attributes (see Core.SIMD.h) and may only be reached through here.
+///
+/// Example:
+///     DispatchedFunction<usz(byte const*, usz)> CountZeros{
+///         {SSEVersion::None, &CountZerosScalar},
+///         {SSEVersion::AVX2, &CountZerosAVX2}};
+///     CountZeros(data, size);
+///
+/// Instances are meant to live at namespace scope so they're bound during static initialization.
+/// </summary>
+export template <typename Result, typename... Args>
+class DispatchedFunction<Result(Args...)> final : public DispatchedFunctionBase
+{
+public:
+    using FunctionPtr = Result (*)(Args...);
+
+    struct Variant
+    {
+        SSEVersion Version;
+        FunctionPtr Function;
+    };
+
+    static constexpr usz k_MaxVariants = 4;
+
+    DispatchedFunction(std::initializer_list<Variant> variants)
+    {
+        LAT_ASSERT(variants.size() <= k_MaxVariants);
+        for (Variant const &variant : variants)
+        {
+            m_Variants[m_VariantCount++] = variant;
+        }
+        Bind();
+        LAT_ASSERT(m_Bound != nullptr); // a SSEVersion::None variant is required
+    }
+
+    Result operator()(Args... args) const { return m_Bound(std::forward<Args>(args)...); }
+
+private:
+    void Bind() override
+    {
+        SSEVersion const ceiling = GetDispatchVersion();
+        m_Bound = nullptr;
+        m_BoundVersion = SSEVersion::None;
+        for (usz i = 0; i < m_VariantCount; ++i)
+        {
+            Variant const &variant = m_Variants[i];
+            bool const isBetter = m_Bound == nullptr || variant.Version > m_BoundVersion;
+            if (variant.Version <= ceiling && isBetter)
+            {
+                m_Bound = variant.Function;
+                m_BoundVersion = variant.Version;
+            }
+        }
+    }
+
+    std::array<Variant, k_MaxVariants> m_Variants{};
+    usz m_VariantCount = 0;
+    FunctionPtr m_Bound = nullptr;
+};
+} // namespace Lateralus::Core
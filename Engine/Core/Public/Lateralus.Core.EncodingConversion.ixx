@@ -1,8 +1,12 @@
+module;
+#include <Core.SIMD.h>
 export module Lateralus.Core.EncodingConversion;
 import <bit>;
 import <concepts>;
 import <string>;
 import Lateralus.Core;
+import Lateralus.Core.Dispatch;
+import Lateralus.Core.SIMDSupport;
 
 using namespace std;
 
@@ -131,6 +135,176 @@ usz CountReEncodedSize<Encoding::ASCII, Encoding::UTF32>(byte const *sourceBytes
     return sourceSize * 4;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// ASCII runs
+// Most text we transcode is largely ASCII, so UTF8 decoding hands runs of ASCII to these kernels
+// which handle a register of characters at a time.
+namespace
+{
+// Number of ASCII characters at the start of source.
+using CountASCIIPrefixFn = usz(char8_t const *source, usz size);
+// Widens the ASCII characters at the start of source to UTF16. Returns how many were converted.
+using WidenASCIIPrefixFn = usz(char8_t const *source, usz size, char16_t *dest);
+
+usz CountASCIIPrefixScalar(char8_t const *source, usz size)
+{
+    usz i = 0;
+    while (i < size && source[i] < 0x80)
+    {
+        ++i;
+    }
+    return i;
+}
+
+usz WidenASCIIPrefixScalar(char8_t const *source, usz size, char16_t *dest)
+{
+    usz i = 0;
+    for (; i < size && source[i] < 0x80; ++i)
+    {
+        dest[i] = source[i];
+    }
+    return i;
+}
+
+#if LATERALUS_SIMD_SSE
+usz CountASCIIPrefixSSE2(char8_t const *source, usz size)
+{
+    usz i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(source + i));
+        uint32 const nonASCII = static_cast<uint32>(_mm_movemask_epi8(block));
+        if (nonASCII != 0)
+        {
+            return i + countr_zero(nonASCII);
+        }
+    }
+    return i + CountASCIIPrefixScalar(source + i, size - i);
+}
+
+usz WidenASCIIPrefixSSE2(char8_t const *source, usz size, char16_t *dest)
+{
+    usz i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(source + i));
+        if (_mm_movemask_epi8(block) != 0)
+        {
+            break;
+        }
+        __m128i const zero = _mm_setzero_si128();
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_unpacklo_epi8(block, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i + 8), _mm_unpackhi_epi8(block, zero));
+    }
+    return i + WidenASCIIPrefixScalar(source + i, size - i, dest + i);
+}
+
+LATERALUS_TARGET_SSE4_1 usz WidenASCIIPrefixSSE41(char8_t const *source, usz size,
+                                                   char16_t *dest)
+{
+    __m128i const highBits = _mm_set1_epi8(static_cast<char>(0x80));
+    usz i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(source + i));
+        if (!_mm_testz_si128(block, highBits))
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_cvtepu8_epi16(block));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i + 8),
+                         _mm_cvtepu8_epi16(_mm_unpackhi_epi64(block, block)));
+    }
+    return i + WidenASCIIPrefixScalar(source + i, size - i, dest + i);
+}
+
+LATERALUS_TARGET_AVX2 usz CountASCIIPrefixAVX2(char8_t const *source, usz size)
+{
+    usz i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i));
+        uint32 const nonASCII = static_cast<uint32>(_mm256_movemask_epi8(block));
+        if (nonASCII != 0)
+        {
+            return i + _tzcnt_u32(nonASCII);
+        }
+    }
+    return i + CountASCIIPrefixSSE2(source + i, size - i);
+}
+
+LATERALUS_TARGET_AVX2 usz WidenASCIIPrefixAVX2(char8_t const *source, usz size, char16_t *dest)
+{
+    usz i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i));
+        if (_mm256_movemask_epi8(block) != 0)
+        {
+            break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i),
+                            _mm256_cvtepu8_epi16(_mm256_castsi256_si128(block)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i + 16),
+                            _mm256_cvtepu8_epi16(_mm256_extracti128_si256(block, 1)));
+    }
+    return i + WidenASCIIPrefixSSE41(source + i, size - i, dest + i);
+}
+
+LATERALUS_TARGET_AVX512 usz CountASCIIPrefixAVX512(char8_t const *source, usz size)
+{
+    usz i = 0;
+    for (; i + 64 <= size; i += 64)
+    {
+        __m512i const block = _mm512_loadu_si512(source + i);
+        uint64 const nonASCII = _mm512_movepi8_mask(block);
+        if (nonASCII != 0)
+        {
+            return i + _tzcnt_u64(nonASCII);
+        }
+    }
+    return i + CountASCIIPrefixAVX2(source + i, size - i);
+}
+
+LATERALUS_TARGET_AVX512 usz WidenASCIIPrefixAVX512(char8_t const *source, usz size,
+                                                   char16_t *dest)
+{
+    usz i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i));
+        if (_mm256_movemask_epi8(block) != 0)
+        {
+            break;
+        }
+        _mm512_storeu_si512(dest + i, _mm512_cvtepu8_epi16(block));
+    }
+    return i + WidenASCIIPrefixSSE41(source + i, size - i, dest + i);
+}
+#endif
+
+DispatchedFunction<CountASCIIPrefixFn> g_CountASCIIPrefix{
+#if LATERALUS_SIMD_SSE
+    {SSEVersion::None, &CountASCIIPrefixSSE2},
+    {SSEVersion::AVX2, &CountASCIIPrefixAVX2},
+    {SSEVersion::AVX512, &CountASCIIPrefixAVX512},
+#else
+    {SSEVersion::None, &CountASCIIPrefixScalar},
+#endif
+};
+
+DispatchedFunction<WidenASCIIPrefixFn> g_WidenASCIIPrefix{
+#if LATERALUS_SIMD_SSE
+    {SSEVersion::None, &WidenASCIIPrefixSSE2},
+    {SSEVersion::SSE4_1, &WidenASCIIPrefixSSE41},
+    {SSEVersion::AVX2, &WidenASCIIPrefixAVX2},
+    {SSEVersion::AVX512, &WidenASCIIPrefixAVX512},
+#else
+    {SSEVersion::None, &WidenASCIIPrefixScalar},
+#endif
+};
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // UTF8 Conversions
 export template <>
@@ -213,9 +387,10 @@ void ReEncode<Encoding::UTF8, Encoding::UTF16>(byte const *sourceBytes, byte *de
         char8_t c = sourceAs8[i];
         if ((c & 0b10000000) == 0)
         {
-            // ASCII character
-            *destAs16++ = c;
-            ++i;
+            // ASCII character, and likely more following it
+            usz const run = g_WidenASCIIPrefix(sourceAs8 + i, sourceSize - i, destAs16);
+            destAs16 += run;
+            i += run;
         }
         else if ((c & 0b11100000) == 0b11000000)
         {
@@ -256,8 +431,10 @@ usz CountReEncodedSize<Encoding::UTF8, Encoding::UTF16>(byte const *sourceBytes,
         auto const &c = sourceAs8[i];
         if (c < 0x80)
         {
-            // ASCII character, 1 byte in UTF-8, 2 bytes in UTF-16
-            encodedSize += 2;
+            // ASCII characters, 1 byte in UTF-8, 2 bytes in UTF-16
+            usz const run = g_CountASCIIPrefix(sourceAs8 + i, sourceSize - i);
+            encodedSize += run * 2;
+            i += run - 1;
         }
         else if (c < 0xE0)
         {
@@ -0,0 +1,364 @@
+module;
+
+#include <Core.Assert.h>
+
+export module Lateralus.Core.Frustum;
+
+import <bit>;
+import <span>;
+
+import Lateralus.Core;
+import Lateralus.Core.Math;
+import Lateralus.Core.Matrix;
+import Lateralus.Core.SIMD;
+import Lateralus.Core.Vector;
+
+namespace Lateralus::Core
+{
+// Points p with Normal.Dot(p) + Distance >= 0 are on the inside.
+export struct Plane
+{
+    Vector3 Normal;
+    float Distance = 0.0f;
+
+    constexpr float SignedDistance(Vector3 const &point) const
+    {
+        return Normal.Dot(point) + Distance;
+    }
+};
+
+export struct BoundingSphere
+{
+    Vector3 Center;
+    float Radius = 0.0f;
+};
+
+// Axis aligned box stored as its center and half size along each axis.
+export struct AABB
+{
+    Vector3 Center;
+    Vector3 Extents;
+
+    static constexpr AABB FromMinMax(Vector3 const &min, Vector3 const &max)
+    {
+        Vector3 const half(0.5f, 0.5f, 0.5f);
+        return AABB{(min + max) * half, (max - min) * half};
+    }
+
+    constexpr Vector3 Min() const { return Center - Extents; }
+    constexpr Vector3 Max() const { return Center + Extents; }
+};
+
+// Structure-of-arrays bounds for batch culling. All spans must be the same length.
+export struct ConstSphereStreams
+{
+    ConstVector3Streams Center;
+    std::span<float const> Radius;
+};
+
+export struct ConstAABBStreams
+{
+    ConstVector3Streams Center;
+    ConstVector3Streams Extents;
+};
+
+// Each plane's coefficients (and for boxes their absolute values) splatted once per batch.
+struct SplatPlanes
+{
+    SIMD::Float8 nx[6], ny[6], nz[6], d[6];
+    SIMD::Float8 absNx[6], absNy[6], absNz[6];
+};
+
+constexpr usz k_CullBatch = 8;
+
+/// <summary>
+/// The six planes bounding the volume a view-projection matrix maps into clip space, with normals
+/// pointing inwards. Uses the OpenGL clip volume (-w <= x, y, z <= w) that
+/// Matrix4x4::CreatePerspectiveProjection and CreateOrthographicProjection produce.
+///
+/// The batch functions test eight bounds per iteration against every plane. A bound is visible
+/// unless it is entirely behind one plane, so bounds near a corner can be kept although they are
+/// outside: the usual conservative result.
+/// </summary>
+export struct Frustum
+{
+    enum PlaneIndex
+    {
+        Left,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        PlaneCount
+    };
+
+    enum class Containment
+    {
+        Outside,
+        Intersecting,
+        Inside
+    };
+
+    Plane Planes[PlaneCount];
+
+    // Planes in the space viewProjection transforms from: world space for projection * view.
+    static constexpr Frustum FromViewProjection(Matrix4x4 const &viewProjection)
+    {
+        // Gribb and Hartmann: each plane is the bottom row plus or minus another row.
+        Vector4 const &x = viewProjection.r0;
+        Vector4 const &y = viewProjection.r1;
+        Vector4 const &z = viewProjection.r2;
+        Vector4 const &w = viewProjection.r3;
+
+        Frustum result;
+        result.Planes[Left] = MakePlane(w + x);
+        result.Planes[Right] = MakePlane(w - x);
+        result.Planes[Bottom] = MakePlane(w + y);
+        result.Planes[Top] = MakePlane(w - y);
+        result.Planes[Near] = MakePlane(w + z);
+        result.Planes[Far] = MakePlane(w - z);
+        return result;
+    }
+
+    constexpr bool Intersects(BoundingSphere const &sphere) const
+    {
+        for (Plane const &plane : Planes)
+        {
+            if (plane.SignedDistance(sphere.Center) < -sphere.Radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool Intersects(AABB const &box) const
+    {
+        return Classify(box) != Containment::Outside;
+    }
+
+    // Inside when the whole box is in front of every plane, which lets hierarchical queries accept
+    // everything below a node without testing further.
+    constexpr Containment Classify(AABB const &box) const
+    {
+        Containment result = Containment::Inside;
+        for (Plane const &plane : Planes)
+        {
+            // The box's extent along the plane normal.
+            float const radius = Abs(plane.Normal.x) * box.Extents.x +
+                                 Abs(plane.Normal.y) * box.Extents.y +
+                                 Abs(plane.Normal.z) * box.Extents.z;
+            float const distance = plane.SignedDistance(box.Center);
+            if (distance < -radius)
+            {
+                return Containment::Outside;
+            }
+            if (distance < radius)
+            {
+                result = Containment::Intersecting;
+            }
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// Writes the index of every visible sphere, in increasing order, and returns how many were
+    /// written. visibleIndices needs room for every sphere.
+    /// </summary>
+    usz CullSpheres(ConstSphereStreams spheres, std::span<uint32> visibleIndices) const
+    {
+        LAT_ASSERT(visibleIndices.size() >= spheres.Radius.size());
+        usz count = 0;
+        ForEachBatch(spheres, [&](usz first, uint32 visible) {
+            count = AppendIndices(first, visible, visibleIndices, count);
+        });
+        return count;
+    }
+
+    /// <summary>
+    /// Sets bit (n % 64) of visibleMask[n / 64] for every visible sphere n and clears the others.
+    /// visibleMask needs (count + 63) / 64 words.
+    /// </summary>
+    void CullSpheres(ConstSphereStreams spheres, std::span<uint64> visibleMask) const
+    {
+        LAT_ASSERT(visibleMask.size() >= (spheres.Radius.size() + 63) / 64);
+        ClearMask(spheres.Radius.size(), visibleMask);
+        ForEachBatch(spheres, [&](usz first, uint32 visible) {
+            AppendMask(first, visible, visibleMask);
+        });
+    }
+
+    // As CullSpheres, for boxes.
+    usz CullAABBs(ConstAABBStreams boxes, std::span<uint32> visibleIndices) const
+    {
+        LAT_ASSERT(visibleIndices.size() >= boxes.Center.x.size());
+        usz count = 0;
+        ForEachBatch(boxes, [&](usz first, uint32 visible) {
+            count = AppendIndices(first, visible, visibleIndices, count);
+        });
+        return count;
+    }
+
+    void CullAABBs(ConstAABBStreams boxes, std::span<uint64> visibleMask) const
+    {
+        LAT_ASSERT(visibleMask.size() >= (boxes.Center.x.size() + 63) / 64);
+        ClearMask(boxes.Center.x.size(), visibleMask);
+        ForEachBatch(boxes, [&](usz first, uint32 visible) {
+            AppendMask(first, visible, visibleMask);
+        });
+    }
+
+private:
+    static constexpr Plane MakePlane(Vector4 const &coefficients)
+    {
+        Vector3 const normal(coefficients.x, coefficients.y, coefficients.z);
+        float const length = normal.Length();
+        float const scale = length != 0.0f ? 1.0f / length : 0.0f;
+        return Plane{normal * Vector3(scale, scale, scale), coefficients.w * scale};
+    }
+
+    SplatPlanes Splat() const
+    {
+        SplatPlanes result;
+        for (usz p = 0; p < PlaneCount; ++p)
+        {
+            Plane const &plane = Planes[p];
+            result.nx[p] = SIMD::Splat8(plane.Normal.x);
+            result.ny[p] = SIMD::Splat8(plane.Normal.y);
+            result.nz[p] = SIMD::Splat8(plane.Normal.z);
+            result.d[p] = SIMD::Splat8(plane.Distance);
+            result.absNx[p] = SIMD::Splat8(Abs(plane.Normal.x));
+            result.absNy[p] = SIMD::Splat8(Abs(plane.Normal.y));
+            result.absNz[p] = SIMD::Splat8(Abs(plane.Normal.z));
+        }
+        return result;
+    }
+
+    // One bit per lane, set when the bound at that lane is visible. radius is the bound's extent
+    // along each plane's normal: the sphere radius, or computed from the box extents.
+    template <typename Radius>
+    static uint32 VisibleLanes(SplatPlanes const &planes, SIMD::Float8 x, SIMD::Float8 y,
+                               SIMD::Float8 z, Radius radius)
+    {
+        SIMD::Float8 const zero = SIMD::Splat8(0.0f);
+        SIMD::Float8 outside = SIMD::Splat8(0.0f);
+        for (usz p = 0; p < PlaneCount; ++p)
+        {
+            SIMD::Float8 distance = SIMD::MulAdd(planes.nx[p], x, planes.d[p]);
+            distance = SIMD::MulAdd(planes.ny[p], y, distance);
+            distance = SIMD::MulAdd(planes.nz[p], z, distance);
+            outside = SIMD::Or(outside, SIMD::Less(distance, SIMD::Sub(zero, radius(p))));
+        }
+        return ~SIMD::MoveMask(outside) & 0xFF;
+    }
+
+    // Calls visit(first, visibleBits) for each group of eight spheres starting at first. Lanes
+    // past the end of the streams are never visible.
+    template <typename Visit> void ForEachBatch(ConstSphereStreams spheres, Visit visit) const
+    {
+        usz const count = spheres.Radius.size();
+        LAT_ASSERT(spheres.Center.x.size() == count && spheres.Center.y.size() == count &&
+                   spheres.Center.z.size() == count);
+
+        SplatPlanes const planes = Splat();
+        auto visible = [&planes](float const *x, float const *y, float const *z,
+                                 float const *r) {
+            SIMD::Float8 const radius = SIMD::LoadUnaligned8(r);
+            return VisibleLanes(planes, SIMD::LoadUnaligned8(x), SIMD::LoadUnaligned8(y),
+                                SIMD::LoadUnaligned8(z), [radius](usz) { return radius; });
+        };
+
+        usz i = 0;
+        for (; i + k_CullBatch <= count; i += k_CullBatch)
+        {
+            visit(i, visible(&spheres.Center.x[i], &spheres.Center.y[i], &spheres.Center.z[i],
+                             &spheres.Radius[i]));
+        }
+        if (i < count)
+        {
+            usz const remaining = count - i;
+            float x[k_CullBatch] = {}, y[k_CullBatch] = {}, z[k_CullBatch] = {},
+                  r[k_CullBatch] = {};
+            for (usz l = 0; l < remaining; ++l)
+            {
+                x[l] = spheres.Center.x[i + l];
+                y[l] = spheres.Center.y[i + l];
+                z[l] = spheres.Center.z[i + l];
+                r[l] = spheres.Radius[i + l];
+            }
+            visit(i, visible(x, y, z, r) & ((1u << remaining) - 1));
+        }
+    }
+
+    template <typename Visit> void ForEachBatch(ConstAABBStreams boxes, Visit visit) const
+    {
+        usz const count = boxes.Center.x.size();
+        LAT_ASSERT(boxes.Center.y.size() == count && boxes.Center.z.size() == count &&
+                   boxes.Extents.x.size() == count && boxes.Extents.y.size() == count &&
+                   boxes.Extents.z.size() == count);
+
+        SplatPlanes const planes = Splat();
+        auto visible = [&planes](float const *const (&in)[6]) {
+            SIMD::Float8 const ex = SIMD::LoadUnaligned8(in[3]);
+            SIMD::Float8 const ey = SIMD::LoadUnaligned8(in[4]);
+            SIMD::Float8 const ez = SIMD::LoadUnaligned8(in[5]);
+            return VisibleLanes(planes, SIMD::LoadUnaligned8(in[0]), SIMD::LoadUnaligned8(in[1]),
+                                SIMD::LoadUnaligned8(in[2]), [&](usz p) {
+                                    SIMD::Float8 radius = SIMD::Mul(planes.absNx[p], ex);
+                                    radius = SIMD::MulAdd(planes.absNy[p], ey, radius);
+                                    return SIMD::MulAdd(planes.absNz[p], ez, radius);
+                                });
+        };
+
+        std::span<float const> const streams[6] = {boxes.Center.x,  boxes.Center.y,
+                                                   boxes.Center.z,  boxes.Extents.x,
+                                                   boxes.Extents.y, boxes.Extents.z};
+        usz i = 0;
+        for (; i + k_CullBatch <= count; i += k_CullBatch)
+        {
+            float const *const in[6] = {&streams[0][i], &streams[1][i], &streams[2][i],
+                                        &streams[3][i], &streams[4][i], &streams[5][i]};
+            visit(i, visible(in));
+        }
+        if (i < count)
+        {
+            usz const remaining = count - i;
+            float padded[6][k_CullBatch] = {};
+            for (usz s = 0; s < 6; ++s)
+            {
+                for (usz l = 0; l < remaining; ++l)
+                {
+                    padded[s][l] = streams[s][i + l];
+                }
+            }
+            float const *const in[6] = {padded[0], padded[1], padded[2],
+                                        padded[3], padded[4], padded[5]};
+            visit(i, visible(in) & ((1u << remaining) - 1));
+        }
+    }
+
+    static usz AppendIndices(usz first, uint32 visible, std::span<uint32> out, usz count)
+    {
+        for (; visible != 0; visible &= visible - 1)
+        {
+            out[count++] = static_cast<uint32>(first) + std::countr_zero(visible);
+        }
+        return count;
+    }
+
+    static void ClearMask(usz count, std::span<uint64> mask)
+    {
+        for (usz w = 0; w < (count + 63) / 64; ++w)
+        {
+            mask[w] = 0;
+        }
+    }
+
+    // first is a multiple of eight, so a batch never straddles two words.
+    static void AppendMask(usz first, uint32 visible, std::span<uint64> mask)
+    {
+        mask[first / 64] |= static_cast<uint64>(visible) << (first % 64);
+    }
+};
+} // namespace Lateralus::Core
@@ -0,0 +1,835 @@
+module;
+
+#include <Core.Assert.h>
+#include <Core.Compiler.h>
+
+#if PLATFORM_WIN64
+#define MICROSOFT_WINDOWS_WINBASE_H_DEFINE_INTERLOCKED_CPLUSPLUS_OVERLOADS 0 // [#hack]
+#define __SPECSTRINGS_STRICT_LEVEL 0                                         // [#hack]
+#undef APIENTRY
+#include <windows.h>
+#undef __nullnullterminated // [#hack]
+#else
+#include <ucontext.h>
+#endif
+
+export module Lateralus.Core.Jobs;
+
+import <algorithm>;
+import <atomic>;
+import <bit>;
+import <deque>;
+import <fstream>;
+import <memory>;
+import <mutex>;
+import <set>;
+import <string>;
+import <thread>;
+import <utility>;
+import <vector>;
+
+import Lateralus.Core;
+import Lateralus.Core.Delegate;
+import Lateralus.Core.Memory;
+
+namespace Lateralus::Core
+{
+export struct CoreCounts
+{
+    // Hardware threads, counting each SMT sibling.
+    usz Logical = 1;
+    // Cores, counting SMT siblings once. Equal to Logical when the topology can't be read.
+    usz Physical = 1;
+};
+
+export CoreCounts DetectCoreCounts()
+{
+    CoreCounts counts;
+    counts.Logical = std::max(1u, std::thread::hardware_concurrency());
+    counts.Physical = 0;
+#if PLATFORM_WIN64
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+    std::vector<std::byte> buffer(length);
+    auto *info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *>(buffer.data());
+    if (length != 0 && GetLogicalProcessorInformationEx(RelationProcessorCore, info, &length))
+    {
+        // One variable sized record per core.
+        for (DWORD offset = 0; offset < length;)
+        {
+            auto const *record =
+                reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const *>(buffer.data() +
+                                                                                   offset);
+            counts.Physical++;
+            offset += record->Size;
+        }
+    }
+#elif PLATFORM_LINUX
+    // SMT siblings share a core id within their package.
+    std::set<std::pair<int, int>> cores;
+    for (usz cpu = 0; cpu < counts.Logical; ++cpu)
+    {
+        std::string const topology =
+            "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        std::ifstream package(topology + "physical_package_id");
+        std::ifstream core(topology + "core_id");
+        std::pair<int, int> id;
+        if (package >> id.first && core >> id.second)
+        {
+            cores.insert(id);
+        }
+    }
+    counts.Physical = cores.size();
+#endif
+    if (counts.Physical == 0 || counts.Physical > counts.Logical)
+    {
+        counts.Physical = counts.Logical;
+    }
+    return counts;
+}
+
+export using JobFunction = Delegate<void()>;
+
+export class JobCounter;
+struct Fiber;
+
+struct Job
+{
+    JobFunction Function;
+    JobCounter *Counter = nullptr;
+    // Links jobs waiting on the same counter.
+    Job *Next = nullptr;
+    // Set instead of Function for a job continuing a parked fiber.
+    Fiber *Resume = nullptr;
+};
+
+/// <summary>
+/// Counts unfinished jobs. Every job run with a counter adds one to it and takes it away once it
+/// has finished, so a counter reaching zero means all of its jobs are done. Other jobs can be set
+/// to start only then, see JobSystem::Run.
+///
+/// A counter can be reused once it reaches zero, and must outlive the jobs counted on it and the
+/// Run calls depending on it.
+/// </summary>
+export class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(JobCounter const &) = delete;
+    JobCounter &operator=(JobCounter const &) = delete;
+    ~JobCounter() { LAT_ASSERT(IsDone()); }
+
+    bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    // Held while the last job to finish hands the waiting jobs over, so nothing can be added to
+    // the count, and nothing waiting on it can see it done, before they're all taken.
+    static constexpr int32 k_Releasing = -1;
+
+    void Add()
+    {
+        int32 count = m_Count.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (count == k_Releasing)
+            {
+                std::this_thread::yield();
+                count = m_Count.load(std::memory_order_relaxed);
+            }
+            else if (m_Count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+    }
+
+    // Takes away one finished job. When that was the last one, returns the jobs that were
+    // waiting, which the caller has to schedule.
+    Job *Finish()
+    {
+        int32 count = m_Count.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            LAT_ASSERT(count > 0);
+            if (count == 1)
+            {
+                if (m_Count.compare_exchange_weak(count, k_Releasing, std::memory_order_acquire))
+                {
+                    Job *waiting = m_Waiting.exchange(nullptr, std::memory_order_acquire);
+                    // The counter may be destroyed from here on.
+                    m_Count.store(0, std::memory_order_release);
+                    return waiting;
+                }
+            }
+            else if (m_Count.compare_exchange_weak(count, count - 1, std::memory_order_release))
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    // Queues job until the count reaches zero. Returns the jobs that can run right away, which
+    // the caller has to schedule: job itself, possibly with others, when the count already is.
+    Job *AddWaiting(Job *job)
+    {
+        job->Next = m_Waiting.load(std::memory_order_relaxed);
+        while (!m_Waiting.compare_exchange_weak(job->Next, job, std::memory_order_release))
+        {
+        }
+        for (;;)
+        {
+            int32 const count = m_Count.load(std::memory_order_acquire);
+            if (count == 0)
+            {
+                // Whichever exchange comes first owns the list, so each job is taken once.
+                return m_Waiting.exchange(nullptr, std::memory_order_acquire);
+            }
+            if (count != k_Releasing)
+            {
+                // The last job to finish will take it.
+                return nullptr;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    std::atomic<int32> m_Count = 0;
+    std::atomic<Job *> m_Waiting = nullptr;
+};
+
+// Chase-Lev work stealing deque of fixed capacity. The owning worker pushes and pops at the
+// bottom, any other thread steals from the top.
+class JobDeque
+{
+public:
+    explicit JobDeque(usz capacity)
+        : m_Jobs(std::make_unique<std::atomic<Job *>[]>(capacity)),
+          m_Mask(static_cast<int64>(capacity) - 1)
+    {
+        LAT_ASSERT(std::has_single_bit(capacity));
+    }
+
+    // Owner only. Returns false when full.
+    bool Push(Job *job)
+    {
+        int64 const bottom = m_Bottom.load(std::memory_order_relaxed);
+        int64 const top = m_Top.load(std::memory_order_acquire);
+        if (bottom - top > m_Mask)
+        {
+            return false;
+        }
+        m_Jobs[bottom & m_Mask].store(job, std::memory_order_relaxed);
+        // Publishes the job to thieves, which load the bottom with acquire.
+        m_Bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Owner only. Takes the most recently pushed job.
+    Job *Pop()
+    {
+        int64 const bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64 top = m_Top.load(std::memory_order_relaxed);
+        if (top > bottom)
+        {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Job *job = m_Jobs[bottom & m_Mask].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // The last job: race the thieves for it.
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    // Any thread. Takes the oldest job, or nothing when empty or when losing a race for it.
+    Job *Steal()
+    {
+        int64 top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64 const bottom = m_Bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+        Job *job = m_Jobs[top & m_Mask].load(std::memory_order_relaxed);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return job;
+    }
+
+private:
+    std::unique_ptr<std::atomic<Job *>[]> m_Jobs;
+    int64 m_Mask;
+    // On separate cache lines so thieves don't invalidate the owner's end.
+    alignas(64) std::atomic<int64> m_Top = 0;
+    alignas(64) std::atomic<int64> m_Bottom = 0;
+};
+
+// An execution context with its own stack that threads can switch into and out of. A fiber
+// suspended on one thread may be resumed on another.
+using FiberEntry = void (*)(void *argument);
+
+struct Fiber
+{
+#if PLATFORM_WIN64
+    void *Handle = nullptr;
+    FiberEntry Entry = nullptr;
+    void *Argument = nullptr;
+#else
+    ucontext_t Context;
+    std::unique_ptr<std::byte[]> Stack;
+#endif
+};
+
+#if PLATFORM_WIN64
+VOID WINAPI FiberTrampoline(void *data)
+{
+    Fiber const &fiber = *static_cast<Fiber *>(data);
+    fiber.Entry(fiber.Argument);
+}
+#else
+// makecontext only passes ints, so the pointers arrive split in halves.
+void FiberTrampoline(uint32 entryLow, uint32 entryHigh, uint32 argumentLow, uint32 argumentHigh)
+{
+    auto const join = [](uint32 low, uint32 high) {
+        return (static_cast<uintptr_t>(high) << 16 << 16) | low;
+    };
+    reinterpret_cast<FiberEntry>(join(entryLow, entryHigh))(
+        reinterpret_cast<void *>(join(argumentLow, argumentHigh)));
+}
+#endif
+
+// entry must never return; the fiber ends by switching away for good.
+void CreateFiber(Fiber &fiber, usz stackSize, FiberEntry entry, void *argument)
+{
+#if PLATFORM_WIN64
+    fiber.Entry = entry;
+    fiber.Argument = argument;
+    fiber.Handle = ::CreateFiber(stackSize, &FiberTrampoline, &fiber);
+#else
+    fiber.Stack = std::make_unique<std::byte[]>(stackSize);
+    getcontext(&fiber.Context);
+    fiber.Context.uc_stack.ss_sp = fiber.Stack.get();
+    fiber.Context.uc_stack.ss_size = stackSize;
+    fiber.Context.uc_link = nullptr;
+    auto const entryBits = reinterpret_cast<uintptr_t>(entry);
+    auto const argumentBits = reinterpret_cast<uintptr_t>(argument);
+    makecontext(&fiber.Context, reinterpret_cast<void (*)()>(&FiberTrampoline), 4,
+                static_cast<uint32>(entryBits), static_cast<uint32>(entryBits >> 16 >> 16),
+                static_cast<uint32>(argumentBits), static_cast<uint32>(argumentBits >> 16 >> 16));
+#endif
+}
+
+void DestroyFiber(Fiber &fiber)
+{
+#if PLATFORM_WIN64
+    DeleteFiber(fiber.Handle);
+#else
+    fiber.Stack.reset();
+#endif
+}
+
+// Makes the calling thread's own stack a fiber that can be switched back to.
+void ConvertThreadToFiber(Fiber &fiber)
+{
+#if PLATFORM_WIN64
+    fiber.Handle = ::ConvertThreadToFiber(nullptr);
+#else
+    (void)fiber;
+#endif
+}
+
+void ConvertFiberToThread()
+{
+#if PLATFORM_WIN64
+    ::ConvertFiberToThread();
+#endif
+}
+
+void SwitchFiber(Fiber &from, Fiber &to)
+{
+#if PLATFORM_WIN64
+    (void)from;
+    SwitchToFiber(to.Handle);
+#else
+    swapcontext(&from.Context, &to.Context);
+#endif
+}
+
+export struct JobSystemSettings
+{
+    // Threads started besides the one creating the system. By default one per physical core,
+    // leaving one for the creating thread.
+    usz WorkerCount = DetectCoreCounts().Physical - 1;
+    // Jobs each thread can have queued. Pushing more runs the job right away. Power of two.
+    usz QueueCapacity = 4096;
+    // Fibers shared by the workers, see JobSystem. 0 runs jobs straight on the worker threads.
+    usz FiberCount = 0;
+    usz FiberStackSize = 256 * 1024;
+};
+
+/// <summary>
+/// A fixed pool of worker threads running jobs, small functions that may run on any of them.
+///
+/// Each thread, including the one that created the system, queues the jobs it runs on its own
+/// deque and takes them back newest first, which keeps what a job just produced in its cache.
+/// Threads with nothing left steal the oldest jobs of the others, which tend to be the biggest
+/// pieces of work. Threads not belonging to the system can run jobs too; those go through a
+/// shared locked queue.
+///
+/// Waiting on a counter never blocks a thread of the system: it runs other jobs meanwhile. Idle
+/// workers sleep until a job is queued.
+///
+/// With fibers, workers run jobs on fibers from a fixed pool. A job waiting on a counter then
+/// parks its fiber on the counter and the worker carries on with other jobs on a free fiber. The
+/// last job to finish on the counter queues the parked fiber again, and whichever worker picks it
+/// up continues the waiting job where it left off. Deep chains of jobs waiting on each other so
+/// neither pile up on one stack nor hold threads idle. Jobs the creating thread runs, and workers
+/// once every fiber is taken, wait by running other jobs as without fibers.
+///
+/// A job that waits with fibers may continue on another thread, so it mustn't keep thread local
+/// state, or locks, across the wait. Parked fibers only continue on workers running on a fiber,
+/// so FiberCount should stay well above the number of waits that can be in flight at once.
+/// </summary>
+export class JobSystem
+{
+public:
+    explicit JobSystem(JobSystemSettings const &settings = {})
+    {
+        usz const threadCount = settings.WorkerCount + 1;
+        m_Threads.reserve(threadCount);
+        for (usz i = 0; i < threadCount; ++i)
+        {
+            m_Threads.push_back(std::make_unique<ThreadState>(this, i, settings.QueueCapacity));
+        }
+        if (settings.WorkerCount != 0)
+        {
+            m_Fibers.resize(settings.FiberCount);
+            for (Fiber &fiber : m_Fibers)
+            {
+                CreateFiber(fiber, settings.FiberStackSize, &FiberMain, this);
+                m_FreeFibers.push_back(&fiber);
+            }
+        }
+        LAT_ASSERT(CurrentThread() == nullptr);
+        t_Thread = m_Threads[0].get();
+        m_Workers.reserve(settings.WorkerCount);
+        for (usz i = 1; i < threadCount; ++i)
+        {
+            m_Workers.emplace_back([this, i] { WorkerMain(*m_Threads[i]); });
+        }
+    }
+
+    JobSystem(JobSystem const &) = delete;
+    JobSystem &operator=(JobSystem const &) = delete;
+
+    // Every counter should be waited on first. Jobs still queued are dropped without running.
+    ~JobSystem()
+    {
+        m_Stopping.store(true, std::memory_order_relaxed);
+        m_Epoch.fetch_add(1, std::memory_order_seq_cst);
+        m_Epoch.notify_all();
+        for (std::thread &worker : m_Workers)
+        {
+            worker.join();
+        }
+        if (CurrentThread() == m_Threads[0].get())
+        {
+            t_Thread = nullptr;
+        }
+        for (std::unique_ptr<ThreadState> &thread : m_Threads)
+        {
+            while (Job *job = thread->Deque.Steal())
+            {
+                PoolDelete(job);
+            }
+        }
+        for (Job *job : m_Injected)
+        {
+            PoolDelete(job);
+        }
+        for (Fiber &fiber : m_Fibers)
+        {
+            DestroyFiber(fiber);
+        }
+    }
+
+    // Queues function to run on any thread. When counter is given, it counts the job until it
+    // has finished.
+    void Run(JobFunction function, JobCounter *counter = nullptr)
+    {
+        Schedule(CreateJob(std::move(function), counter));
+    }
+
+    // Like Run, but the job only starts once after reaches zero.
+    void Run(JobFunction function, JobCounter *counter, JobCounter &after)
+    {
+        Job *job = CreateJob(std::move(function), counter);
+        if (after.IsDone())
+        {
+            Schedule(job);
+        }
+        else
+        {
+            ScheduleList(after.AddWaiting(job));
+        }
+    }
+
+    // Returns once counter is zero. Threads of the system run other jobs meanwhile, or with
+    // fibers, park the calling job until then.
+    void Wait(JobCounter &counter)
+    {
+        if (counter.IsDone())
+        {
+            return;
+        }
+        ThreadState *thread = CurrentThread();
+        bool const isMember = thread != nullptr && thread->System == this;
+        if (isMember && thread->CurrentFiber != nullptr)
+        {
+            if (Fiber *next = AcquireFiber())
+            {
+                // The next fiber queues this one on the counter once it's fully switched out, so
+                // nothing can resume it before then.
+                Fiber *self = thread->CurrentFiber;
+                thread->ParkFiber = self;
+                thread->ParkOn = &counter;
+                thread->CurrentFiber = next;
+                SwitchFiber(*self, *next);
+                AfterSwitch();
+                LAT_ASSERT(counter.IsDone());
+                return;
+            }
+        }
+        while (!counter.IsDone())
+        {
+            Job *job = isMember ? FindJob(*CurrentThread(), false) : nullptr;
+            if (job != nullptr)
+            {
+                Execute(job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /// <summary>
+    /// Calls function(begin, end) on ranges covering [0, count) exactly once, spread over the
+    /// threads of the system, and returns once all calls have returned.
+    ///
+    /// Ranges hold at least minGrain items. Past that the range size is picked to give every
+    /// thread a few ranges, so uneven ranges still balance out without a job per item.
+    /// </summary>
+    template <typename Function> void ParallelFor(usz count, Function &&function, usz minGrain = 1)
+    {
+        constexpr usz rangesPerThread = 4;
+        usz const rangeCount = GetThreadCount() * rangesPerThread;
+        usz const grain = std::max<usz>({minGrain, (count + rangeCount - 1) / rangeCount, 1});
+        if (count <= grain)
+        {
+            if (count != 0)
+            {
+                function(usz(0), count);
+            }
+            return;
+        }
+
+        JobCounter counter;
+        for (usz begin = grain; begin < count; begin += grain)
+        {
+            usz const end = std::min(count, begin + grain);
+            Run([&function, begin, end] { function(begin, end); }, &counter);
+        }
+        function(usz(0), grain);
+        Wait(counter);
+    }
+
+    // Workers plus the thread that created the system.
+    usz GetThreadCount() const { return m_Threads.size(); }
+
+private:
+    struct ThreadState
+    {
+        ThreadState(JobSystem *system, usz index, usz queueCapacity)
+            : System(system), Index(index), Deque(queueCapacity),
+              Random(static_cast<uint32>(index) * 2654435761u + 1)
+        {
+        }
+
+        JobSystem *System;
+        usz Index;
+        JobDeque Deque;
+        uint32 Random;
+
+        // The worker's own stack, switched back to when stopping.
+        Fiber ThreadFiber;
+        // The pooled fiber this worker runs on, null without fibers.
+        Fiber *CurrentFiber = nullptr;
+        // Left for whichever fiber runs next to deal with, once the previous one is switched out:
+        // a fiber to return to the pool, or one to park on a counter.
+        Fiber *ReleaseFiber = nullptr;
+        Fiber *ParkFiber = nullptr;
+        JobCounter *ParkOn = nullptr;
+    };
+
+    // A job on a fiber can suspend on one thread and resume on another. Compilers assume a thread
+    // local's address can't change within a function, so they may keep the one read before the
+    // switch and use the old thread's value after it. Every read goes through a call that can't be
+    // inlined, and the same goes for any thread local used from jobs, e.g. in Memory and Profile.
+    LAT_NOINLINE static ThreadState *CurrentThread()
+    {
+        return t_Thread;
+    }
+
+    static Job *CreateJob(JobFunction function, JobCounter *counter)
+    {
+        LAT_ASSERT(function);
+        if (counter != nullptr)
+        {
+            counter->Add();
+        }
+        return PoolNew<Job>(std::move(function), counter);
+    }
+
+    void Schedule(Job *job)
+    {
+        ThreadState *thread = CurrentThread();
+        if (job->Resume != nullptr)
+        {
+            // Only workers may pick up parked fibers, the creating thread has to stay itself.
+            std::lock_guard lock(m_ResumableMutex);
+            m_Resumable.push_back(job);
+            m_ResumableCount.store(m_Resumable.size(), std::memory_order_relaxed);
+        }
+        else if (thread != nullptr && thread->System == this)
+        {
+            if (!thread->Deque.Push(job))
+            {
+                Execute(job);
+                return;
+            }
+        }
+        else
+        {
+            std::lock_guard lock(m_InjectedMutex);
+            m_Injected.push_back(job);
+            m_InjectedCount.store(m_Injected.size(), std::memory_order_relaxed);
+        }
+        // Pairs with the sleeping count and epoch check in WorkerMain: either the worker sees the
+        // new epoch, or this sees the worker sleeping.
+        m_Epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (m_SleepingCount.load(std::memory_order_seq_cst) != 0)
+        {
+            m_Epoch.notify_one();
+        }
+    }
+
+    void ScheduleList(Job *job)
+    {
+        while (job != nullptr)
+        {
+            Job *next = job->Next;
+            Schedule(job);
+            job = next;
+        }
+    }
+
+    void Execute(Job *job)
+    {
+        if (job->Resume != nullptr)
+        {
+            // Continue the parked job; this fiber goes back to the pool once switched out.
+            Fiber *target = job->Resume;
+            PoolDelete(job);
+            ThreadState &thread = *CurrentThread();
+            Fiber *self = thread.CurrentFiber;
+            thread.ReleaseFiber = self;
+            thread.CurrentFiber = target;
+            SwitchFiber(*self, *target);
+            AfterSwitch();
+            return;
+        }
+        job->Function();
+        if (job->Counter != nullptr)
+        {
+            ScheduleList(job->Counter->Finish());
+        }
+        PoolDelete(job);
+    }
+
+    Job *FindJob(ThreadState &thread, bool includeResumable)
+    {
+        if (includeResumable && m_ResumableCount.load(std::memory_order_relaxed) != 0)
+        {
+            // Parked jobs go first; they're further along.
+            std::lock_guard lock(m_ResumableMutex);
+            if (!m_Resumable.empty())
+            {
+                Job *job = m_Resumable.front();
+                m_Resumable.pop_front();
+                m_ResumableCount.store(m_Resumable.size(), std::memory_order_relaxed);
+                return job;
+            }
+        }
+        if (Job *job = thread.Deque.Pop())
+        {
+            return job;
+        }
+        if (m_InjectedCount.load(std::memory_order_relaxed) != 0)
+        {
+            std::lock_guard lock(m_InjectedMutex);
+            if (!m_Injected.empty())
+            {
+                Job *job = m_Injected.front();
+                m_Injected.pop_front();
+                m_InjectedCount.store(m_Injected.size(), std::memory_order_relaxed);
+                return job;
+            }
+        }
+        // Start at a random victim so thieves spread out instead of all hitting the same deque.
+        usz const count = m_Threads.size();
+        thread.Random ^= thread.Random << 13;
+        thread.Random ^= thread.Random >> 17;
+        thread.Random ^= thread.Random << 5;
+        usz const start = thread.Random % count;
+        for (usz i = 0; i < count; ++i)
+        {
+            usz const victim = (start + i) % count;
+            if (victim == thread.Index)
+            {
+                continue;
+            }
+            if (Job *job = m_Threads[victim]->Deque.Steal())
+            {
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    Fiber *AcquireFiber()
+    {
+        std::lock_guard lock(m_FreeFibersMutex);
+        if (m_FreeFibers.empty())
+        {
+            return nullptr;
+        }
+        Fiber *fiber = m_FreeFibers.back();
+        m_FreeFibers.pop_back();
+        return fiber;
+    }
+
+    // Runs first thing on the fiber switched to, finishing what the previous fiber left.
+    void AfterSwitch()
+    {
+        ThreadState &thread = *CurrentThread();
+        if (thread.ReleaseFiber != nullptr)
+        {
+            std::lock_guard lock(m_FreeFibersMutex);
+            m_FreeFibers.push_back(thread.ReleaseFiber);
+            thread.ReleaseFiber = nullptr;
+        }
+        if (thread.ParkFiber != nullptr)
+        {
+            Job *resume = PoolNew<Job>();
+            resume->Resume = thread.ParkFiber;
+            JobCounter *counter = thread.ParkOn;
+            thread.ParkFiber = nullptr;
+            thread.ParkOn = nullptr;
+            ScheduleList(counter->AddWaiting(resume));
+        }
+    }
+
+    // Picks up jobs until stopping. Fibers may switch in and out of this on any worker.
+    void RunJobs()
+    {
+        while (!m_Stopping.load(std::memory_order_relaxed))
+        {
+            uint64 const epoch = m_Epoch.load(std::memory_order_seq_cst);
+            ThreadState &thread = *CurrentThread();
+            if (Job *job = FindJob(thread, thread.CurrentFiber != nullptr))
+            {
+                Execute(job);
+                continue;
+            }
+            m_SleepingCount.fetch_add(1, std::memory_order_seq_cst);
+            // Stopping is set before the epoch is bumped, so a worker seeing the new epoch sees it.
+            if (m_Epoch.load(std::memory_order_seq_cst) == epoch &&
+                !m_Stopping.load(std::memory_order_relaxed))
+            {
+                m_Epoch.wait(epoch, std::memory_order_seq_cst);
+            }
+            m_SleepingCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    static void FiberMain(void *argument)
+    {
+        auto *system = static_cast<JobSystem *>(argument);
+        system->AfterSwitch();
+        system->RunJobs();
+        // Back to the worker's own stack to let the thread end. Never resumed.
+        ThreadState &thread = *CurrentThread();
+        SwitchFiber(*thread.CurrentFiber, thread.ThreadFiber);
+    }
+
+    void WorkerMain(ThreadState &thread)
+    {
+        t_Thread = &thread;
+        if (Fiber *fiber = AcquireFiber())
+        {
+            ConvertThreadToFiber(thread.ThreadFiber);
+            thread.CurrentFiber = fiber;
+            SwitchFiber(thread.ThreadFiber, *fiber);
+            // Whichever fiber this thread stopped on switched back here; it's not used again.
+            thread.CurrentFiber = nullptr;
+            ConvertFiberToThread();
+        }
+        else
+        {
+            RunJobs();
+        }
+        t_Thread = nullptr;
+    }
+
+    static thread_local inline ThreadState *t_Thread = nullptr;
+
+    // Index 0 belongs to the thread that created the system, the rest to the workers.
+    std::vector<std::unique_ptr<ThreadState>> m_Threads;
+    std::vector<std::thread> m_Workers;
+
+    std::mutex m_InjectedMutex;
+    std::deque<Job *> m_Injected;
+    std::atomic<usz> m_InjectedCount = 0;
+
+    // Parked fibers ready to continue.
+    std::mutex m_ResumableMutex;
+    std::deque<Job *> m_Resumable;
+    std::atomic<usz> m_ResumableCount = 0;
+
+    std::vector<Fiber> m_Fibers;
+    std::mutex m_FreeFibersMutex;
+    std::vector<Fiber *> m_FreeFibers;
+
+    // Bumped whenever a job is queued; idle workers sleep on it.
+    std::atomic<uint64> m_Epoch = 0;
+    std::atomic<uint32> m_SleepingCount = 0;
+    std::atomic<bool> m_Stopping = false;
+};
+} // namespace Lateralus::Core
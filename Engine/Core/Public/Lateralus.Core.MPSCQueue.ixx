@@ -0,0 +1,112 @@
+module;
+
+#include <Core.Assert.h>
+
+export module Lateralus.Core.MPSCQueue;
+
+import <atomic>;
+import <bit>;
+import <memory>;
+import <utility>;
+
+import Lateralus.Core;
+
+namespace Lateralus::Core
+{
+/// <summary>
+/// A bounded queue any number of threads can push to and one thread pops from, without locks.
+///
+/// Each slot carries a sequence number saying whether it's free for the push claiming that
+/// position or holds a value ready to pop (Dmitry Vyukov's bounded queue). Pushers only contend on
+/// one atomic increment and never wait for each other; a full queue makes TryPush fail rather than
+/// block.
+///
+/// Capacity must be a power of two. T must be default constructible and movable.
+/// </summary>
+export template <typename T> class MPSCQueue
+{
+public:
+    explicit MPSCQueue(usz capacity)
+        : m_Cells(std::make_unique<Cell[]>(capacity)), m_Mask(capacity - 1)
+    {
+        LAT_ASSERT(std::has_single_bit(capacity));
+        for (usz i = 0; i < capacity; ++i)
+        {
+            m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCQueue(MPSCQueue const &) = delete;
+    MPSCQueue &operator=(MPSCQueue const &) = delete;
+
+    // Safe from any thread. Returns false, leaving value alone, when the queue is full.
+    bool TryPush(T &&value)
+    {
+        usz position = m_Tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell &cell = m_Cells[position & m_Mask];
+            usz const sequence = cell.Sequence.load(std::memory_order_acquire);
+            sz const difference = static_cast<sz>(sequence) - static_cast<sz>(position);
+            if (difference == 0)
+            {
+                // The slot is free for this position; claim the position.
+                if (m_Tail.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed))
+                {
+                    cell.Value = std::move(value);
+                    cell.Sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The slot still holds the value from one lap ago.
+                return false;
+            }
+            else
+            {
+                // Another producer claimed this position first.
+                position = m_Tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryPush(T const &value) { return TryPush(T(value)); }
+
+    // Only from the consumer thread. Returns false when nothing is ready, which includes a value
+    // whose push is still in progress.
+    bool TryPop(T &out)
+    {
+        Cell &cell = m_Cells[m_Head & m_Mask];
+        usz const sequence = cell.Sequence.load(std::memory_order_acquire);
+        if (sequence != m_Head + 1)
+        {
+            return false;
+        }
+        out = std::move(cell.Value);
+        // Free the slot for the push one lap ahead.
+        cell.Sequence.store(m_Head + m_Mask + 1, std::memory_order_release);
+        ++m_Head;
+        return true;
+    }
+
+    // Pushes claimed but not yet popped. Exact on the consumer thread when no push is running.
+    usz GetSizeApprox() const { return m_Tail.load(std::memory_order_relaxed) - m_Head; }
+
+    usz GetCapacity() const { return m_Mask + 1; }
+
+private:
+    struct Cell
+    {
+        std::atomic<usz> Sequence;
+        T Value;
+    };
+
+    std::unique_ptr<Cell[]> m_Cells;
+    usz m_Mask;
+    // On separate cache lines so the consumer and the producers don't invalidate each other.
+    alignas(64) std::atomic<usz> m_Tail = 0;
+    alignas(64) usz m_Head = 0;
+};
+} // namespace Lateralus::Core
@@ -1,10 +1,15 @@
 module;
 #define _USE_MATH_DEFINES 1
+#include <Core.Assert.h>
 #include <math.h>
 #include <limits>
 export module Lateralus.Core.Math;
 
+import <span>;
+import <type_traits>;
+
 import Lateralus.Core;
+import Lateralus.Core.SIMD;
 
 namespace Lateralus::Core
 {
@@ -42,19 +47,371 @@ export constexpr float RelativeEpsilon(float a, float b)
     return MachineEpsilon * Max(1.f, Abs(a), Abs(b));
 }
 
-float Pow(float val, int power);
-template <int power> float Pow(float val) { return Pow(val, power); }
-template <> float Pow<2>(float val) { return val * val; }
-template <> float Pow<3>(float val) { return val * val * val; }
+constexpr float Pow(float val, int power);
+template <int power> constexpr float Pow(float val) { return Pow(val, power); }
+template <> constexpr float Pow<2>(float val) { return val * val; }
+template <> constexpr float Pow<3>(float val) { return val * val * val; }
+
+//////////////////////////////////////////////////////////////////////////
+// Compile time fallbacks
+//
+// The C runtime functions aren't constexpr, so constant evaluation uses these series instead,
+// worked in double so they round to the correct (or an adjacent) float. They are slow and only
+// meant for constant tables and matrices; at runtime the functions below call the C runtime (or
+// SIMD for the Precision overloads), so a constant result may differ from a runtime one in the
+// last bit.
+
+constexpr double k_PiD = 3.14159265358979323846;
+constexpr double k_HalfPiD = 1.57079632679489661923;
+constexpr double k_Ln2D = 0.693147180559945309417;
+
+constexpr bool IsNaN(double val) { return val != val; }
+constexpr double Infinity() { return std::numeric_limits<double>::infinity(); }
+constexpr double NaN() { return std::numeric_limits<double>::quiet_NaN(); }
+
+constexpr double ConstexprSqrt(double val)
+{
+    if (IsNaN(val) || val < 0.0)
+    {
+        return NaN();
+    }
+    if (val == 0.0 || val == Infinity())
+    {
+        return val;
+    }
+    // Newton's method from a guess within a factor of two, found by scaling by powers of four.
+    double guess = 1.0;
+    for (double scaled = val; scaled > 4.0; scaled *= 0.25)
+    {
+        guess *= 2.0;
+    }
+    for (double scaled = val; scaled < 0.25; scaled *= 4.0)
+    {
+        guess *= 0.5;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        guess = 0.5 * (guess + val / guess);
+    }
+    return guess;
+}
 
-export float Sin(float val) { return ::sin(val); }
-export float Cos(float val) { return ::cos(val); }
-export float ASin(float val) { return ::asin(val); }
-export float ACos(float val) { return ::acos(val); }
-export void SinCos(float val, float &sinOut, float &cosOut) { sinOut = Sin(val); cosOut = Cos(val); }
-export void ASinACos(float val, float &asinOut, float &acosOut) { asinOut = ASin(val); acosOut = ACos(val); }
-export float Pow(float val, int power) { return ::powf(val, static_cast<float>(power)); }
-export float Sqrt(float val) { return ::sqrtf(val); }
+// sin(val) for |val| <= Pi/4
+constexpr double ConstexprSinSeries(double val)
+{
+    double const val2 = val * val;
+    double term = val;
+    double result = val;
+    for (int n = 1; n < 12; ++n)
+    {
+        term *= -val2 / static_cast<double>((2 * n) * (2 * n + 1));
+        result += term;
+    }
+    return result;
+}
+
+// cos(val) for |val| <= Pi/4
+constexpr double ConstexprCosSeries(double val)
+{
+    double const val2 = val * val;
+    double term = 1.0;
+    double result = 1.0;
+    for (int n = 1; n < 12; ++n)
+    {
+        term *= -val2 / static_cast<double>((2 * n - 1) * (2 * n));
+        result += term;
+    }
+    return result;
+}
+
+constexpr void ConstexprSinCos(double val, double &sinOut, double &cosOut)
+{
+    if (IsNaN(val) || val == Infinity() || val == -Infinity())
+    {
+        sinOut = cosOut = NaN();
+        return;
+    }
+    // val = quadrant * Pi/2 + r with |r| <= Pi/4
+    double const scaled = val / k_HalfPiD;
+    long long const quadrant =
+        static_cast<long long>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+    double const r = val - static_cast<double>(quadrant) * k_HalfPiD;
+    double const s = ConstexprSinSeries(r);
+    double const c = ConstexprCosSeries(r);
+    switch (quadrant & 3)
+    {
+    case 0: sinOut = s; cosOut = c; break;
+    case 1: sinOut = c; cosOut = -s; break;
+    case 2: sinOut = -s; cosOut = -c; break;
+    default: sinOut = -c; cosOut = s; break;
+    }
+}
+
+// atan(val) for any finite val
+constexpr double ConstexprATan(double val)
+{
+    if (val < 0.0)
+    {
+        return -ConstexprATan(-val);
+    }
+    if (val > 1.0)
+    {
+        return k_HalfPiD - ConstexprATan(1.0 / val);
+    }
+    // atan(a) = 2 atan(a / (1 + sqrt(1 + a^2))), twice, leaves |a| <= tan(Pi/16) for the series.
+    double a = val;
+    for (int i = 0; i < 2; ++i)
+    {
+        a = a / (1.0 + ConstexprSqrt(1.0 + a * a));
+    }
+    double const a2 = a * a;
+    double power = a;
+    double result = 0.0;
+    for (int n = 0; n < 14; ++n)
+    {
+        double const term = power / static_cast<double>(2 * n + 1);
+        result += (n % 2 == 0) ? term : -term;
+        power *= a2;
+    }
+    return 4.0 * result;
+}
+
+constexpr double ConstexprATan2(double y, double x)
+{
+    if (IsNaN(y) || IsNaN(x))
+    {
+        return NaN();
+    }
+    if (x == 0.0)
+    {
+        return y > 0.0 ? k_HalfPiD : (y < 0.0 ? -k_HalfPiD : 0.0);
+    }
+    double const angle = ConstexprATan(y / x);
+    if (x > 0.0)
+    {
+        return angle;
+    }
+    return y >= 0.0 ? angle + k_PiD : angle - k_PiD;
+}
+
+constexpr double ConstexprExp(double val)
+{
+    if (IsNaN(val))
+    {
+        return val;
+    }
+    if (val > 710.0)
+    {
+        return Infinity();
+    }
+    if (val < -746.0)
+    {
+        return 0.0;
+    }
+    // val = n * ln(2) + r with |r| <= ln(2) / 2, then exp(val) = 2^n * exp(r)
+    double const scaled = val / k_Ln2D;
+    long long const n = static_cast<long long>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+    double const r = val - static_cast<double>(n) * k_Ln2D;
+    double term = 1.0;
+    double result = 1.0;
+    for (int i = 1; i < 18; ++i)
+    {
+        term *= r / static_cast<double>(i);
+        result += term;
+    }
+    for (long long i = 0; i < n; ++i)
+    {
+        result *= 2.0;
+    }
+    for (long long i = 0; i > n; --i)
+    {
+        result *= 0.5;
+    }
+    return result;
+}
+
+constexpr double ConstexprLog(double val)
+{
+    if (IsNaN(val) || val < 0.0)
+    {
+        return NaN();
+    }
+    if (val == 0.0)
+    {
+        return -Infinity();
+    }
+    if (val == Infinity())
+    {
+        return val;
+    }
+    // val = m * 2^e with sqrt(0.5) <= m <= sqrt(2), then log(m) = 2 atanh((m - 1) / (m + 1))
+    constexpr double k_Sqrt2 = 1.41421356237309504880;
+    double m = val;
+    int e = 0;
+    for (; m > k_Sqrt2; m *= 0.5)
+    {
+        ++e;
+    }
+    for (; m < 0.5 * k_Sqrt2; m *= 2.0)
+    {
+        --e;
+    }
+    double const s = (m - 1.0) / (m + 1.0);
+    double const s2 = s * s;
+    double power = s;
+    double result = 0.0;
+    for (int n = 0; n < 16; ++n)
+    {
+        result += power / static_cast<double>(2 * n + 1);
+        power *= s2;
+    }
+    return 2.0 * result + static_cast<double>(e) * k_Ln2D;
+}
+
+export constexpr float Sin(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        double s, c;
+        ConstexprSinCos(val, s, c);
+        return static_cast<float>(s);
+    }
+    return ::sin(val);
+}
+
+export constexpr float Cos(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        double s, c;
+        ConstexprSinCos(val, s, c);
+        return static_cast<float>(c);
+    }
+    return ::cos(val);
+}
+
+export constexpr float Tan(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        double s, c;
+        ConstexprSinCos(val, s, c);
+        return static_cast<float>(s / c);
+    }
+    return ::tanf(val);
+}
+
+export constexpr float ATan2(float y, float x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<float>(ConstexprATan2(y, x));
+    }
+    return ::atan2f(y, x);
+}
+
+export constexpr float ASin(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        double const v = val;
+        return static_cast<float>(ConstexprATan2(v, ConstexprSqrt(1.0 - v * v)));
+    }
+    return ::asin(val);
+}
+
+export constexpr float ACos(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        double const v = val;
+        return static_cast<float>(ConstexprATan2(ConstexprSqrt(1.0 - v * v), v));
+    }
+    return ::acos(val);
+}
+
+export constexpr void SinCos(float val, float &sinOut, float &cosOut)
+{
+    sinOut = Sin(val);
+    cosOut = Cos(val);
+}
+
+export constexpr void ASinACos(float val, float &asinOut, float &acosOut)
+{
+    asinOut = ASin(val);
+    acosOut = ACos(val);
+}
+
+export constexpr float Exp(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<float>(ConstexprExp(val));
+    }
+    return ::expf(val);
+}
+
+export constexpr float Log(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<float>(ConstexprLog(val));
+    }
+    return ::logf(val);
+}
+
+export constexpr float Pow(float val, int power)
+{
+    if (std::is_constant_evaluated())
+    {
+        // Exponentiation by squaring.
+        double base = power < 0 ? 1.0 / static_cast<double>(val) : static_cast<double>(val);
+        unsigned remaining = static_cast<unsigned>(power < 0 ? -power : power);
+        double result = 1.0;
+        for (; remaining != 0; remaining >>= 1)
+        {
+            if (remaining & 1)
+            {
+                result *= base;
+            }
+            base *= base;
+        }
+        return static_cast<float>(result);
+    }
+    return ::powf(val, static_cast<float>(power));
+}
+
+export constexpr float Pow(float val, float power)
+{
+    if (std::is_constant_evaluated())
+    {
+        if (power == 0.0f)
+        {
+            return 1.0f;
+        }
+        return static_cast<float>(ConstexprExp(static_cast<double>(power) * ConstexprLog(val)));
+    }
+    return ::powf(val, power);
+}
+
+export constexpr float Sqrt(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        return static_cast<float>(ConstexprSqrt(val));
+    }
+    return ::sqrtf(val);
+}
+
+export constexpr float RSqrt(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        double const root = ConstexprSqrt(val);
+        return root == 0.0 ? static_cast<float>(Infinity()) : static_cast<float>(1.0 / root);
+    }
+    return 1.0f / ::sqrtf(val);
+}
 
 // See: http://realtimecollisiondetection.net/blog/?p=89
 // Example accuracy:
@@ -83,4 +440,444 @@ export float WrapMinMax(float val, float minVal, float maxVal)
         return maxVal - fmod(Abs(val), maxVal) + minVal;
     }
 }
-}
\ No newline at end of file
+
+//////////////////////////////////////////////////////////////////////////
+// Approximations
+//
+// Polynomial versions of the functions above that trade accuracy for speed, in three tiers.
+// Each function has a scalar, a SIMD::Float4 and a span overload; at runtime all three give bit
+// identical results for the same input. The functions above without a Precision are the C runtime
+// ones.
+//
+// Max error measured against double precision over the documented range:
+//
+//              Fast                Medium              Precise
+//   SinCos     3e-4 abs            1.2e-6 abs          8.5e-8 abs
+//   ATan2      1.3e-3 rad          3.6e-6 rad          2 ulp
+//   Exp        7.5e-5 rel          2.7e-6 rel          1 ulp
+//   Log        1.2e-5 abs          4 ulp               3 ulp
+//   RSqrt      3.3e-4 rel          4 ulp               1 ulp
+//   Pow        ~ error of Exp + |power * log(x)| * error of Log
+//
+// SinCos: valid for |x| < 8192, except Fast which reduces the angle with a single constant and is
+// only accurate for |x| < 100.
+// ATan2: doesn't tell -0 from +0 for x, so ATan2(+-0, -0) is +-0 instead of +-Pi.
+// Exp: results below 2^-125 flush to zero, above FLT_MAX become infinity.
+// Log: 0 and denormals give -infinity, negative values NaN.
+// Pow: only defined for val >= 0. Use Pow(float, int) for integer powers of negative numbers.
+// RSqrt: Fast is the hardware estimate, the figure above is for SSE.
+
+export enum class Precision
+{
+    Fast,
+    Medium,
+    Precise
+};
+
+// Horner's scheme: c[0] + x * (c[1] + x * (c[2] + ...))
+template <usz N> SIMD::Float4 Polynomial(SIMD::Float4 x, float const (&c)[N])
+{
+    SIMD::Float4 result = SIMD::Splat(c[N - 1]);
+    for (usz i = N - 1; i > 0; --i)
+    {
+        result = SIMD::MulAdd(result, x, SIMD::Splat(c[i - 1]));
+    }
+    return result;
+}
+
+// Minimax polynomials (relative error) for each tier. Each is the highest degree worth using at
+// that tier's error.
+
+// sin(r) = r * S(r^2) for |r| <= Pi/4
+constexpr float k_SinFast[] = {0.9995916f, -0.1615351f};
+constexpr float k_SinMedium[] = {0.9999985f, -0.16662382f, 0.008150057f};
+constexpr float k_SinPrecise[] = {1.0f, -0.16666651f, 0.008332017f, -0.00019501822f};
+
+// cos(r) = C(r^2) for |r| <= Pi/4
+constexpr float k_CosFast[] = {0.9999882f, -0.4996855f, 0.040362295f};
+constexpr float k_CosMedium[] = {0.99999994f, -0.49999842f, 0.04165442f, -0.0013579404f};
+constexpr float k_CosPrecise[] = {1.0f, -0.5f, 0.041666612f, -0.001388653f, 2.4372679e-05f};
+
+// atan(a) = a * A(a^2) for 0 <= a <= 1
+constexpr float k_ATanFast[] = {0.9984241f, -0.30103868f, 0.08925048f};
+constexpr float k_ATanMedium[] = {0.99999565f, -0.3329946f,  0.19563593f,
+                                  -0.121239066f, 0.05747731f, -0.013480468f};
+constexpr float k_ATanPrecise[] = {1.0f,         -0.33333072f, 0.1999262f,
+                                   -0.14203644f, 0.106409326f, -0.07504292f,
+                                   0.04269149f,  -0.016068615f, 0.002849887f};
+
+// exp(r) = E(r) for |r| <= ln(2) / 2
+constexpr float k_ExpFast[] = {0.99992806f, 1.0001642f, 0.5049633f, 0.16566843f};
+constexpr float k_ExpMedium[] = {0.9999993f, 0.9999634f, 0.5000436f, 0.16790907f, 0.041458607f};
+constexpr float k_ExpPrecise[] = {1.0f,       1.0f,         0.4999999f,  0.1666642f,
+                                  0.041668225f, 0.008374816f, 0.0013836846f};
+
+// log(m) = 2s * L(s^2) where s = (m - 1) / (m + 1) for sqrt(0.5) <= m <= sqrt(2)
+constexpr float k_LogFast[] = {0.99997777f, 0.33933994f};
+constexpr float k_LogMedium[] = {1.0000001f, 0.33326113f, 0.20648186f};
+constexpr float k_LogPrecise[] = {1.0f, 0.3333341f, 0.19987397f, 0.14962825f};
+
+// Pi / 2 split so the first parts multiplied by a quadrant number are exact.
+constexpr float k_HalfPi1 = 1.5703125f;
+constexpr float k_HalfPi2 = 4.837512969970703125e-4f;
+constexpr float k_HalfPi3 = 7.54978995489188216e-8f;
+constexpr float k_TwoOverPi = 0.636619772367581343f;
+
+// ln(2) split the same way.
+constexpr float k_Ln2Hi = 0.693359375f;
+constexpr float k_Ln2Lo = -2.12194440e-4f;
+constexpr float k_Log2e = 1.44269504088896341f;
+
+// exp(x) overflows above this, and flushes to zero below the minimum.
+constexpr float k_ExpMax = 88.7228394f;
+constexpr float k_ExpMin = -86.6433983f;
+
+export template <Precision P>
+void SinCos(SIMD::Float4 angle, SIMD::Float4 &sinOut, SIMD::Float4 &cosOut)
+{
+    using namespace SIMD;
+
+    // angle = quadrant * Pi/2 + r
+    Float4 const quadrant = Round(Mul(angle, Splat(k_TwoOverPi)));
+    Float4 r;
+    if constexpr (P == Precision::Fast)
+    {
+        r = MulAdd(quadrant, Splat(-HalfPi), angle);
+    }
+    else
+    {
+        r = MulAdd(quadrant, Splat(-k_HalfPi1), angle);
+        r = MulAdd(quadrant, Splat(-k_HalfPi2), r);
+        r = MulAdd(quadrant, Splat(-k_HalfPi3), r);
+    }
+    Float4 const r2 = Mul(r, r);
+
+    Float4 s, c;
+    if constexpr (P == Precision::Fast)
+    {
+        s = Mul(r, Polynomial(r2, k_SinFast));
+        c = Polynomial(r2, k_CosFast);
+    }
+    else if constexpr (P == Precision::Medium)
+    {
+        s = Mul(r, Polynomial(r2, k_SinMedium));
+        c = Polynomial(r2, k_CosMedium);
+    }
+    else
+    {
+        s = Mul(r, Polynomial(r2, k_SinPrecise));
+        c = Polynomial(r2, k_CosPrecise);
+    }
+
+    // Odd quadrants swap sin and cos. sin is negated in quadrants 2 and 3, cos in 1 and 2.
+    Int4 const q = ToInt(quadrant);
+    Float4 const swap = AsFloat(Equal(And(q, SplatInt(1)), SplatInt(1)));
+    Float4 const sinSign = AsFloat(ShiftLeft<30>(And(q, SplatInt(2))));
+    Float4 const cosSign = AsFloat(ShiftLeft<30>(And(Add(q, SplatInt(1)), SplatInt(2))));
+    sinOut = Xor(Select(swap, c, s), sinSign);
+    cosOut = Xor(Select(swap, s, c), cosSign);
+}
+
+export template <Precision P> SIMD::Float4 ATan2(SIMD::Float4 y, SIMD::Float4 x)
+{
+    using namespace SIMD;
+
+    Float4 const absX = Abs(x);
+    Float4 const absY = Abs(y);
+    Float4 const maxXY = Max(absX, absY);
+    // 0/0 when both are zero: the ratio is forced to 0 instead.
+    Float4 const a = Select(Equal(maxXY, Zero()), Zero(), Div(Min(absX, absY), maxXY));
+    Float4 const a2 = Mul(a, a);
+
+    Float4 result;
+    if constexpr (P == Precision::Fast)
+    {
+        result = Mul(a, Polynomial(a2, k_ATanFast));
+    }
+    else if constexpr (P == Precision::Medium)
+    {
+        result = Mul(a, Polynomial(a2, k_ATanMedium));
+    }
+    else
+    {
+        result = Mul(a, Polynomial(a2, k_ATanPrecise));
+    }
+
+    // Unfold from the first octant.
+    result = Select(Greater(absY, absX), Sub(Splat(HalfPi), result), result);
+    result = Select(Less(x, Zero()), Sub(Splat(Pi), result), result);
+    return FlipSign(result, y);
+}
+
+export template <Precision P> SIMD::Float4 Exp(SIMD::Float4 val)
+{
+    using namespace SIMD;
+
+    // val = n * ln(2) + r, exp(val) = 2^n * exp(r)
+    Float4 const x = Max(Min(val, Splat(k_ExpMax)), Splat(k_ExpMin));
+    Float4 const n = Round(Mul(x, Splat(k_Log2e)));
+    Float4 r = MulAdd(n, Splat(-k_Ln2Hi), x);
+    r = MulAdd(n, Splat(-k_Ln2Lo), r);
+
+    Float4 e;
+    if constexpr (P == Precision::Fast)
+    {
+        e = Polynomial(r, k_ExpFast);
+    }
+    else if constexpr (P == Precision::Medium)
+    {
+        e = Polynomial(r, k_ExpMedium);
+    }
+    else
+    {
+        e = Polynomial(r, k_ExpPrecise);
+    }
+
+    // 2^(n - 1) built from its exponent bits, times 2 so n = 128 doesn't overflow the exponent.
+    Float4 const scale = AsFloat(ShiftLeft<23>(Add(ToInt(n), SplatInt(126))));
+    Float4 result = Mul(Add(e, e), scale);
+    result = Select(Greater(val, Splat(k_ExpMax)), Splat(std::numeric_limits<float>::infinity()),
+                    result);
+    result = Select(Less(val, Splat(k_ExpMin)), Zero(), result);
+    // NaN stays NaN.
+    return Select(Equal(val, val), result, val);
+}
+
+export template <Precision P> SIMD::Float4 Log(SIMD::Float4 val)
+{
+    using namespace SIMD;
+
+    // val = m * 2^e with m in [1, 2), then moved to [sqrt(0.5), sqrt(2)) so log(m) is small.
+    Int4 const bits = AsInt(val);
+    Float4 exponent = ToFloat(Sub(ShiftRight<23>(bits), SplatInt(127)));
+    Float4 m = AsFloat(Add(And(bits, SplatInt(0x007FFFFF)), SplatInt(0x3F800000)));
+    Float4 const isLarge = Greater(m, Splat(1.41421356f));
+    m = Select(isLarge, Mul(m, Splat(0.5f)), m);
+    exponent = Select(isLarge, Add(exponent, Splat(1.0f)), exponent);
+
+    Float4 const s = Div(Sub(m, Splat(1.0f)), Add(m, Splat(1.0f)));
+    Float4 const s2 = Mul(s, s);
+    Float4 l;
+    if constexpr (P == Precision::Fast)
+    {
+        l = Polynomial(s2, k_LogFast);
+    }
+    else if constexpr (P == Precision::Medium)
+    {
+        l = Polynomial(s2, k_LogMedium);
+    }
+    else
+    {
+        l = Polynomial(s2, k_LogPrecise);
+    }
+    Float4 const logM = Mul(Add(s, s), l);
+    Float4 result = MulAdd(exponent, Splat(k_Ln2Hi), MulAdd(exponent, Splat(k_Ln2Lo), logM));
+
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    result = Select(Less(val, Splat(std::numeric_limits<float>::min())), Splat(-infinity), result);
+    result = Select(Equal(val, Splat(infinity)), val, result);
+    result = Select(Less(val, Zero()), Splat(std::numeric_limits<float>::quiet_NaN()), result);
+    // NaN stays NaN.
+    return Select(Equal(val, val), result, val);
+}
+
+export template <Precision P> SIMD::Float4 RSqrt(SIMD::Float4 val)
+{
+    using namespace SIMD;
+
+    Float4 const exact = Div(Splat(1.0f), Sqrt(val));
+    if constexpr (P == Precision::Precise)
+    {
+        return exact;
+    }
+    else
+    {
+        Float4 result = RSqrtEstimate(val);
+        if constexpr (P == Precision::Medium)
+        {
+            // One Newton-Raphson step: y * (1.5 - 0.5 * val * y * y)
+            Float4 const halfValY = Mul(Mul(Splat(0.5f), val), result);
+            result = Mul(result, MulAdd(Mul(halfValY, result), Splat(-1.0f), Splat(1.5f)));
+        }
+        // The refinement turns the estimate for 0 and infinity into NaN.
+        Float4 const isSpecial =
+            Or(Equal(val, Zero()), Equal(val, Splat(std::numeric_limits<float>::infinity())));
+        return Select(isSpecial, exact, result);
+    }
+}
+
+export template <Precision P> SIMD::Float4 Pow(SIMD::Float4 val, SIMD::Float4 power)
+{
+    using namespace SIMD;
+
+    Float4 const result = Exp<P>(Mul(power, Log<P>(val)));
+    // x^0 is 1 for every x, including the 0 * -inf = NaN case above.
+    return Select(Equal(power, Zero()), Splat(1.0f), result);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Scalar approximations: the SIMD versions run on one lane. Constant evaluation uses the compile
+// time fallbacks, as the functions without a Precision do.
+
+export template <Precision P> constexpr void SinCos(float angle, float &sinOut, float &cosOut)
+{
+    if (std::is_constant_evaluated())
+    {
+        SinCos(angle, sinOut, cosOut);
+        return;
+    }
+    SIMD::Float4 s, c;
+    SinCos<P>(SIMD::Splat(angle), s, c);
+    sinOut = SIMD::GetX(s);
+    cosOut = SIMD::GetX(c);
+}
+
+export template <Precision P> constexpr float ATan2(float y, float x)
+{
+    if (std::is_constant_evaluated())
+    {
+        return ATan2(y, x);
+    }
+    return SIMD::GetX(ATan2<P>(SIMD::Splat(y), SIMD::Splat(x)));
+}
+
+export template <Precision P> constexpr float Exp(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        return Exp(val);
+    }
+    return SIMD::GetX(Exp<P>(SIMD::Splat(val)));
+}
+
+export template <Precision P> constexpr float Log(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        return Log(val);
+    }
+    return SIMD::GetX(Log<P>(SIMD::Splat(val)));
+}
+
+export template <Precision P> constexpr float RSqrt(float val)
+{
+    if (std::is_constant_evaluated())
+    {
+        return RSqrt(val);
+    }
+    return SIMD::GetX(RSqrt<P>(SIMD::Splat(val)));
+}
+
+export template <Precision P> constexpr float Pow(float val, float power)
+{
+    if (std::is_constant_evaluated())
+    {
+        return Pow(val, power);
+    }
+    return SIMD::GetX(Pow<P>(SIMD::Splat(val), SIMD::Splat(power)));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Span approximations: out[n] = F(in[n]). Outputs may be the inputs but must not partially
+// overlap them.
+
+// Runs op over whole registers, then once more over a zero padded register for the tail.
+template <usz Inputs, usz Outputs, typename Op>
+void ForEachFloat4(std::span<float const> const (&in)[Inputs],
+                   std::span<float> const (&out)[Outputs], Op op)
+{
+    usz const count = in[0].size();
+    for (auto const &input : in)
+    {
+        LAT_ASSERT(input.size() == count);
+    }
+    for (auto const &output : out)
+    {
+        LAT_ASSERT(output.size() >= count);
+    }
+
+    SIMD::Float4 args[Inputs];
+    SIMD::Float4 results[Outputs];
+    usz i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        for (usz a = 0; a < Inputs; ++a)
+        {
+            args[a] = SIMD::LoadUnaligned(in[a].data() + i);
+        }
+        op(args, results);
+        for (usz r = 0; r < Outputs; ++r)
+        {
+            SIMD::StoreUnaligned(out[r].data() + i, results[r]);
+        }
+    }
+    if (i < count)
+    {
+        usz const remaining = count - i;
+        alignas(16) float lanes[4] = {};
+        for (usz a = 0; a < Inputs; ++a)
+        {
+            for (usz l = 0; l < remaining; ++l)
+            {
+                lanes[l] = in[a][i + l];
+            }
+            args[a] = SIMD::Load(lanes);
+        }
+        op(args, results);
+        for (usz r = 0; r < Outputs; ++r)
+        {
+            SIMD::Store(lanes, results[r]);
+            for (usz l = 0; l < remaining; ++l)
+            {
+                out[r][i + l] = lanes[l];
+            }
+        }
+    }
+}
+
+export template <Precision P>
+void SinCos(std::span<float const> angles, std::span<float> sinOut, std::span<float> cosOut)
+{
+    ForEachFloat4<1, 2>({angles}, {sinOut, cosOut},
+                        [](SIMD::Float4 const *args, SIMD::Float4 *results) {
+                            SinCos<P>(args[0], results[0], results[1]);
+                        });
+}
+
+export template <Precision P>
+void ATan2(std::span<float const> y, std::span<float const> x, std::span<float> out)
+{
+    ForEachFloat4<2, 1>({y, x}, {out}, [](SIMD::Float4 const *args, SIMD::Float4 *results) {
+        results[0] = ATan2<P>(args[0], args[1]);
+    });
+}
+
+export template <Precision P> void Exp(std::span<float const> in, std::span<float> out)
+{
+    ForEachFloat4<1, 1>({in}, {out}, [](SIMD::Float4 const *args, SIMD::Float4 *results) {
+        results[0] = Exp<P>(args[0]);
+    });
+}
+
+export template <Precision P> void Log(std::span<float const> in, std::span<float> out)
+{
+    ForEachFloat4<1, 1>({in}, {out}, [](SIMD::Float4 const *args, SIMD::Float4 *results) {
+        results[0] = Log<P>(args[0]);
+    });
+}
+
+export template <Precision P> void RSqrt(std::span<float const> in, std::span<float> out)
+{
+    ForEachFloat4<1, 1>({in}, {out}, [](SIMD::Float4 const *args, SIMD::Float4 *results) {
+        results[0] = RSqrt<P>(args[0]);
+    });
+}
+
+export template <Precision P>
+void Pow(std::span<float const> val, std::span<float const> power, std::span<float> out)
+{
+    ForEachFloat4<2, 1>({val, power}, {out}, [](SIMD::Float4 const *args, SIMD::Float4 *results) {
+        results[0] = Pow<P>(args[0], args[1]);
+    });
+}
+} // namespace Lateralus::Core
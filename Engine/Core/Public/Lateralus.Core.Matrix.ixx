@@ -1,11 +1,20 @@
 module;
 
+#include <Core.Assert.h>
+#include <Core.SIMD.h>
 #include <cmath>
 
 export module Lateralus.Core.Matrix;
 
+import <span>;
+import <type_traits>;
+
+import Lateralus.Core;
+import Lateralus.Core.Dispatch;
 import Lateralus.Core.Vector;
 import Lateralus.Core.Math;
+import Lateralus.Core.SIMD;
+import Lateralus.Core.SIMDSupport;
 
 namespace Lateralus::Core
 {
@@ -13,99 +22,101 @@ export struct Matrix4x4
 {
     Vector4 r0, r1, r2, r3;
 
-    Matrix4x4()
+    constexpr Matrix4x4()
         : r0(1.0f, 0.0f, 0.0f, 0.0f), r1(0.0f, 1.0f, 0.0f, 0.0f), r2(0.0f, 0.0f, 1.0f, 0.0f),
           r3(0.0f, 0.0f, 0.0f, 1.0f)
     {
     }
 
-    Matrix4x4(float m00, float m01, float m02, float m03, float m10, float m11, float m12,
-              float m13, float m20, float m21, float m22, float m23, float m30, float m31,
-              float m32, float m33)
+    constexpr Matrix4x4(float m00, float m01, float m02, float m03, float m10, float m11,
+                        float m12, float m13, float m20, float m21, float m22, float m23,
+                        float m30, float m31, float m32, float m33)
         : r0(m00, m01, m02, m03), r1(m10, m11, m12, m13), r2(m20, m21, m22, m23),
           r3(m30, m31, m32, m33)
     {
     }
 
-    Matrix4x4 operator*(const Matrix4x4 &other) const
+    constexpr Matrix4x4 operator*(const Matrix4x4 &other) const
     {
-        Matrix4x4 result;
-
-        result.r0.x = r0.x * other.r0.x + r0.y * other.r1.x + r0.z * other.r2.x + r0.w * other.r3.x;
-        result.r0.y = r0.x * other.r0.y + r0.y * other.r1.y + r0.z * other.r2.y + r0.w * other.r3.y;
-        result.r0.z = r0.x * other.r0.z + r0.y * other.r1.z + r0.z * other.r2.z + r0.w * other.r3.z;
-        result.r0.w = r0.x * other.r0.w + r0.y * other.r1.w + r0.z * other.r2.w + r0.w * other.r3.w;
-
-        result.r1.x = r1.x * other.r0.x + r1.y * other.r1.x + r1.z * other.r2.x + r1.w * other.r3.x;
-        result.r1.y = r1.x * other.r0.y + r1.y * other.r1.y + r1.z * other.r2.y + r1.w * other.r3.y;
-        result.r1.z = r1.x * other.r0.z + r1.y * other.r1.z + r1.z * other.r2.z + r1.w * other.r3.z;
-        result.r1.w = r1.x * other.r0.w + r1.y * other.r1.w + r1.z * other.r2.w + r1.w * other.r3.w;
-
-        result.r2.x = r2.x * other.r0.x + r2.y * other.r1.x + r2.z * other.r2.x + r2.w * other.r3.x;
-        result.r2.y = r2.x * other.r0.y + r2.y * other.r1.y + r2.z * other.r2.y + r2.w * other.r3.y;
-        result.r2.z = r2.x * other.r0.z + r2.y * other.r1.z + r2.z * other.r2.z + r2.w * other.r3.z;
-        result.r2.w = r2.x * other.r0.w + r2.y * other.r1.w + r2.z * other.r2.w + r2.w * other.r3.w;
+        if (std::is_constant_evaluated())
+        {
+            Matrix4x4 result;
+            result.r0 = CombineRows(r0, other);
+            result.r1 = CombineRows(r1, other);
+            result.r2 = CombineRows(r2, other);
+            result.r3 = CombineRows(r3, other);
+            return result;
+        }
 
-        result.r3.x = r3.x * other.r0.x + r3.y * other.r1.x + r3.z * other.r2.x + r3.w * other.r3.x;
-        result.r3.y = r3.x * other.r0.y + r3.y * other.r1.y + r3.z * other.r2.y + r3.w * other.r3.y;
-        result.r3.z = r3.x * other.r0.z + r3.y * other.r1.z + r3.z * other.r2.z + r3.w * other.r3.z;
-        result.r3.w = r3.x * other.r0.w + r3.y * other.r1.w + r3.z * other.r2.w + r3.w * other.r3.w;
+        // Each result row is a linear combination of other's rows weighted by this row's
+        // components, so every row is 4 broadcasts and 4 multiply-adds.
+        SIMD::Float4 const b0 = other.r0.ToSIMD();
+        SIMD::Float4 const b1 = other.r1.ToSIMD();
+        SIMD::Float4 const b2 = other.r2.ToSIMD();
+        SIMD::Float4 const b3 = other.r3.ToSIMD();
 
+        Matrix4x4 result;
+        result.r0 = Vector4::FromSIMD(CombineRows(r0, b0, b1, b2, b3));
+        result.r1 = Vector4::FromSIMD(CombineRows(r1, b0, b1, b2, b3));
+        result.r2 = Vector4::FromSIMD(CombineRows(r2, b0, b1, b2, b3));
+        result.r3 = Vector4::FromSIMD(CombineRows(r3, b0, b1, b2, b3));
         return result;
     }
 
-    Vector4 operator*(const Vector4 &vector) const
+    constexpr Vector4 operator*(const Vector4 &vector) const
     {
-        Vector4 result;
+        if (std::is_constant_evaluated())
+        {
+            return Vector4(r0.Dot(vector), r1.Dot(vector), r2.Dot(vector), r3.Dot(vector));
+        }
 
-        result.x = r0.Dot(vector);
-        result.y = r1.Dot(vector);
-        result.z = r2.Dot(vector);
-        result.w = r3.Dot(vector);
+        // Multiply every row by the vector, transpose so the products for each row share a lane,
+        // then a vertical add leaves all four dot products in one register.
+        SIMD::Float4 const v = vector.ToSIMD();
+        SIMD::Float4 p0 = SIMD::Mul(r0.ToSIMD(), v);
+        SIMD::Float4 p1 = SIMD::Mul(r1.ToSIMD(), v);
+        SIMD::Float4 p2 = SIMD::Mul(r2.ToSIMD(), v);
+        SIMD::Float4 p3 = SIMD::Mul(r3.ToSIMD(), v);
+        SIMD::Transpose(p0, p1, p2, p3);
 
-        return result;
+        return Vector4::FromSIMD(SIMD::Add(SIMD::Add(p0, p1), SIMD::Add(p2, p3)));
     }
 
-    bool RoughlyEquals(const Matrix4x4 &other) const
+    constexpr bool RoughlyEquals(const Matrix4x4 &other) const
     {
         return r0.RoughlyEquals(other.r0) && r1.RoughlyEquals(other.r1) &&
                r2.RoughlyEquals(other.r2) && r3.RoughlyEquals(other.r3);
     }
 
-    bool ExactlyEquals(const Matrix4x4 &other) const
+    constexpr bool ExactlyEquals(const Matrix4x4 &other) const
     {
         return r0.ExactlyEquals(other.r0) && r1.ExactlyEquals(other.r1) &&
                r2.ExactlyEquals(other.r2) && r3.ExactlyEquals(other.r3);
     }
 
-    Matrix4x4 Transpose() const
+    constexpr Matrix4x4 Transpose() const
     {
-        Matrix4x4 result;
-
-        result.r0.x = r0.x;
-        result.r0.y = r1.x;
-        result.r0.z = r2.x;
-        result.r0.w = r3.x;
-
-        result.r1.x = r0.y;
-        result.r1.y = r1.y;
-        result.r1.z = r2.y;
-        result.r1.w = r3.y;
-
-        result.r2.x = r0.z;
-        result.r2.y = r1.z;
-        result.r2.z = r2.z;
-        result.r2.w = r3.z;
+        if (std::is_constant_evaluated())
+        {
+            return Matrix4x4(r0.x, r1.x, r2.x, r3.x, r0.y, r1.y, r2.y, r3.y, r0.z, r1.z, r2.z, r3.z,
+                             r0.w, r1.w, r2.w, r3.w);
+        }
 
-        result.r3.x = r0.w;
-        result.r3.y = r1.w;
-        result.r3.z = r2.w;
-        result.r3.w = r3.w;
+        SIMD::Float4 c0 = r0.ToSIMD();
+        SIMD::Float4 c1 = r1.ToSIMD();
+        SIMD::Float4 c2 = r2.ToSIMD();
+        SIMD::Float4 c3 = r3.ToSIMD();
+        SIMD::Transpose(c0, c1, c2, c3);
 
+        Matrix4x4 result;
+        result.r0 = Vector4::FromSIMD(c0);
+        result.r1 = Vector4::FromSIMD(c1);
+        result.r2 = Vector4::FromSIMD(c2);
+        result.r3 = Vector4::FromSIMD(c3);
         return result;
     }
 
-    Matrix4x4 Inverse() const
+    constexpr Matrix4x4 Inverse() const
     {
         Matrix4x4 result;
 
@@ -176,7 +187,7 @@ export struct Matrix4x4
     }
 
 
-    static Matrix4x4 Identity()
+    static constexpr Matrix4x4 Identity()
     {
         return Matrix4x4(1.0f, 0.0f, 0.0f, 0.0f,
                          0.0f, 1.0f, 0.0f, 0.0f,
@@ -185,18 +196,17 @@ export struct Matrix4x4
     }
 
 
-    static Matrix4x4 CreateTranslation(const Vector3 &translation)
+    static constexpr Matrix4x4 CreateTranslation(const Vector3 &translation)
     {
         return Matrix4x4(1.0f, 0.0f, 0.0f, translation.x, 0.0f, 1.0f, 0.0f, translation.y, 0.0f,
                          0.0f, 1.0f, translation.z, 0.0f, 0.0f, 0.0f, 1.0f);
     }
 
 
-    static Matrix4x4 CreateRotation(const Vector3 &axis, float angle)
+    static constexpr Matrix4x4 CreateRotation(const Vector3 &axis, float angle)
     {
-        float radAngle = angle * Deg2Rad;
-        float cosAngle = std::cos(radAngle);
-        float sinAngle = std::sin(radAngle);
+        float sinAngle, cosAngle;
+        SinCos<Precision::Precise>(angle * Deg2Rad, sinAngle, cosAngle);
         float oneMinusCos = 1.0f - cosAngle;
 
         float x = axis.x;
@@ -213,18 +223,26 @@ export struct Matrix4x4
         return result;
     }
 
-    static Matrix4x4 CreateRotation(const Vector3 &rotation)
+    static constexpr Matrix4x4 CreateRotation(const Vector3 &rotation)
     {
-        float radX = rotation.x * Deg2Rad;
-        float radY = rotation.y * Deg2Rad;
-        float radZ = rotation.z * Deg2Rad;
-
-        float cosX = std::cos(radX);
-        float sinX = std::sin(radX);
-        float cosY = std::cos(radY);
-        float sinY = std::sin(radY);
-        float cosZ = std::cos(radZ);
-        float sinZ = std::sin(radZ);
+        float sin[4] = {}, cos[4] = {};
+        if (std::is_constant_evaluated())
+        {
+            SinCos(rotation.x * Deg2Rad, sin[0], cos[0]);
+            SinCos(rotation.y * Deg2Rad, sin[1], cos[1]);
+            SinCos(rotation.z * Deg2Rad, sin[2], cos[2]);
+        }
+        else
+        {
+            // All three angles in one go.
+            SIMD::Float4 sines, cosines;
+            SIMD::Float4 const angles = SIMD::Set(rotation.x, rotation.y, rotation.z, 0.0f);
+            SinCos<Precision::Precise>(SIMD::Mul(angles, SIMD::Splat(Deg2Rad)), sines, cosines);
+            SIMD::StoreUnaligned(sin, sines);
+            SIMD::StoreUnaligned(cos, cosines);
+        }
+        float const sinX = sin[0], sinY = sin[1], sinZ = sin[2];
+        float const cosX = cos[0], cosY = cos[1], cosZ = cos[2];
 
         Matrix4x4 result(cosY * cosZ, -cosX * sinZ + sinX * sinY * cosZ,
                          sinX * sinZ + cosX * sinY * cosZ, 0.0f, cosY * sinZ,
@@ -235,7 +253,7 @@ export struct Matrix4x4
     }
 
 
-    static Matrix4x4 CreateScale(const Vector3 &scale)
+    static constexpr Matrix4x4 CreateScale(const Vector3 &scale)
     {
         return Matrix4x4(scale.x, 0.0f, 0.0f, 0.0f, 0.0f, scale.y, 0.0f, 0.0f, 0.0f, 0.0f, scale.z,
                          0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
@@ -243,8 +261,8 @@ export struct Matrix4x4
 
 
 
-    static Matrix4x4 CreateOrthographicProjection(float left, float right, float bottom,
-                                                      float top, float near, float far)
+    static constexpr Matrix4x4 CreateOrthographicProjection(float left, float right, float bottom,
+                                                            float top, float near, float far)
     {
         float width = right - left;
         float height = top - bottom;
@@ -260,10 +278,10 @@ export struct Matrix4x4
     }
 
 
-    static Matrix4x4 CreatePerspectiveProjection(float fov, float aspectRatio, float near,
-                                                     float far)
+    static constexpr Matrix4x4 CreatePerspectiveProjection(float fov, float aspectRatio,
+                                                           float near, float far)
     {
-        float tanHalfFov = std::tan(0.5f * fov * Deg2Rad);
+        float tanHalfFov = Tan(0.5f * fov * Deg2Rad);
         float zRange = far - near;
 
         Matrix4x4 result(1.0f / (aspectRatio * tanHalfFov), 0.0f, 0.0f, 0.0f, 0.0f,
@@ -274,7 +292,8 @@ export struct Matrix4x4
     }
 
 
-static Matrix4x4 CreateLookAt(const Vector3 &eye, const Vector3 &target, const Vector3 &up)
+static constexpr Matrix4x4 CreateLookAt(const Vector3 &eye, const Vector3 &target,
+                                        const Vector3 &up)
 {
     Vector3 forward = (target - eye).Normalized();
     Vector3 right = forward.Cross(up).Normalized(); // Calculate right vector using cross product
@@ -291,7 +310,7 @@ static Matrix4x4 CreateLookAt(const Vector3 &eye, const Vector3 &target, const V
 
 
 
-    float Determinant() const
+    constexpr float Determinant() const
     {
         // Calculate the determinant using the expansion by minors formula
         float det =
@@ -306,5 +325,657 @@ static Matrix4x4 CreateLookAt(const Vector3 &eye, const Vector3 &target, const V
 
         return det;
     }
+
+private:
+    // row.x * b0 + row.y * b1 + row.z * b2 + row.w * b3
+    static SIMD::Float4 CombineRows(Vector4 const &row, SIMD::Float4 b0, SIMD::Float4 b1,
+                                    SIMD::Float4 b2, SIMD::Float4 b3)
+    {
+        SIMD::Float4 result = SIMD::Mul(SIMD::Splat(row.x), b0);
+        result = SIMD::MulAdd(SIMD::Splat(row.y), b1, result);
+        result = SIMD::MulAdd(SIMD::Splat(row.z), b2, result);
+        result = SIMD::MulAdd(SIMD::Splat(row.w), b3, result);
+        return result;
+    }
+
+    // CombineRows for constant evaluation.
+    static constexpr Vector4 CombineRows(Vector4 const &row, Matrix4x4 const &b)
+    {
+        Vector4 const x(row.x, row.x, row.x, row.x);
+        Vector4 const y(row.y, row.y, row.y, row.y);
+        Vector4 const z(row.z, row.z, row.z, row.z);
+        Vector4 const w(row.w, row.w, row.w, row.w);
+        return x * b.r0 + y * b.r1 + z * b.r2 + w * b.r3;
+    }
+};
+
+// An affine transform: the top three rows of a Matrix4x4 whose bottom row is (0, 0, 0, 1).
+// Same conventions as Matrix4x4 (column vectors, translation in w), in 12 floats instead of 16.
+// Composing and inverting skip the constant row, so prefer it for object transforms.
+export struct Matrix3x4
+{
+    Vector4 r0, r1, r2;
+
+    constexpr Matrix3x4()
+        : r0(1.0f, 0.0f, 0.0f, 0.0f), r1(0.0f, 1.0f, 0.0f, 0.0f), r2(0.0f, 0.0f, 1.0f, 0.0f)
+    {
+    }
+
+    constexpr Matrix3x4(float m00, float m01, float m02, float m03, float m10, float m11,
+                        float m12, float m13, float m20, float m21, float m22, float m23)
+        : r0(m00, m01, m02, m03), r1(m10, m11, m12, m13), r2(m20, m21, m22, m23)
+    {
+    }
+
+    // Drops the bottom row, which must be (0, 0, 0, 1).
+    constexpr explicit Matrix3x4(Matrix4x4 const &m) : r0(m.r0), r1(m.r1), r2(m.r2)
+    {
+        LAT_ASSERT(m.r3.RoughlyEquals(Vector4(0.0f, 0.0f, 0.0f, 1.0f)));
+    }
+
+    constexpr Matrix4x4 ToMatrix4x4() const
+    {
+        Matrix4x4 result;
+        result.r0 = r0;
+        result.r1 = r1;
+        result.r2 = r2;
+        return result;
+    }
+
+    constexpr Matrix3x4 operator*(Matrix3x4 const &other) const
+    {
+        if (std::is_constant_evaluated())
+        {
+            Matrix3x4 result;
+            result.r0 = CombineRows(r0, other);
+            result.r1 = CombineRows(r1, other);
+            result.r2 = CombineRows(r2, other);
+            return result;
+        }
+
+        SIMD::Float4 const b0 = other.r0.ToSIMD();
+        SIMD::Float4 const b1 = other.r1.ToSIMD();
+        SIMD::Float4 const b2 = other.r2.ToSIMD();
+
+        Matrix3x4 result;
+        result.r0 = Vector4::FromSIMD(CombineRows(r0, b0, b1, b2));
+        result.r1 = Vector4::FromSIMD(CombineRows(r1, b0, b1, b2));
+        result.r2 = Vector4::FromSIMD(CombineRows(r2, b0, b1, b2));
+        return result;
+    }
+
+    constexpr Vector4 operator*(Vector4 const &vector) const
+    {
+        if (std::is_constant_evaluated())
+        {
+            return Vector4(r0.Dot(vector), r1.Dot(vector), r2.Dot(vector), vector.w);
+        }
+        SIMD::Float4 const v = vector.ToSIMD();
+        return Vector4(SIMD::Dot(r0.ToSIMD(), v), SIMD::Dot(r1.ToSIMD(), v),
+                       SIMD::Dot(r2.ToSIMD(), v), vector.w);
+    }
+
+    // point as (x, y, z, 1)
+    constexpr Vector3 TransformPoint(Vector3 const &point) const
+    {
+        Vector4 const result = *this * Vector4(point.x, point.y, point.z, 1.0f);
+        return Vector3(result.x, result.y, result.z);
+    }
+
+    // direction as (x, y, z, 0): translation is ignored.
+    constexpr Vector3 TransformVector(Vector3 const &direction) const
+    {
+        Vector4 const result = *this * Vector4(direction.x, direction.y, direction.z, 0.0f);
+        return Vector3(result.x, result.y, result.z);
+    }
+
+    constexpr bool RoughlyEquals(Matrix3x4 const &other) const
+    {
+        return r0.RoughlyEquals(other.r0) && r1.RoughlyEquals(other.r1) &&
+               r2.RoughlyEquals(other.r2);
+    }
+
+    constexpr bool ExactlyEquals(Matrix3x4 const &other) const
+    {
+        return r0.ExactlyEquals(other.r0) && r1.ExactlyEquals(other.r1) &&
+               r2.ExactlyEquals(other.r2);
+    }
+
+    // Determinant of the 3x3 linear part, which is also the determinant of the full 4x4.
+    constexpr float Determinant() const
+    {
+        if (std::is_constant_evaluated())
+        {
+            return Linear(r0).Dot(Linear(r1).Cross(Linear(r2)));
+        }
+        SIMD::Float4 const a = r0.ToSIMD();
+        return SIMD::Dot(Cross(r1.ToSIMD(), r2.ToSIMD()), SIMD::Mul(a, LinearMask()));
+    }
+
+    // Inverse of any invertible affine transform: the 3x3 part is inverted through its adjugate
+    // (three cross products) and the translation is carried through it. A singular matrix is
+    // returned unchanged, like Matrix4x4::Inverse.
+    constexpr Matrix3x4 InverseAffine() const
+    {
+        if (std::is_constant_evaluated())
+        {
+            Vector3 const a = Linear(r0), b = Linear(r1), c = Linear(r2);
+            Vector3 const c0 = b.Cross(c), c1 = c.Cross(a), c2 = a.Cross(b);
+            float const det = a.Dot(c0);
+            if (det == 0.0f)
+            {
+                return *this;
+            }
+            Vector3 const invDet(1.0f / det, 1.0f / det, 1.0f / det);
+            return FromColumns(c0 * invDet, c1 * invDet, c2 * invDet);
+        }
+        SIMD::Float4 const a = r0.ToSIMD();
+        SIMD::Float4 const b = r1.ToSIMD();
+        SIMD::Float4 const c = r2.ToSIMD();
+
+        // The columns of the inverse, before dividing by the determinant.
+        SIMD::Float4 c0 = Cross(b, c);
+        SIMD::Float4 c1 = Cross(c, a);
+        SIMD::Float4 c2 = Cross(a, b);
+
+        float const det = SIMD::Dot(c0, SIMD::Mul(a, LinearMask()));
+        if (det == 0.0f)
+        {
+            return *this;
+        }
+        SIMD::Float4 const invDet = SIMD::Splat(1.0f / det);
+        c0 = SIMD::Mul(c0, invDet);
+        c1 = SIMD::Mul(c1, invDet);
+        c2 = SIMD::Mul(c2, invDet);
+
+        return FromColumns(c0, c1, c2);
+    }
+
+    // Inverse of a transform made of rotation and translation only (orthonormal 3x3 part), where
+    // the 3x3 inverse is just its transpose. Cheaper than InverseAffine, wrong for anything scaled.
+    constexpr Matrix3x4 InverseRigid() const
+    {
+        if (std::is_constant_evaluated())
+        {
+            return FromColumns(Linear(r0), Linear(r1), Linear(r2));
+        }
+        return FromColumns(r0.ToSIMD(), r1.ToSIMD(), r2.ToSIMD());
+    }
+
+    static constexpr Matrix3x4 Identity() { return Matrix3x4(); }
+
+    static constexpr Matrix3x4 CreateTranslation(Vector3 const &translation)
+    {
+        return Matrix3x4(1.0f, 0.0f, 0.0f, translation.x, 0.0f, 1.0f, 0.0f, translation.y, 0.0f,
+                         0.0f, 1.0f, translation.z);
+    }
+
+    static constexpr Matrix3x4 CreateRotation(Vector3 const &axis, float angle)
+    {
+        return Matrix3x4(Matrix4x4::CreateRotation(axis, angle));
+    }
+
+    static constexpr Matrix3x4 CreateRotation(Vector3 const &rotation)
+    {
+        return Matrix3x4(Matrix4x4::CreateRotation(rotation));
+    }
+
+    static constexpr Matrix3x4 CreateScale(Vector3 const &scale)
+    {
+        return Matrix3x4(scale.x, 0.0f, 0.0f, 0.0f, 0.0f, scale.y, 0.0f, 0.0f, 0.0f, 0.0f, scale.z,
+                         0.0f);
+    }
+
+    static constexpr Matrix3x4 CreateLookAt(Vector3 const &eye, Vector3 const &target,
+                                            Vector3 const &up)
+    {
+        return Matrix3x4(Matrix4x4::CreateLookAt(eye, target, up));
+    }
+
+private:
+    // (1, 1, 1, 0): keeps the linear part of a row and drops its translation.
+    static SIMD::Float4 LinearMask() { return SIMD::Set(1.0f, 1.0f, 1.0f, 0.0f); }
+
+    // The w lane of the result is meaningless.
+    static SIMD::Float4 Cross(SIMD::Float4 a, SIMD::Float4 b)
+    {
+        SIMD::Float4 const aYZX = SIMD::Shuffle<1, 2, 0, 3>(a);
+        SIMD::Float4 const bYZX = SIMD::Shuffle<1, 2, 0, 3>(b);
+        SIMD::Float4 const crossZXY = SIMD::Sub(SIMD::Mul(a, bYZX), SIMD::Mul(aYZX, b));
+        return SIMD::Shuffle<1, 2, 0, 3>(crossZXY);
+    }
+
+    // Builds the inverse from the columns c0, c1, c2 of the inverted 3x3 part. Their w lanes are
+    // ignored.
+    Matrix3x4 FromColumns(SIMD::Float4 c0, SIMD::Float4 c1, SIMD::Float4 c2) const
+    {
+        // -(inverse * translation), as a combination of the inverse's columns.
+        SIMD::Float4 translation = SIMD::Mul(SIMD::Splat(r0.w), c0);
+        translation = SIMD::MulAdd(SIMD::Splat(r1.w), c1, translation);
+        translation = SIMD::MulAdd(SIMD::Splat(r2.w), c2, translation);
+        translation = SIMD::Negate(translation);
+
+        // Transposing the columns with the translation as a fourth "column" gives the rows.
+        SIMD::Transpose(c0, c1, c2, translation);
+        Matrix3x4 result;
+        result.r0 = Vector4::FromSIMD(c0);
+        result.r1 = Vector4::FromSIMD(c1);
+        result.r2 = Vector4::FromSIMD(c2);
+        return result;
+    }
+
+    // row.x * b0 + row.y * b1 + row.z * b2 + row.w * (0, 0, 0, 1)
+    static SIMD::Float4 CombineRows(Vector4 const &row, SIMD::Float4 b0, SIMD::Float4 b1,
+                                    SIMD::Float4 b2)
+    {
+        SIMD::Float4 result = SIMD::Mul(SIMD::Splat(row.x), b0);
+        result = SIMD::MulAdd(SIMD::Splat(row.y), b1, result);
+        result = SIMD::MulAdd(SIMD::Splat(row.z), b2, result);
+        return SIMD::Add(result, SIMD::Set(0.0f, 0.0f, 0.0f, row.w));
+    }
+
+    // Constant evaluation versions of the helpers above.
+
+    static constexpr Vector3 Linear(Vector4 const &row) { return Vector3(row.x, row.y, row.z); }
+
+    constexpr Matrix3x4 FromColumns(Vector3 const &c0, Vector3 const &c1, Vector3 const &c2) const
+    {
+        Vector3 const translation = c0 * Vector3(r0.w, r0.w, r0.w) +
+                                    c1 * Vector3(r1.w, r1.w, r1.w) + c2 * Vector3(r2.w, r2.w, r2.w);
+        return Matrix3x4(c0.x, c1.x, c2.x, -translation.x, c0.y, c1.y, c2.y, -translation.y, c0.z,
+                         c1.z, c2.z, -translation.z);
+    }
+
+    static constexpr Vector4 CombineRows(Vector4 const &row, Matrix3x4 const &b)
+    {
+        Vector4 const x(row.x, row.x, row.x, row.x);
+        Vector4 const y(row.y, row.y, row.y, row.y);
+        Vector4 const z(row.z, row.z, row.z, row.z);
+        return x * b.r0 + y * b.r1 + z * b.r2 + Vector4(0.0f, 0.0f, 0.0f, row.w);
+    }
+};
+static_assert(sizeof(Matrix3x4) == 12 * sizeof(float), "Matrix3x4 must stay 12 floats");
+
+//////////////////////////////////////////////////////////////////////////
+// Batch transforms
+//
+// Transform a whole stream of points/normals/vectors by one matrix, writing into caller owned
+// output. Work is done 8 elements at a time (one AVX register, or two 4-wide registers elsewhere)
+// with the matrix splatted into registers once per call. The output may be the input (in-place)
+// but must not partially overlap it.
+//
+// Points are treated as (x, y, z, 1) and normals as (x, y, z, 0); in both cases w is assumed to
+// stay unchanged so projective matrices should use the Vector4 overloads. Normals are transformed
+// by the matrix as given: pass the inverse transpose when it has non-uniform scale.
+
+// Structure-of-arrays input. All component spans must be the same length.
+export struct ConstVector3Streams
+{
+    std::span<float const> x, y, z;
 };
+
+// Structure-of-arrays output. All component spans must be the same length.
+export struct Vector3Streams
+{
+    std::span<float> x, y, z;
+};
+
+export struct ConstVector4Streams
+{
+    std::span<float const> x, y, z, w;
+};
+
+export struct Vector4Streams
+{
+    std::span<float> x, y, z, w;
+};
+
+namespace
+{
+constexpr usz k_BatchWidth = 8;
+
+// The 16 matrix elements, each splatted across a register, in row-major order.
+struct SplatMatrix
+{
+    explicit SplatMatrix(Matrix4x4 const &m)
+        : e{SIMD::Splat8(m.r0.x), SIMD::Splat8(m.r0.y), SIMD::Splat8(m.r0.z), SIMD::Splat8(m.r0.w),
+            SIMD::Splat8(m.r1.x), SIMD::Splat8(m.r1.y), SIMD::Splat8(m.r1.z), SIMD::Splat8(m.r1.w),
+            SIMD::Splat8(m.r2.x), SIMD::Splat8(m.r2.y), SIMD::Splat8(m.r2.z), SIMD::Splat8(m.r2.w),
+            SIMD::Splat8(m.r3.x), SIMD::Splat8(m.r3.y), SIMD::Splat8(m.r3.z), SIMD::Splat8(m.r3.w)}
+    {
+    }
+
+    SIMD::Float8 e[16];
+};
+
+// Transforms 8 xyz values held one component per register.
+// IsPoint adds the translation column (w = 1), otherwise w = 0.
+template <bool IsPoint>
+void Transform3(SplatMatrix const &m, SIMD::Float8 x, SIMD::Float8 y, SIMD::Float8 z,
+                SIMD::Float8 &outX, SIMD::Float8 &outY, SIMD::Float8 &outZ)
+{
+    auto row = [&](SIMD::Float8 const *r) {
+        SIMD::Float8 const zw = IsPoint ? SIMD::MulAdd(r[2], z, r[3]) : SIMD::Mul(r[2], z);
+        return SIMD::MulAdd(r[0], x, SIMD::MulAdd(r[1], y, zw));
+    };
+    outX = row(m.e + 0);
+    outY = row(m.e + 4);
+    outZ = row(m.e + 8);
+}
+
+template <bool IsPoint> Vector3 Transform3(Matrix4x4 const &m, Vector3 const &v)
+{
+    Vector4 const result = m * Vector4(v.x, v.y, v.z, IsPoint ? 1.0f : 0.0f);
+    return Vector3(result.x, result.y, result.z);
+}
+
+template <bool IsPoint>
+void TransformVector3s(Matrix4x4 const &m, std::span<Vector3 const> in, std::span<Vector3> out)
+{
+    static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 streams are read as raw floats");
+    LAT_ASSERT(out.size() >= in.size());
+
+    SplatMatrix const splat(m);
+    float const *src = &in.data()->x;
+    float *dest = &out.data()->x;
+
+    usz i = 0;
+    for (; i + k_BatchWidth <= in.size(); i += k_BatchWidth)
+    {
+        SIMD::Float8 x, y, z;
+        SIMD::LoadDeinterleave3(src + i * 3, x, y, z);
+        Transform3<IsPoint>(splat, x, y, z, x, y, z);
+        SIMD::StoreInterleave3(dest + i * 3, x, y, z);
+    }
+    for (; i < in.size(); ++i)
+    {
+        out[i] = Transform3<IsPoint>(m, in[i]);
+    }
+}
+
+void ValidateStreams(ConstVector3Streams in, Vector3Streams out)
+{
+    usz const count = in.x.size();
+    LAT_ASSERT(in.y.size() == count && in.z.size() == count);
+    LAT_ASSERT(out.x.size() >= count && out.y.size() >= count && out.z.size() >= count);
+}
+
+template <bool IsPoint>
+void TransformVector3s(Matrix4x4 const &m, ConstVector3Streams in, Vector3Streams out)
+{
+    usz const count = in.x.size();
+    SplatMatrix const splat(m);
+
+    usz i = 0;
+    for (; i + k_BatchWidth <= count; i += k_BatchWidth)
+    {
+        SIMD::Float8 x, y, z;
+        Transform3<IsPoint>(splat, SIMD::LoadUnaligned8(&in.x[i]), SIMD::LoadUnaligned8(&in.y[i]),
+                            SIMD::LoadUnaligned8(&in.z[i]), x, y, z);
+        SIMD::StoreUnaligned8(&out.x[i], x);
+        SIMD::StoreUnaligned8(&out.y[i], y);
+        SIMD::StoreUnaligned8(&out.z[i], z);
+    }
+    for (; i < count; ++i)
+    {
+        Vector3 const result = Transform3<IsPoint>(m, Vector3(in.x[i], in.y[i], in.z[i]));
+        out.x[i] = result.x;
+        out.y[i] = result.y;
+        out.z[i] = result.z;
+    }
+}
+
+#if LATERALUS_SIMD_SSE
+// Wider variants of the structure-of-arrays transform for CPUs newer than the build target.
+// See: Lateralus.Core.Dispatch
+
+// One output component from one matrix row (e points at its four splatted elements).
+template <bool IsPoint>
+LATERALUS_TARGET_AVX2 __m256 Transform3RowAVX2(__m256 const *e, __m256 x, __m256 y, __m256 z)
+{
+    __m256 const zw = IsPoint ? _mm256_fmadd_ps(e[2], z, e[3]) : _mm256_mul_ps(e[2], z);
+    return _mm256_fmadd_ps(e[0], x, _mm256_fmadd_ps(e[1], y, zw));
+}
+
+template <bool IsPoint>
+LATERALUS_TARGET_AVX2 void TransformVector3sAVX2(Matrix4x4 const &m, ConstVector3Streams in,
+                                                 Vector3Streams out)
+{
+    Vector4 const *rows[3] = {&m.r0, &m.r1, &m.r2};
+    __m256 e[12];
+    for (usz r = 0; r < 3; ++r)
+    {
+        e[r * 4 + 0] = _mm256_set1_ps(rows[r]->x);
+        e[r * 4 + 1] = _mm256_set1_ps(rows[r]->y);
+        e[r * 4 + 2] = _mm256_set1_ps(rows[r]->z);
+        e[r * 4 + 3] = _mm256_set1_ps(rows[r]->w);
+    }
+
+    usz const count = in.x.size();
+    usz i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 const x = _mm256_loadu_ps(&in.x[i]);
+        __m256 const y = _mm256_loadu_ps(&in.y[i]);
+        __m256 const z = _mm256_loadu_ps(&in.z[i]);
+        _mm256_storeu_ps(&out.x[i], Transform3RowAVX2<IsPoint>(e + 0, x, y, z));
+        _mm256_storeu_ps(&out.y[i], Transform3RowAVX2<IsPoint>(e + 4, x, y, z));
+        _mm256_storeu_ps(&out.z[i], Transform3RowAVX2<IsPoint>(e + 8, x, y, z));
+    }
+    for (; i < count; ++i)
+    {
+        Vector3 const result = Transform3<IsPoint>(m, Vector3(in.x[i], in.y[i], in.z[i]));
+        out.x[i] = result.x;
+        out.y[i] = result.y;
+        out.z[i] = result.z;
+    }
+}
+
+template <bool IsPoint>
+LATERALUS_TARGET_AVX512 __m512 Transform3RowAVX512(__m512 const *e, __m512 x, __m512 y, __m512 z)
+{
+    __m512 const zw = IsPoint ? _mm512_fmadd_ps(e[2], z, e[3]) : _mm512_mul_ps(e[2], z);
+    return _mm512_fmadd_ps(e[0], x, _mm512_fmadd_ps(e[1], y, zw));
+}
+
+template <bool IsPoint>
+LATERALUS_TARGET_AVX512 void TransformVector3sAVX512(Matrix4x4 const &m, ConstVector3Streams in,
+                                                     Vector3Streams out)
+{
+    Vector4 const *rows[3] = {&m.r0, &m.r1, &m.r2};
+    __m512 e[12];
+    for (usz r = 0; r < 3; ++r)
+    {
+        e[r * 4 + 0] = _mm512_set1_ps(rows[r]->x);
+        e[r * 4 + 1] = _mm512_set1_ps(rows[r]->y);
+        e[r * 4 + 2] = _mm512_set1_ps(rows[r]->z);
+        e[r * 4 + 3] = _mm512_set1_ps(rows[r]->w);
+    }
+
+    // The tail is done with masked loads and stores instead of a scalar loop.
+    usz const count = in.x.size();
+    for (usz i = 0; i < count; i += 16)
+    {
+        usz const remaining = count - i;
+        __mmask16 const mask =
+            remaining >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << remaining) - 1u);
+        __m512 const x = _mm512_maskz_loadu_ps(mask, &in.x[i]);
+        __m512 const y = _mm512_maskz_loadu_ps(mask, &in.y[i]);
+        __m512 const z = _mm512_maskz_loadu_ps(mask, &in.z[i]);
+        _mm512_mask_storeu_ps(&out.x[i], mask, Transform3RowAVX512<IsPoint>(e + 0, x, y, z));
+        _mm512_mask_storeu_ps(&out.y[i], mask, Transform3RowAVX512<IsPoint>(e + 4, x, y, z));
+        _mm512_mask_storeu_ps(&out.z[i], mask, Transform3RowAVX512<IsPoint>(e + 8, x, y, z));
+    }
+}
+#endif
+
+using TransformVector3StreamsFn = void(Matrix4x4 const &, ConstVector3Streams, Vector3Streams);
+
+DispatchedFunction<TransformVector3StreamsFn> g_TransformPointStreams{
+    {SSEVersion::None, &TransformVector3s<true>},
+#if LATERALUS_SIMD_SSE
+    {SSEVersion::AVX2, &TransformVector3sAVX2<true>},
+    {SSEVersion::AVX512, &TransformVector3sAVX512<true>},
+#endif
+};
+
+DispatchedFunction<TransformVector3StreamsFn> g_TransformNormalStreams{
+    {SSEVersion::None, &TransformVector3s<false>},
+#if LATERALUS_SIMD_SSE
+    {SSEVersion::AVX2, &TransformVector3sAVX2<false>},
+    {SSEVersion::AVX512, &TransformVector3sAVX512<false>},
+#endif
+};
+} // namespace
+
+export void TransformPoints(Matrix4x4 const &m, std::span<Vector3 const> in,
+                            std::span<Vector3> out)
+{
+    TransformVector3s<true>(m, in, out);
+}
+
+export void TransformPoints(Matrix4x4 const &m, ConstVector3Streams in, Vector3Streams out)
+{
+    ValidateStreams(in, out);
+    g_TransformPointStreams(m, in, out);
+}
+
+export void TransformNormals(Matrix4x4 const &m, std::span<Vector3 const> in,
+                             std::span<Vector3> out)
+{
+    TransformVector3s<false>(m, in, out);
+}
+
+export void TransformNormals(Matrix4x4 const &m, ConstVector3Streams in, Vector3Streams out)
+{
+    ValidateStreams(in, out);
+    g_TransformNormalStreams(m, in, out);
+}
+
+export void TransformVectors(Matrix4x4 const &m, std::span<Vector4 const> in,
+                             std::span<Vector4> out)
+{
+    LAT_ASSERT(out.size() >= in.size());
+
+    // With the matrix stored as columns each result is c0 * v.x + c1 * v.y + c2 * v.z + c3 * v.w,
+    // which lets two Vector4s share one 8-wide register.
+    Matrix4x4 const columns = m.Transpose();
+    SIMD::Float4 const c0 = columns.r0.ToSIMD();
+    SIMD::Float4 const c1 = columns.r1.ToSIMD();
+    SIMD::Float4 const c2 = columns.r2.ToSIMD();
+    SIMD::Float4 const c3 = columns.r3.ToSIMD();
+    SIMD::Float8 const c0x2 = SIMD::Duplicate(c0);
+    SIMD::Float8 const c1x2 = SIMD::Duplicate(c1);
+    SIMD::Float8 const c2x2 = SIMD::Duplicate(c2);
+    SIMD::Float8 const c3x2 = SIMD::Duplicate(c3);
+
+    float const *src = &in.data()->x;
+    float *dest = &out.data()->x;
+
+    usz i = 0;
+    for (; i + 2 <= in.size(); i += 2)
+    {
+        SIMD::Float8 const v = SIMD::LoadUnaligned8(src + i * 4);
+        SIMD::Float8 result = SIMD::Mul(c0x2, SIMD::Broadcast<0>(v));
+        result = SIMD::MulAdd(c1x2, SIMD::Broadcast<1>(v), result);
+        result = SIMD::MulAdd(c2x2, SIMD::Broadcast<2>(v), result);
+        result = SIMD::MulAdd(c3x2, SIMD::Broadcast<3>(v), result);
+        SIMD::StoreUnaligned8(dest + i * 4, result);
+    }
+    for (; i < in.size(); ++i)
+    {
+        SIMD::Float4 const v = in[i].ToSIMD();
+        SIMD::Float4 result = SIMD::Mul(c0, SIMD::Broadcast<0>(v));
+        result = SIMD::MulAdd(c1, SIMD::Broadcast<1>(v), result);
+        result = SIMD::MulAdd(c2, SIMD::Broadcast<2>(v), result);
+        result = SIMD::MulAdd(c3, SIMD::Broadcast<3>(v), result);
+        out[i] = Vector4::FromSIMD(result);
+    }
+}
+
+export void TransformVectors(Matrix4x4 const &m, ConstVector4Streams in, Vector4Streams out)
+{
+    usz const count = in.x.size();
+    LAT_ASSERT(in.y.size() == count && in.z.size() == count && in.w.size() == count);
+    LAT_ASSERT(out.x.size() >= count && out.y.size() >= count && out.z.size() >= count &&
+               out.w.size() >= count);
+
+    SplatMatrix const splat(m);
+    auto row = [&splat](usz r, SIMD::Float8 x, SIMD::Float8 y, SIMD::Float8 z, SIMD::Float8 w) {
+        SIMD::Float8 const *e = splat.e + r * 4;
+        SIMD::Float8 const zw = SIMD::MulAdd(e[2], z, SIMD::Mul(e[3], w));
+        return SIMD::MulAdd(e[0], x, SIMD::MulAdd(e[1], y, zw));
+    };
+
+    usz i = 0;
+    for (; i + k_BatchWidth <= count; i += k_BatchWidth)
+    {
+        SIMD::Float8 const x = SIMD::LoadUnaligned8(&in.x[i]);
+        SIMD::Float8 const y = SIMD::LoadUnaligned8(&in.y[i]);
+        SIMD::Float8 const z = SIMD::LoadUnaligned8(&in.z[i]);
+        SIMD::Float8 const w = SIMD::LoadUnaligned8(&in.w[i]);
+        SIMD::StoreUnaligned8(&out.x[i], row(0, x, y, z, w));
+        SIMD::StoreUnaligned8(&out.y[i], row(1, x, y, z, w));
+        SIMD::StoreUnaligned8(&out.z[i], row(2, x, y, z, w));
+        SIMD::StoreUnaligned8(&out.w[i], row(3, x, y, z, w));
+    }
+    for (; i < count; ++i)
+    {
+        Vector4 const result = m * Vector4(in.x[i], in.y[i], in.z[i], in.w[i]);
+        out.x[i] = result.x;
+        out.y[i] = result.y;
+        out.z[i] = result.z;
+        out.w[i] = result.w;
+    }
+}
+
+// out[n] = Matrix4x4::CreateRotation(rotations[n]), with the sines and cosines for four rotations
+// computed at once.
+export void CreateRotations(std::span<Vector3 const> rotations, std::span<Matrix4x4> out)
+{
+    LAT_ASSERT(out.size() >= rotations.size());
+
+    SIMD::Float4 const deg2Rad = SIMD::Splat(Deg2Rad);
+    usz i = 0;
+    for (; i + 4 <= rotations.size(); i += 4)
+    {
+        SIMD::Float4 x, y, z;
+        SIMD::LoadDeinterleave3(&rotations[i].x, x, y, z);
+
+        SIMD::Float4 sinX, cosX, sinY, cosY, sinZ, cosZ;
+        SinCos<Precision::Precise>(SIMD::Mul(x, deg2Rad), sinX, cosX);
+        SinCos<Precision::Precise>(SIMD::Mul(y, deg2Rad), sinY, cosY);
+        SinCos<Precision::Precise>(SIMD::Mul(z, deg2Rad), sinZ, cosZ);
+
+        // The same terms as CreateRotation, for four matrices per register.
+        SIMD::Float4 const sinXsinY = SIMD::Mul(sinX, sinY);
+        SIMD::Float4 const cosXsinY = SIMD::Mul(cosX, sinY);
+        SIMD::Float4 const zero = SIMD::Zero();
+        SIMD::Float4 row0[4] = {
+            SIMD::Mul(cosY, cosZ),
+            SIMD::MulAdd(sinXsinY, cosZ, SIMD::Negate(SIMD::Mul(cosX, sinZ))),
+            SIMD::MulAdd(cosXsinY, cosZ, SIMD::Mul(sinX, sinZ)), zero};
+        SIMD::Float4 row1[4] = {
+            SIMD::Mul(cosY, sinZ), SIMD::MulAdd(sinXsinY, sinZ, SIMD::Mul(cosX, cosZ)),
+            SIMD::MulAdd(cosXsinY, sinZ, SIMD::Negate(SIMD::Mul(sinX, cosZ))), zero};
+        SIMD::Float4 row2[4] = {SIMD::Negate(sinY), SIMD::Mul(sinX, cosY), SIMD::Mul(cosX, cosY),
+                                zero};
+        SIMD::Transpose(row0[0], row0[1], row0[2], row0[3]);
+        SIMD::Transpose(row1[0], row1[1], row1[2], row1[3]);
+        SIMD::Transpose(row2[0], row2[1], row2[2], row2[3]);
+
+        for (usz m = 0; m < 4; ++m)
+        {
+            Matrix4x4 &result = out[i + m];
+            result.r0 = Vector4::FromSIMD(row0[m]);
+            result.r1 = Vector4::FromSIMD(row1[m]);
+            result.r2 = Vector4::FromSIMD(row2[m]);
+            result.r3 = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+    for (; i < rotations.size(); ++i)
+    {
+        out[i] = Matrix4x4::CreateRotation(rotations[i]);
+    }
+}
 } // namespace Lateralus::Core
\ No newline at end of file
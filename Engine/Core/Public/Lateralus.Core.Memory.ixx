@@ -0,0 +1,730 @@
+module;
+
+#include <Core.Assert.h>
+#include <Core.Compiler.h>
+
+export module Lateralus.Core.Memory;
+
+import <algorithm>;
+import <array>;
+import <atomic>;
+import <bit>;
+import <cstddef>;
+import <memory>;
+import <memory_resource>;
+import <mutex>;
+import <new>;
+import <type_traits>;
+import <utility>;
+import <vector>;
+
+import Lateralus.Core;
+import Lateralus.Core.ByteConversion;
+
+namespace Lateralus::Core
+{
+export constexpr usz AlignUp(usz value, usz alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Who an allocation is for, to see where memory goes.
+export enum class MemoryTag : uint8
+{
+    Core,
+    Platform,
+    ImGui,
+    FreeType,
+    Assets,
+    Count
+};
+
+export constexpr usz k_MemoryTagCount = static_cast<usz>(MemoryTag::Count);
+
+export constexpr char const *MemoryTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::Core: return "Core";
+    case MemoryTag::Platform: return "Platform";
+    case MemoryTag::ImGui: return "ImGui";
+    case MemoryTag::FreeType: return "FreeType";
+    case MemoryTag::Assets: return "Assets";
+    default: return "Unknown";
+    }
+}
+
+export struct MemoryTagStats
+{
+    uint64 CurrentBytes = 0;
+    uint64 PeakBytes = 0;
+    // Allocations made since startup.
+    uint64 AllocationCount = 0;
+    // Allocations not yet freed.
+    uint64 LiveCount = 0;
+};
+
+// On separate cache lines so threads allocating for different tags don't contend.
+struct alignas(64) MemoryTagCounters
+{
+    std::atomic<uint64> CurrentBytes = 0;
+    std::atomic<uint64> PeakBytes = 0;
+    std::atomic<uint64> AllocationCount = 0;
+    std::atomic<uint64> FreeCount = 0;
+};
+
+MemoryTagCounters &GetMemoryTagCounters(MemoryTag tag)
+{
+    static MemoryTagCounters counters[k_MemoryTagCount];
+    LAT_ASSERT(tag < MemoryTag::Count);
+    return counters[static_cast<usz>(tag)];
+}
+
+/// <summary>
+/// Counts an allocation against a tag, for memory handed out by something other than the tagged
+/// allocators below, such as slabs or committed pages. Pair each with a TrackFree of the same
+/// size. Safe from any thread and lock-free.
+/// </summary>
+export void TrackAlloc(MemoryTag tag, usz bytes)
+{
+    MemoryTagCounters &counters = GetMemoryTagCounters(tag);
+    counters.AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    uint64 const current =
+        counters.CurrentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    uint64 peak = counters.PeakBytes.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !counters.PeakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+    {
+    }
+}
+
+export void TrackFree(MemoryTag tag, usz bytes)
+{
+    MemoryTagCounters &counters = GetMemoryTagCounters(tag);
+    counters.FreeCount.fetch_add(1, std::memory_order_relaxed);
+    counters.CurrentBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+// The counters are read one at a time, so they may be out of step while other threads allocate.
+export MemoryTagStats GetMemoryTagStats(MemoryTag tag)
+{
+    MemoryTagCounters const &counters = GetMemoryTagCounters(tag);
+    MemoryTagStats stats;
+    stats.CurrentBytes = counters.CurrentBytes.load(std::memory_order_relaxed);
+    stats.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+    uint64 const frees = counters.FreeCount.load(std::memory_order_relaxed);
+    stats.AllocationCount = counters.AllocationCount.load(std::memory_order_relaxed);
+    stats.LiveCount = stats.AllocationCount - std::min(frees, stats.AllocationCount);
+    return stats;
+}
+
+// Room in front of a TaggedMalloc block for its size, keeping the block maximally aligned.
+constexpr usz k_TaggedHeaderSize = alignof(std::max_align_t);
+
+/// <summary>
+/// malloc and free counted against a tag, for libraries that free without passing the size, such
+/// as the hooks taken by ImGui::SetAllocatorFunctions. Each block carries its size in front of it.
+/// </summary>
+export void *TaggedMalloc(MemoryTag tag, usz bytes)
+{
+    auto *block = static_cast<std::byte *>(::operator new(k_TaggedHeaderSize + bytes));
+    *reinterpret_cast<usz *>(block) = bytes;
+    TrackAlloc(tag, bytes);
+    return block + k_TaggedHeaderSize;
+}
+
+export void TaggedMallocFree(MemoryTag tag, void *pointer)
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+    std::byte *block = static_cast<std::byte *>(pointer) - k_TaggedHeaderSize;
+    TrackFree(tag, *reinterpret_cast<usz *>(block));
+    ::operator delete(block);
+}
+
+// A std::pmr::memory_resource counting what passes through it against a tag.
+export class TaggedResource : public std::pmr::memory_resource
+{
+public:
+    explicit TaggedResource(MemoryTag tag,
+                            std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+        : m_Tag(tag), m_Upstream(upstream)
+    {
+    }
+
+    MemoryTag GetTag() const { return m_Tag; }
+
+private:
+    void *do_allocate(usz bytes, usz alignment) override
+    {
+        void *pointer = m_Upstream->allocate(bytes, alignment);
+        TrackAlloc(m_Tag, bytes);
+        return pointer;
+    }
+
+    void do_deallocate(void *pointer, usz bytes, usz alignment) override
+    {
+        TrackFree(m_Tag, bytes);
+        m_Upstream->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    MemoryTag m_Tag;
+    std::pmr::memory_resource *m_Upstream;
+};
+
+// The global heap, counted against tag.
+export TaggedResource *GetTaggedResource(MemoryTag tag)
+{
+    static TaggedResource resources[] = {
+        TaggedResource(MemoryTag::Core),     TaggedResource(MemoryTag::Platform),
+        TaggedResource(MemoryTag::ImGui),    TaggedResource(MemoryTag::FreeType),
+        TaggedResource(MemoryTag::Assets),
+    };
+    static_assert(std::size(resources) == k_MemoryTagCount);
+    return &resources[static_cast<usz>(tag)];
+}
+
+// A standard allocator counting against a tag, for containers and std::allocate_shared.
+export template <typename T> class TaggedAllocator
+{
+public:
+    using value_type = T;
+
+    explicit TaggedAllocator(MemoryTag tag) : m_Tag(tag) {}
+    template <typename U> TaggedAllocator(TaggedAllocator<U> const &other) : m_Tag(other.GetTag())
+    {
+    }
+
+    T *allocate(usz count)
+    {
+        T *pointer = std::allocator<T>().allocate(count);
+        TrackAlloc(m_Tag, count * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T *pointer, usz count)
+    {
+        TrackFree(m_Tag, count * sizeof(T));
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    MemoryTag GetTag() const { return m_Tag; }
+
+    template <typename U> bool operator==(TaggedAllocator<U> const &other) const
+    {
+        return m_Tag == other.GetTag();
+    }
+
+private:
+    MemoryTag m_Tag;
+};
+
+// make_shared, with the object and its reference counts counted against tag.
+export template <typename T, typename... Args>
+std::shared_ptr<T> MakeTaggedShared(MemoryTag tag, Args &&...args)
+{
+    return std::allocate_shared<T>(TaggedAllocator<std::remove_const_t<T>>(tag),
+                                   std::forward<Args>(args)...);
+}
+
+/// <summary>
+/// Hands out memory by bumping an offset through one block and frees all of it at once with
+/// Reset. Deallocating does nothing.
+///
+/// Any thread may allocate; the common case is one atomic compare and swap. When the block runs
+/// out, allocations fall back to the upstream resource until the next Reset, which then grows the
+/// block to fit everything that was allocated, so an arena settles on its working set.
+///
+/// As a std::pmr::memory_resource it can back pmr containers, which must be gone by the Reset.
+/// </summary>
+export class LinearArena : public std::pmr::memory_resource
+{
+public:
+    explicit LinearArena(usz capacity,
+                         std::pmr::memory_resource *upstream = GetTaggedResource(MemoryTag::Core))
+        : m_Upstream(upstream)
+    {
+        AllocateBlock(capacity);
+    }
+
+    LinearArena(LinearArena const &) = delete;
+    LinearArena &operator=(LinearArena const &) = delete;
+
+    ~LinearArena() override
+    {
+        ReleaseOverflow();
+        m_Upstream->deallocate(m_Block, m_Capacity, k_BlockAlignment);
+    }
+
+    // Frees everything allocated so far. Nothing may allocate from the arena meanwhile.
+    void Reset()
+    {
+        usz const used = GetUsed();
+        m_Peak = std::max(m_Peak, used);
+        bool const overflowed = !m_Overflow.empty();
+        ReleaseOverflow();
+        if (overflowed)
+        {
+            m_Upstream->deallocate(m_Block, m_Capacity, k_BlockAlignment);
+            AllocateBlock(std::bit_ceil(used));
+        }
+        m_Offset.store(0, std::memory_order_relaxed);
+    }
+
+    // Bytes handed out since the last Reset, alignment padding included.
+    usz GetUsed() const
+    {
+        return m_Offset.load(std::memory_order_relaxed) +
+               m_OverflowBytes.load(std::memory_order_relaxed);
+    }
+
+    usz GetCapacity() const { return m_Capacity; }
+
+    // The most GetUsed has been at a Reset.
+    usz GetPeak() const { return m_Peak; }
+
+private:
+    static constexpr usz k_BlockAlignment = 64;
+
+    struct Overflow
+    {
+        void *Pointer;
+        usz Size;
+        usz Alignment;
+    };
+
+    void *do_allocate(usz bytes, usz alignment) override
+    {
+        LAT_ASSERT(std::has_single_bit(alignment));
+        auto const base = reinterpret_cast<uintptr_t>(m_Block);
+        usz offset = m_Offset.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            usz const begin = AlignUp(base + offset, alignment) - base;
+            usz const end = begin + bytes;
+            if (end > m_Capacity)
+            {
+                return AllocateOverflow(bytes, alignment);
+            }
+            if (m_Offset.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+            {
+                return m_Block + begin;
+            }
+        }
+    }
+
+    void do_deallocate(void *, usz, usz) override {}
+
+    bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    void AllocateBlock(usz capacity)
+    {
+        m_Capacity = AlignUp(std::max<usz>(capacity, k_BlockAlignment), k_BlockAlignment);
+        m_Block = static_cast<std::byte *>(m_Upstream->allocate(m_Capacity, k_BlockAlignment));
+    }
+
+    void *AllocateOverflow(usz bytes, usz alignment)
+    {
+        void *pointer = m_Upstream->allocate(bytes, alignment);
+        std::lock_guard lock(m_OverflowMutex);
+        m_Overflow.push_back({pointer, bytes, alignment});
+        m_OverflowBytes.fetch_add(bytes, std::memory_order_relaxed);
+        return pointer;
+    }
+
+    void ReleaseOverflow()
+    {
+        for (Overflow const &overflow : m_Overflow)
+        {
+            m_Upstream->deallocate(overflow.Pointer, overflow.Size, overflow.Alignment);
+        }
+        m_Overflow.clear();
+        m_OverflowBytes.store(0, std::memory_order_relaxed);
+    }
+
+    std::pmr::memory_resource *m_Upstream;
+    std::byte *m_Block = nullptr;
+    usz m_Capacity = 0;
+    std::atomic<usz> m_Offset = 0;
+    usz m_Peak = 0;
+
+    std::mutex m_OverflowMutex;
+    std::vector<Overflow> m_Overflow;
+    std::atomic<usz> m_OverflowBytes = 0;
+};
+
+/// <summary>
+/// Memory that lives for a frame, and the frame after it.
+///
+/// Two linear arenas take turns: NewFrame resets the one used two frames ago and makes it
+/// current, leaving last frame's allocations intact in GetPrevious. That gives a render thread
+/// running one frame behind the time to read what the game thread built for it.
+///
+/// NewFrame must be called while nothing allocates from the current arena.
+/// </summary>
+export class FrameArena
+{
+public:
+    explicit FrameArena(usz capacityPerFrame)
+        : m_Arenas{LinearArena(capacityPerFrame), LinearArena(capacityPerFrame)}
+    {
+    }
+
+    void NewFrame()
+    {
+        m_FrameIndex++;
+        GetCurrent().Reset();
+    }
+
+    LinearArena &GetCurrent() { return m_Arenas[m_FrameIndex % 2]; }
+    LinearArena &GetPrevious() { return m_Arenas[(m_FrameIndex + 1) % 2]; }
+
+    uint64 GetFrameIndex() const { return m_FrameIndex; }
+
+private:
+    LinearArena m_Arenas[2];
+    uint64 m_FrameIndex = 0;
+};
+
+// The engine's frame arena, advanced by iWindow::NewFrame.
+export FrameArena &GetFrameArena()
+{
+    static FrameArena arena(1_MiB);
+    return arena;
+}
+
+/// <summary>
+/// An allocator for pmr containers that only live until the end of the next frame, such as
+/// temporaries inside a function:
+///     std::pmr::vector<int> indices(GetFrameAllocator());
+/// </summary>
+export template <typename T = std::byte> std::pmr::polymorphic_allocator<T> GetFrameAllocator()
+{
+    return &GetFrameArena().GetCurrent();
+}
+
+// Block sizes the pool hands out. All are multiples of 16, and a block is aligned to the largest
+// power of two dividing its size, up to the slab alignment.
+constexpr std::array<usz, 12> k_PoolClassSizes = {16,  32,  48,  64,  96,  128,
+                                                  192, 256, 384, 512, 768, 1024};
+constexpr usz k_PoolClassCount = k_PoolClassSizes.size();
+constexpr usz k_PoolSlabSize = 64 * 1024;
+constexpr usz k_PoolSlabAlignment = 64;
+// Blocks moved between a thread's cache and the shared depot at a time.
+constexpr usz k_PoolBatchSize = 32;
+constexpr usz k_PoolNoClass = ~usz(0);
+
+// The first class at least as large as each multiple of 16.
+constexpr auto k_PoolClassBySize = [] {
+    std::array<uint8, k_PoolClassSizes.back() / 16 + 1> table{};
+    usz classIndex = 0;
+    for (usz i = 0; i < table.size(); ++i)
+    {
+        while (k_PoolClassSizes[classIndex] < i * 16)
+        {
+            classIndex++;
+        }
+        table[i] = static_cast<uint8>(classIndex);
+    }
+    return table;
+}();
+
+constexpr usz PoolClassFor(usz bytes, usz alignment)
+{
+    if (bytes > k_PoolClassSizes.back() || alignment > k_PoolSlabAlignment)
+    {
+        return k_PoolNoClass;
+    }
+    for (usz classIndex = k_PoolClassBySize[(bytes + 15) / 16]; classIndex < k_PoolClassCount;
+         ++classIndex)
+    {
+        usz const size = k_PoolClassSizes[classIndex];
+        if ((size & (~size + 1)) >= alignment)
+        {
+            return classIndex;
+        }
+    }
+    return k_PoolNoClass;
+}
+
+// A free block. The first block of a batch in the depot also links to the next batch.
+struct PoolBlock
+{
+    PoolBlock *Next;
+    PoolBlock *NextBatch;
+};
+
+// Where threads get blocks when their cache runs dry and put them when it overflows. Slabs are
+// carved into batches here and kept for the life of the process, so memory freed in one size
+// class is only ever reused by that class.
+class PoolDepot
+{
+public:
+    static PoolDepot &Get()
+    {
+        // Never destroyed: blocks may still be freed while other statics are torn down.
+        static PoolDepot *depot = new PoolDepot;
+        return *depot;
+    }
+
+    PoolBlock *TakeBatch(usz classIndex)
+    {
+        Class &sizeClass = m_Classes[classIndex];
+        std::lock_guard lock(sizeClass.Mutex);
+        if (sizeClass.Batches == nullptr)
+        {
+            CarveSlab(sizeClass, k_PoolClassSizes[classIndex]);
+        }
+        PoolBlock *batch = sizeClass.Batches;
+        sizeClass.Batches = batch->NextBatch;
+        return batch;
+    }
+
+    // The blocks from first through to the one whose Next is null.
+    void GiveBatch(usz classIndex, PoolBlock *first)
+    {
+        Class &sizeClass = m_Classes[classIndex];
+        std::lock_guard lock(sizeClass.Mutex);
+        first->NextBatch = sizeClass.Batches;
+        sizeClass.Batches = first;
+    }
+
+    usz GetSlabBytes() const { return m_SlabBytes.load(std::memory_order_relaxed); }
+
+private:
+    struct Class
+    {
+        std::mutex Mutex;
+        PoolBlock *Batches = nullptr;
+    };
+
+    void CarveSlab(Class &sizeClass, usz blockSize)
+    {
+        auto *slab = static_cast<std::byte *>(
+            ::operator new(k_PoolSlabSize, std::align_val_t(k_PoolSlabAlignment)));
+        m_SlabBytes.fetch_add(k_PoolSlabSize, std::memory_order_relaxed);
+        TrackAlloc(MemoryTag::Core, k_PoolSlabSize);
+        usz const blockCount = k_PoolSlabSize / blockSize;
+        for (usz first = 0; first < blockCount; first += k_PoolBatchSize)
+        {
+            usz const last = std::min(first + k_PoolBatchSize, blockCount) - 1;
+            for (usz i = first; i <= last; ++i)
+            {
+                auto *block = reinterpret_cast<PoolBlock *>(slab + i * blockSize);
+                block->Next = i == last ? nullptr
+                                        : reinterpret_cast<PoolBlock *>(slab + (i + 1) * blockSize);
+            }
+            auto *batch = reinterpret_cast<PoolBlock *>(slab + first * blockSize);
+            batch->NextBatch = sizeClass.Batches;
+            sizeClass.Batches = batch;
+        }
+    }
+
+    Class m_Classes[k_PoolClassCount];
+    std::atomic<usz> m_SlabBytes = 0;
+};
+
+// Ends the list at first after at most a batch of blocks, returning the rest.
+PoolBlock *SplitPoolBatch(PoolBlock *first)
+{
+    PoolBlock *last = first;
+    for (usz i = 1; i < k_PoolBatchSize && last->Next != nullptr; ++i)
+    {
+        last = last->Next;
+    }
+    return std::exchange(last->Next, nullptr);
+}
+
+// Each thread's free blocks, taken and returned without synchronization. Constant initialized and
+// trivially destructible, so it's usable at any point in the thread's life; PoolThreadExit hands
+// the blocks back when the thread ends.
+struct PoolThreadCache
+{
+    PoolBlock *Heads[k_PoolClassCount];
+    // No less than the length of each list, as the last batch carved from a slab can be short.
+    uint32 Counts[k_PoolClassCount];
+    bool Registered;
+    bool Exited;
+};
+
+struct PoolThreadExit
+{
+    PoolThreadExit();
+    ~PoolThreadExit();
+};
+
+thread_local PoolThreadCache t_PoolCache = {};
+thread_local PoolThreadExit t_PoolThreadExit;
+
+// Pools are used from jobs, so the cache is read through a call. See JobSystem::CurrentThread.
+LAT_NOINLINE PoolThreadCache *GetPoolCache()
+{
+    PoolThreadCache *cache = &t_PoolCache;
+    if (!cache->Registered)
+    {
+        cache->Registered = true;
+        // Touching it constructs it, which schedules the destructor for the thread's exit.
+        PoolDepot::Get();
+        [[maybe_unused]] PoolThreadExit *exit = &t_PoolThreadExit;
+    }
+    return cache;
+}
+
+PoolThreadExit::PoolThreadExit() = default;
+
+PoolThreadExit::~PoolThreadExit()
+{
+    PoolThreadCache &cache = t_PoolCache;
+    for (usz classIndex = 0; classIndex < k_PoolClassCount; ++classIndex)
+    {
+        while (PoolBlock *batch = cache.Heads[classIndex])
+        {
+            cache.Heads[classIndex] = SplitPoolBatch(batch);
+            PoolDepot::Get().GiveBatch(classIndex, batch);
+        }
+        cache.Counts[classIndex] = 0;
+    }
+    cache.Exited = true;
+}
+
+/// <summary>
+/// Allocates from fixed size blocks, for small objects made and destroyed at a high rate. Sizes
+/// up to 1024 bytes are rounded up to one of a few size classes and take a block from the calling
+/// thread's free list for that class, in O(1) and without locks. Only every k_PoolBatchSize
+/// allocations or frees, a thread exchanges a batch of blocks with a shared depot under a lock.
+///
+/// Blocks come from 64 KiB slabs that are never returned, so a long session settles on the most
+/// it has needed of each size and doesn't fragment. Larger sizes go to the global heap.
+///
+/// Memory may be freed on any thread, with the size and alignment it was allocated with.
+/// </summary>
+export void *PoolAllocate(usz bytes, usz alignment = alignof(std::max_align_t))
+{
+    usz const classIndex = PoolClassFor(bytes, alignment);
+    if (classIndex == k_PoolNoClass)
+    {
+        void *pointer = ::operator new(bytes, std::align_val_t(alignment));
+        TrackAlloc(MemoryTag::Core, bytes);
+        return pointer;
+    }
+    PoolThreadCache *cache = GetPoolCache();
+    if (cache->Exited)
+    {
+        // Called from the destructor of a thread local, after the cache was handed back.
+        PoolBlock *batch = PoolDepot::Get().TakeBatch(classIndex);
+        if (batch->Next != nullptr)
+        {
+            PoolDepot::Get().GiveBatch(classIndex, batch->Next);
+        }
+        return batch;
+    }
+    PoolBlock *block = cache->Heads[classIndex];
+    if (block == nullptr)
+    {
+        block = PoolDepot::Get().TakeBatch(classIndex);
+        cache->Counts[classIndex] = k_PoolBatchSize;
+    }
+    cache->Heads[classIndex] = block->Next;
+    cache->Counts[classIndex]--;
+    return block;
+}
+
+export void PoolFree(void *pointer, usz bytes, usz alignment = alignof(std::max_align_t))
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+    usz const classIndex = PoolClassFor(bytes, alignment);
+    if (classIndex == k_PoolNoClass)
+    {
+        TrackFree(MemoryTag::Core, bytes);
+        ::operator delete(pointer, std::align_val_t(alignment));
+        return;
+    }
+    auto *block = static_cast<PoolBlock *>(pointer);
+    PoolThreadCache *cache = GetPoolCache();
+    if (cache->Exited)
+    {
+        block->Next = nullptr;
+        PoolDepot::Get().GiveBatch(classIndex, block);
+        return;
+    }
+    block->Next = cache->Heads[classIndex];
+    cache->Heads[classIndex] = block;
+    // Keep up to two batches, so alternating allocations and frees don't reach the depot.
+    if (++cache->Counts[classIndex] == 2 * k_PoolBatchSize)
+    {
+        cache->Heads[classIndex] = SplitPoolBatch(block);
+        cache->Counts[classIndex] = k_PoolBatchSize;
+        PoolDepot::Get().GiveBatch(classIndex, block);
+    }
+}
+
+// Bytes of slabs the pool has taken from the global heap.
+export usz GetPoolReservedBytes()
+{
+    return PoolDepot::Get().GetSlabBytes();
+}
+
+// Constructs a T in pool memory. Destroy it with PoolDelete.
+export template <typename T, typename... Args> T *PoolNew(Args &&...args)
+{
+    void *memory = PoolAllocate(sizeof(T), alignof(T));
+    try
+    {
+        return new (memory) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        PoolFree(memory, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
+// T has to be the type the object was created as, not a base.
+export template <typename T> void PoolDelete(T *object)
+{
+    if (object != nullptr)
+    {
+        object->~T();
+        PoolFree(object, sizeof(T), alignof(T));
+    }
+}
+
+// A standard allocator over the pool, for containers of small nodes and std::allocate_shared.
+export template <typename T> class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template <typename U> PoolAllocator(PoolAllocator<U> const &) {}
+
+    T *allocate(usz count)
+    {
+        return static_cast<T *>(PoolAllocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *pointer, usz count) { PoolFree(pointer, count * sizeof(T), alignof(T)); }
+
+    template <typename U> bool operator==(PoolAllocator<U> const &) const { return true; }
+};
+
+// make_shared, with the object and its reference counts in one pool block.
+export template <typename T, typename... Args> std::shared_ptr<T> MakePoolShared(Args &&...args)
+{
+    return std::allocate_shared<T>(PoolAllocator<std::remove_const_t<T>>(),
+                                    std::forward<Args>(args)...);
+}
+} // namespace Lateralus::Core
@@ -0,0 +1,903 @@
+module;
+
+#include <Core.Assert.h>
+#include <Core.Compiler.h>
+
+#if PLATFORM_IS_AMD64 || PLATFORM_IS_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+export module Lateralus.Core.Profile;
+
+import <algorithm>;
+import <array>;
+import <atomic>;
+import <bit>;
+import <charconv>;
+import <chrono>;
+import <cmath>;
+import <memory>;
+import <mutex>;
+import <ostream>;
+import <string>;
+import <string_view>;
+import <thread>;
+import <vector>;
+
+import Lateralus.Core;
+
+namespace Lateralus::Core::Profile
+{
+// Where a zone is in the source. LAT_PROFILE_ZONE makes one per zone, which lives as long as the
+// program, so records only carry a pointer to it.
+export struct ZoneSite
+{
+    char const *Name;
+    char const *File;
+    uint32 Line;
+};
+
+/// <summary>
+/// A timestamp for profiling. On x86 it reads the time stamp counter, which takes a few
+/// nanoseconds and ticks at a constant rate on every CPU made in the last decade; elsewhere it's
+/// steady_clock in nanoseconds. Convert with GetTicksPerSecond.
+/// </summary>
+export uint64 GetTicks()
+{
+#if PLATFORM_IS_AMD64 || PLATFORM_IS_X86
+    return __rdtsc();
+#else
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+#endif
+}
+
+struct TickCalibration
+{
+    uint64 Ticks;
+    std::chrono::steady_clock::time_point Time;
+};
+
+// Taken the first time anything is profiled, to measure the tick rate against.
+TickCalibration const &GetTickStart()
+{
+    static TickCalibration const start{GetTicks(), std::chrono::steady_clock::now()};
+    return start;
+}
+
+/// <summary>
+/// How fast GetTicks counts. With the time stamp counter it's measured against steady_clock from
+/// the first profiled zone, waiting until that's at least k_CalibrationTime ago on the first call.
+/// </summary>
+export uint64 GetTicksPerSecond()
+{
+#if PLATFORM_IS_AMD64 || PLATFORM_IS_X86
+    static uint64 const ticksPerSecond = [] {
+        constexpr auto k_CalibrationTime = std::chrono::milliseconds(50);
+        TickCalibration const &start = GetTickStart();
+        std::chrono::steady_clock::time_point now;
+        uint64 ticks;
+        do
+        {
+            now = std::chrono::steady_clock::now();
+            ticks = GetTicks();
+        } while (now - start.Time < k_CalibrationTime);
+        double const seconds = std::chrono::duration<double>(now - start.Time).count();
+        return static_cast<uint64>(static_cast<double>(ticks - start.Ticks) / seconds);
+    }();
+    return ticksPerSecond;
+#else
+    return 1'000'000'000;
+#endif
+}
+
+export double TicksToMilliseconds(uint64 ticks)
+{
+    return static_cast<double>(ticks) * 1000.0 / static_cast<double>(GetTicksPerSecond());
+}
+
+/// <summary>
+/// A ring of fixed size events written by one thread and read by any, without locks. The writer
+/// never waits; once full, each write replaces the oldest event. Readers copy the events and then
+/// drop any the writer may have been overwriting meanwhile.
+///
+/// Events are Words uint64s, stored as relaxed atomics so a torn read is detected rather than a
+/// data race.
+/// </summary>
+template <usz Words> class EventRing
+{
+public:
+    using Event = std::array<uint64, Words>;
+
+    explicit EventRing(usz capacity)
+        : m_Words(std::make_unique<std::atomic<uint64>[]>(capacity * Words)),
+          m_Capacity(capacity)
+    {
+        LAT_ASSERT(std::has_single_bit(capacity));
+    }
+
+    // Only from the thread that owns the ring.
+    void Push(Event const &event)
+    {
+        uint64 const index = m_Written.load(std::memory_order_relaxed);
+        // Pairs with the fence in Copy: a reader seeing any of these words also sees that the
+        // event they replace was already published as written.
+        std::atomic_thread_fence(std::memory_order_release);
+        std::atomic<uint64> *slot = &m_Words[(index & (m_Capacity - 1)) * Words];
+        for (usz i = 0; i < Words; ++i)
+        {
+            slot[i].store(event[i], std::memory_order_relaxed);
+        }
+        m_Written.store(index + 1, std::memory_order_release);
+    }
+
+    // Appends the events still in the ring to out, oldest first.
+    void Copy(std::vector<Event> &out) const
+    {
+        uint64 cursor = 0;
+        CopySince(cursor, out);
+    }
+
+    /// <summary>
+    /// Appends the events written since cursor, the count of events written when last called, and
+    /// moves cursor past them. Returns how many of those were overwritten before they were read.
+    /// </summary>
+    uint64 CopySince(uint64 &cursor, std::vector<Event> &out) const
+    {
+        uint64 const written = m_Written.load(std::memory_order_acquire);
+        uint64 const first = std::max(cursor, written > m_Capacity ? written - m_Capacity : 0);
+        uint64 lost = first - cursor;
+        cursor = written;
+        usz const start = out.size();
+        for (uint64 index = first; index < written; ++index)
+        {
+            std::atomic<uint64> const *slot = &m_Words[(index & (m_Capacity - 1)) * Words];
+            Event &event = out.emplace_back();
+            for (usz i = 0; i < Words; ++i)
+            {
+                event[i] = slot[i].load(std::memory_order_relaxed);
+            }
+        }
+        // An index is safe unless the writer has reached, or is writing, the one a lap after it.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64 const after = m_Written.load(std::memory_order_relaxed);
+        if (after >= first + m_Capacity)
+        {
+            usz const torn = std::min<usz>(after - m_Capacity + 1 - first, written - first);
+            out.erase(out.begin() + start, out.begin() + start + torn);
+            lost += torn;
+        }
+        return lost;
+    }
+
+    // Events written since the ring was made, including those since overwritten.
+    uint64 GetWrittenCount() const { return m_Written.load(std::memory_order_acquire); }
+
+    // The index of the oldest event not yet overwritten, for a cursor to read all that's kept.
+    uint64 GetFirstKept() const
+    {
+        uint64 const written = GetWrittenCount();
+        return written > m_Capacity ? written - m_Capacity : 0;
+    }
+
+    /// <summary>
+    /// The index of the first event kept whose word is at least value, for a cursor to read from,
+    /// when events are written in order of that word. Racing the writer can only make it earlier,
+    /// and CopySince still drops what was overwritten.
+    /// </summary>
+    uint64 FindFirstAtLeast(usz word, uint64 value) const
+    {
+        LAT_ASSERT(word < Words);
+        uint64 const written = GetWrittenCount();
+        uint64 low = written > m_Capacity ? written - m_Capacity : 0;
+        uint64 high = written;
+        while (low < high)
+        {
+            uint64 const middle = low + (high - low) / 2;
+            std::atomic<uint64> const &slot = m_Words[(middle & (m_Capacity - 1)) * Words + word];
+            if (slot.load(std::memory_order_relaxed) < value)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+private:
+    std::unique_ptr<std::atomic<uint64>[]> m_Words;
+    usz m_Capacity;
+    std::atomic<uint64> m_Written = 0;
+};
+
+export enum class HardwareCounter : uint8 {
+    Cycles,
+    Instructions,
+    L1DMisses,
+    LLCMisses,
+    BranchMisses,
+    Count
+};
+
+export constexpr usz k_HardwareCounterCount = static_cast<usz>(HardwareCounter::Count);
+
+export constexpr char const *HardwareCounterName(HardwareCounter counter)
+{
+    switch (counter)
+    {
+    case HardwareCounter::Cycles: return "Cycles";
+    case HardwareCounter::Instructions: return "Instructions";
+    case HardwareCounter::L1DMisses: return "L1D misses";
+    case HardwareCounter::LLCMisses: return "LLC misses";
+    case HardwareCounter::BranchMisses: return "Branch misses";
+    default: return "Unknown";
+    }
+}
+
+// Indexed by HardwareCounter.
+export using HardwareCounters = std::array<uint64, k_HardwareCounterCount>;
+
+/// <summary>
+/// Reads the calling thread's hardware counters, as counted since some fixed point in the past.
+/// Returns false if they can't be read on this thread. Counters that can't be read at all stay 0.
+/// </summary>
+export using HardwareCounterReader = bool (*)(HardwareCounters &countersOut);
+
+std::atomic<HardwareCounterReader> &GetHardwareCounterReaderSlot()
+{
+    static std::atomic<HardwareCounterReader> reader = nullptr;
+    return reader;
+}
+
+// Lets LAT_PROFILE_ZONE_COUNTERS read hardware counters. Set by a platform that has them, such as
+// Platform::PerfCounters::Enable on Linux; nullptr turns them off again.
+export void SetHardwareCounterReader(HardwareCounterReader reader)
+{
+    GetHardwareCounterReaderSlot().store(reader, std::memory_order_release);
+}
+
+export bool ReadHardwareCounters(HardwareCounters &countersOut)
+{
+    HardwareCounterReader const reader =
+        GetHardwareCounterReaderSlot().load(std::memory_order_acquire);
+    return reader != nullptr && reader(countersOut);
+}
+
+// Zones each thread keeps, the oldest being overwritten first. 32 bytes each.
+constexpr usz k_ZonesPerThread = 16 * 1024;
+// Zones with hardware counters each thread keeps, apart from the others. 72 bytes each.
+constexpr usz k_CountedZonesPerThread = 4 * 1024;
+
+export struct ZoneRecord
+{
+    ZoneSite const *Site;
+    uint64 Begin;
+    uint64 End;
+    // How many zones were open around this one on its thread.
+    uint32 Depth;
+    // Whether Counters holds how much each hardware counter went up during the zone.
+    bool HasCounters = false;
+    HardwareCounters Counters{};
+};
+
+// Where reading a thread's zones got to, in both of its rings.
+struct ZoneCursor
+{
+    uint64 Plain = 0;
+    uint64 Counted = 0;
+};
+
+// Counter samples each thread keeps. 24 bytes each.
+constexpr usz k_CounterSamplesPerThread = 4 * 1024;
+
+export struct CounterSample
+{
+    // A string literal, or anything else that outlives the program's profiling.
+    char const *Name;
+    uint64 Ticks;
+    double Value;
+};
+
+// One thread's zones.
+class ThreadZones
+{
+public:
+    ThreadZones(uint32 index, std::thread::id id) : m_Index(index), m_Id(id) {}
+
+    // Hands the rings of a thread that has exited to a new one. What the old thread recorded stays
+    // in them for TraceWriter to finish draining, but CopyZones only returns the new thread's.
+    void Reuse(std::thread::id id)
+    {
+        m_Id = id;
+        m_Depth = 0;
+        m_First = {m_Zones.GetWrittenCount(), m_CountedZones.GetWrittenCount()};
+        Name.clear();
+    }
+
+    void Enter() { m_Depth++; }
+
+    void Leave(ZoneSite const *site, uint64 begin, uint64 end)
+    {
+        // A zone left open across a fiber switch can end on a different thread.
+        m_Depth = m_Depth == 0 ? 0 : m_Depth - 1;
+        m_Zones.Push({reinterpret_cast<uintptr_t>(site), begin, end, m_Depth});
+    }
+
+    void Leave(ZoneSite const *site, uint64 begin, uint64 end, HardwareCounters const &counters)
+    {
+        m_Depth = m_Depth == 0 ? 0 : m_Depth - 1;
+        EventRing<9>::Event event{reinterpret_cast<uintptr_t>(site), begin, end, m_Depth};
+        std::copy(counters.begin(), counters.end(), event.begin() + 4);
+        m_CountedZones.Push(event);
+    }
+
+    void Sample(char const *name, uint64 ticks, double value)
+    {
+        m_Counters.Push({reinterpret_cast<uintptr_t>(name), ticks, std::bit_cast<uint64>(value)});
+    }
+
+    // Copies the zones kept that ended at or after sinceTicks. Zones are written as they end, so
+    // the rest are skipped without being read.
+    void CopyZones(uint64 sinceTicks, std::vector<ZoneRecord> &out) const
+    {
+        ZoneCursor cursor{
+            std::max(m_First.Plain, m_Zones.FindFirstAtLeast(k_EndWord, sinceTicks)),
+            std::max(m_First.Counted, m_CountedZones.FindFirstAtLeast(k_EndWord, sinceTicks))};
+        CopyZonesSince(cursor, out);
+    }
+
+    // As EventRing::CopySince, for zones with and without hardware counters, merged in order.
+    uint64 CopyZonesSince(ZoneCursor &cursor, std::vector<ZoneRecord> &out) const
+    {
+        std::vector<EventRing<4>::Event> events;
+        std::vector<EventRing<9>::Event> countedEvents;
+        uint64 const lost = m_Zones.CopySince(cursor.Plain, events) +
+                            m_CountedZones.CopySince(cursor.Counted, countedEvents);
+        usz const start = out.size();
+        out.reserve(start + events.size() + countedEvents.size());
+        for (EventRing<4>::Event const &event : events)
+        {
+            out.push_back({reinterpret_cast<ZoneSite const *>(static_cast<uintptr_t>(event[0])),
+                           event[1], event[2], static_cast<uint32>(event[3])});
+        }
+        usz const middle = out.size();
+        for (EventRing<9>::Event const &event : countedEvents)
+        {
+            ZoneRecord &zone = out.emplace_back();
+            zone.Site = reinterpret_cast<ZoneSite const *>(static_cast<uintptr_t>(event[0]));
+            zone.Begin = event[1];
+            zone.End = event[2];
+            zone.Depth = static_cast<uint32>(event[3]);
+            zone.HasCounters = true;
+            std::copy(event.begin() + 4, event.end(), zone.Counters.begin());
+        }
+        std::inplace_merge(out.begin() + start, out.begin() + middle, out.end(),
+                           [](ZoneRecord const &a, ZoneRecord const &b) { return a.End < b.End; });
+        return lost;
+    }
+
+    // As EventRing::CopySince, for counter samples.
+    uint64 CopyCountersSince(uint64 &cursor, std::vector<CounterSample> &out) const
+    {
+        std::vector<EventRing<3>::Event> events;
+        uint64 const lost = m_Counters.CopySince(cursor, events);
+        out.reserve(out.size() + events.size());
+        for (EventRing<3>::Event const &event : events)
+        {
+            out.push_back({reinterpret_cast<char const *>(static_cast<uintptr_t>(event[0])),
+                           event[1], std::bit_cast<double>(event[2])});
+        }
+        return lost;
+    }
+
+    EventRing<4> const &GetZones() const { return m_Zones; }
+    EventRing<9> const &GetCountedZones() const { return m_CountedZones; }
+    EventRing<3> const &GetCounters() const { return m_Counters; }
+
+    uint32 GetIndex() const { return m_Index; }
+    std::thread::id GetId() const { return m_Id; }
+
+    // Guarded by the registry's mutex.
+    std::string Name;
+
+private:
+    // Zone events are the site, begin, end and depth, then any counters.
+    static constexpr usz k_EndWord = 2;
+
+    EventRing<4> m_Zones{k_ZonesPerThread};
+    EventRing<9> m_CountedZones{k_CountedZonesPerThread};
+    EventRing<3> m_Counters{k_CounterSamplesPerThread};
+    uint32 m_Index;
+    std::thread::id m_Id;
+    // Where the thread using the rings now started writing to them.
+    ZoneCursor m_First;
+    // Only touched by the owning thread.
+    uint32 m_Depth = 0;
+};
+
+// Threads that have exited whose zones are kept for captures. Past this, a new thread takes over
+// the rings of the one that exited longest ago, so threads coming and going don't use up memory.
+constexpr usz k_ExitedThreadsKept = 8;
+
+// Every thread that has profiled anything. Threads' zones are kept after they exit, so a capture
+// still shows them, until k_ExitedThreadsKept more have exited.
+class ThreadRegistry
+{
+public:
+    static ThreadRegistry &Get()
+    {
+        // Never destroyed: threads may still be profiling while statics are torn down.
+        static ThreadRegistry *registry = new ThreadRegistry;
+        return *registry;
+    }
+
+    ThreadZones *Add()
+    {
+        GetTickStart();
+        std::lock_guard lock(m_Mutex);
+        if (m_Exited.size() > k_ExitedThreadsKept)
+        {
+            ThreadZones *thread = m_Exited.front();
+            m_Exited.erase(m_Exited.begin());
+            thread->Reuse(std::this_thread::get_id());
+            return thread;
+        }
+        auto index = static_cast<uint32>(m_Threads.size());
+        m_Threads.push_back(std::make_unique<ThreadZones>(index, std::this_thread::get_id()));
+        return m_Threads.back().get();
+    }
+
+    void Exit(ThreadZones *thread)
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Exited.push_back(thread);
+    }
+
+    void Rename(ThreadZones &thread, std::string_view name)
+    {
+        std::lock_guard lock(m_Mutex);
+        thread.Name = name;
+    }
+
+    template <typename Function> void ForEach(Function &&function)
+    {
+        std::lock_guard lock(m_Mutex);
+        for (std::unique_ptr<ThreadZones> const &thread : m_Threads)
+        {
+            function(*thread);
+        }
+    }
+
+private:
+    std::mutex m_Mutex;
+    std::vector<std::unique_ptr<ThreadZones>> m_Threads;
+    // Oldest first.
+    std::vector<ThreadZones *> m_Exited;
+};
+
+// Gives the thread's zones back to the registry as it exits.
+struct ThreadZonesOwner
+{
+    ~ThreadZonesOwner()
+    {
+        if (Zones != nullptr)
+        {
+            ThreadRegistry::Get().Exit(Zones);
+            // Another thread may be given them now, so nothing here can write to them again.
+            Zones = nullptr;
+        }
+    }
+
+    ThreadZones *Zones = nullptr;
+};
+
+thread_local ThreadZonesOwner t_Zones;
+
+// Zones are recorded from jobs, so see JobSystem::CurrentThread for why this isn't inlined.
+LAT_NOINLINE ThreadZones *GetThreadZones()
+{
+    if (t_Zones.Zones == nullptr)
+    {
+        t_Zones.Zones = ThreadRegistry::Get().Add();
+    }
+    return t_Zones.Zones;
+}
+
+/// <summary>
+/// Times its own lifetime as a zone on the calling thread, nested in any zones already open
+/// there. Made by LAT_PROFILE_ZONE rather than directly.
+/// </summary>
+export class ScopedZone
+{
+public:
+    explicit ScopedZone(ZoneSite const *site) : m_Site(site)
+    {
+        GetThreadZones()->Enter();
+        m_Begin = GetTicks();
+    }
+
+    ~ScopedZone() { GetThreadZones()->Leave(m_Site, m_Begin, GetTicks()); }
+
+    ScopedZone(ScopedZone const &) = delete;
+    ScopedZone &operator=(ScopedZone const &) = delete;
+
+private:
+    ZoneSite const *m_Site;
+    uint64 m_Begin;
+};
+
+/// <summary>
+/// As ScopedZone, also recording how much each hardware counter went up during the zone when a
+/// HardwareCounterReader is set. Reading them costs a system call or two at either end, so it's
+/// for zones that run for microseconds or more. Made by LAT_PROFILE_ZONE_COUNTERS.
+/// </summary>
+export class ScopedCountedZone
+{
+public:
+    explicit ScopedCountedZone(ZoneSite const *site) : m_Site(site)
+    {
+        m_Thread = GetThreadZones();
+        m_Thread->Enter();
+        m_Counted = ReadHardwareCounters(m_Counters);
+        m_Begin = GetTicks();
+    }
+
+    ~ScopedCountedZone()
+    {
+        uint64 const end = GetTicks();
+        ThreadZones *thread = GetThreadZones();
+        HardwareCounters counters;
+        // Counters belong to a thread, so a zone whose fiber moved thread only keeps its time.
+        if (m_Counted && thread == m_Thread && ReadHardwareCounters(counters))
+        {
+            for (usz i = 0; i < k_HardwareCounterCount; ++i)
+            {
+                counters[i] -= m_Counters[i];
+            }
+            thread->Leave(m_Site, m_Begin, end, counters);
+        }
+        else
+        {
+            thread->Leave(m_Site, m_Begin, end);
+        }
+    }
+
+    ScopedCountedZone(ScopedCountedZone const &) = delete;
+    ScopedCountedZone &operator=(ScopedCountedZone const &) = delete;
+
+private:
+    ZoneSite const *m_Site;
+    ThreadZones *m_Thread;
+    HardwareCounters m_Counters;
+    bool m_Counted;
+    uint64 m_Begin;
+};
+
+// Records a value of the counter called name at this moment. Made by LAT_PROFILE_COUNTER.
+export void SampleCounter(char const *name, double value)
+{
+    GetThreadZones()->Sample(name, GetTicks(), value);
+}
+
+// Names the calling thread in captures.
+export void SetThreadName(std::string_view name)
+{
+    ThreadRegistry::Get().Rename(*GetThreadZones(), name);
+}
+
+export struct ThreadCapture
+{
+    // Numbers threads in the order they first profiled anything. A thread given the rings of one
+    // that exited takes its number too.
+    uint32 Index = 0;
+    std::string Name;
+    // Ordered by End, so a zone comes after the zones nested in it.
+    std::vector<ZoneRecord> Zones;
+};
+
+// Copies the zones every thread still has that ended at or after sinceTicks, without stopping
+// them. Each thread keeps thousands, so pass sinceTicks when only the latest are wanted.
+export std::vector<ThreadCapture> CaptureZones(uint64 sinceTicks = 0)
+{
+    std::vector<ThreadCapture> captures;
+    ThreadRegistry::Get().ForEach([&captures, sinceTicks](ThreadZones &thread) {
+        ThreadCapture &capture = captures.emplace_back();
+        capture.Index = thread.GetIndex();
+        capture.Name = thread.Name;
+        thread.CopyZones(sinceTicks, capture.Zones);
+    });
+    return captures;
+}
+
+// Frame starts kept, the oldest being overwritten first.
+constexpr usz k_FramesKept = 1024;
+
+EventRing<1> &GetFrameRing()
+{
+    static EventRing<1> frames(k_FramesKept);
+    return frames;
+}
+
+// Marks the start of a frame. Called from one thread, by iWindow::NewFrame.
+export void MarkFrame()
+{
+    GetTickStart();
+    GetFrameRing().Push({GetTicks()});
+}
+
+// The start of each frame still kept, oldest first.
+export std::vector<uint64> CaptureFrames()
+{
+    std::vector<EventRing<1>::Event> events;
+    GetFrameRing().Copy(events);
+    std::vector<uint64> frames;
+    frames.reserve(events.size());
+    for (EventRing<1>::Event const &event : events)
+    {
+        frames.push_back(event[0]);
+    }
+    return frames;
+}
+
+/// <summary>
+/// Sorts the frames between consecutive starts, as from CaptureFrames, into bucketCount buckets
+/// of bucketMilliseconds each by how long they took. The last bucket also counts every frame
+/// longer than the rest cover.
+/// </summary>
+export std::vector<uint32> HistogramFrameTimes(std::vector<uint64> const &frames,
+                                              double bucketMilliseconds, usz bucketCount)
+{
+    LAT_ASSERT(bucketMilliseconds > 0.0 && bucketCount > 0);
+    std::vector<uint32> buckets(bucketCount, 0);
+    for (usz i = 1; i < frames.size(); ++i)
+    {
+        double const milliseconds = TicksToMilliseconds(frames[i] - frames[i - 1]);
+        auto const bucket = static_cast<usz>(milliseconds / bucketMilliseconds);
+        buckets[std::min(bucket, bucketCount - 1)]++;
+    }
+    return buckets;
+}
+
+/// <summary>
+/// Streams everything profiled after it's made to out as a Chrome Trace Event JSON document,
+/// which chrome://tracing and the Perfetto UI both open. Each Drain writes the zones, counter
+/// samples and frame starts recorded since the one before, so however long the capture, the rings
+/// only have to hold what happens between drains; anything overwritten sooner is counted by
+/// GetLostCount instead of written.
+///
+/// Given sinceTicks, it starts from what the rings still keep from then instead, so the moments
+/// before something worth saving can be written after it happens.
+///
+/// Drain from one thread at a time, e.g. once a frame.
+/// </summary>
+export class TraceWriter
+{
+public:
+    explicit TraceWriter(std::ostream &out) : TraceWriter(out, GetTicks(), false) {}
+
+    TraceWriter(std::ostream &out, uint64 sinceTicks) : TraceWriter(out, sinceTicks, true) {}
+
+    TraceWriter(TraceWriter const &) = delete;
+    TraceWriter &operator=(TraceWriter const &) = delete;
+
+    void Drain()
+    {
+        struct ThreadEvents
+        {
+            uint32 Index;
+            std::string Name;
+            std::vector<ZoneRecord> Zones;
+            std::vector<CounterSample> Counters;
+        };
+        // Copied under the registry's lock, written after it so new threads aren't kept waiting.
+        std::vector<ThreadEvents> threads;
+        ThreadRegistry::Get().ForEach([this, &threads](ThreadZones &thread) {
+            ThreadCursor &cursor = GetCursor(thread.GetIndex());
+            ThreadEvents &events = threads.emplace_back();
+            events.Index = thread.GetIndex();
+            m_Lost += thread.CopyZonesSince(cursor.Zones, events.Zones);
+            m_Lost += thread.CopyCountersSince(cursor.Counters, events.Counters);
+            // Threads are named once they have something to show, and again if renamed.
+            bool const hasEvents = !events.Zones.empty() || !events.Counters.empty();
+            if (cursor.NameWritten ? cursor.Name != thread.Name : hasEvents)
+            {
+                cursor.Name = thread.Name;
+                cursor.NameWritten = true;
+                events.Name = thread.Name.empty()
+                                  ? "Thread " + std::to_string(thread.GetIndex())
+                                  : thread.Name;
+            }
+        });
+
+        for (ThreadEvents const &events : threads)
+        {
+            if (!events.Name.empty())
+            {
+                BeginEvent("thread_name", "M", events.Index);
+                m_Out << ",\"args\":{\"name\":";
+                WriteString(events.Name);
+                m_Out << "}}";
+            }
+            for (ZoneRecord const &zone : events.Zones)
+            {
+                // Cursors can start before the writer does: for threads that started profiling
+                // after it was made, or when writing from sinceTicks.
+                if (zone.Begin < m_StartTicks)
+                {
+                    continue;
+                }
+                BeginEvent(zone.Site->Name, "X", events.Index);
+                WriteTime(",\"ts\":", zone.Begin);
+                m_Out << ",\"dur\":";
+                WriteNumber(static_cast<double>(zone.End - zone.Begin) / m_TicksPerMicrosecond);
+                if (zone.HasCounters)
+                {
+                    WriteHardwareCounters(zone.Counters);
+                }
+                m_Out << '}';
+            }
+            for (CounterSample const &sample : events.Counters)
+            {
+                if (sample.Ticks < m_StartTicks)
+                {
+                    continue;
+                }
+                BeginEvent(sample.Name, "C", events.Index);
+                WriteTime(",\"ts\":", sample.Ticks);
+                m_Out << ",\"args\":{\"value\":";
+                WriteNumber(sample.Value);
+                m_Out << "}}";
+            }
+        }
+
+        std::vector<EventRing<1>::Event> frames;
+        m_Lost += GetFrameRing().CopySince(m_FrameCursor, frames);
+        for (EventRing<1>::Event const &frame : frames)
+        {
+            if (frame[0] < m_StartTicks)
+            {
+                continue;
+            }
+            BeginEvent("Frame", "i", 0);
+            WriteTime(",\"ts\":", frame[0]);
+            m_Out << ",\"s\":\"g\"}";
+        }
+    }
+
+    // Drains one last time and closes the document. Nothing can be written after.
+    void Finish()
+    {
+        LAT_ASSERT(!m_Finished);
+        Drain();
+        m_Out << "\n]}\n";
+        m_Out.flush();
+        m_Finished = true;
+    }
+
+    // Events overwritten in their rings before a drain reached them.
+    uint64 GetLostCount() const { return m_Lost; }
+
+    uint64 GetWrittenCount() const { return m_Written; }
+
+private:
+    TraceWriter(std::ostream &out, uint64 startTicks, bool fromKept)
+        : m_Out(out), m_StartTicks(startTicks),
+          m_TicksPerMicrosecond(static_cast<double>(GetTicksPerSecond()) / 1'000'000.0)
+    {
+        auto const start = [fromKept](auto const &ring) {
+            return fromKept ? ring.GetFirstKept() : ring.GetWrittenCount();
+        };
+        ThreadRegistry::Get().ForEach([this, &start](ThreadZones &thread) {
+            ThreadCursor &cursor = GetCursor(thread.GetIndex());
+            cursor.Zones.Plain = start(thread.GetZones());
+            cursor.Zones.Counted = start(thread.GetCountedZones());
+            cursor.Counters = start(thread.GetCounters());
+        });
+        m_FrameCursor = start(GetFrameRing());
+        m_Out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    }
+
+    struct ThreadCursor
+    {
+        ZoneCursor Zones;
+        uint64 Counters = 0;
+        std::string Name;
+        bool NameWritten = false;
+    };
+
+    ThreadCursor &GetCursor(uint32 index)
+    {
+        if (index >= m_Cursors.size())
+        {
+            m_Cursors.resize(index + 1);
+        }
+        return m_Cursors[index];
+    }
+
+    // Writes the fields every event has, leaving the object open for the rest.
+    void BeginEvent(char const *name, char const *phase, uint32 thread)
+    {
+        LAT_ASSERT(!m_Finished);
+        m_Out << (m_Written == 0 ? "\n{\"name\":" : ",\n{\"name\":");
+        WriteString(name);
+        m_Out << ",\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << thread;
+        m_Written++;
+    }
+
+    // Microseconds since the writer was made.
+    void WriteTime(char const *key, uint64 ticks)
+    {
+        m_Out << key;
+        WriteNumber(static_cast<double>(ticks - m_StartTicks) / m_TicksPerMicrosecond);
+    }
+
+    // As args, with instructions per cycle worked out.
+    void WriteHardwareCounters(HardwareCounters const &counters)
+    {
+        m_Out << ",\"args\":{";
+        for (usz i = 0; i < k_HardwareCounterCount; ++i)
+        {
+            WriteString(HardwareCounterName(static_cast<HardwareCounter>(i)));
+            m_Out << ':' << counters[i] << ',';
+        }
+        auto const cycles = counters[static_cast<usz>(HardwareCounter::Cycles)];
+        auto const instructions = counters[static_cast<usz>(HardwareCounter::Instructions)];
+        m_Out << "\"IPC\":";
+        WriteNumber(cycles == 0 ? 0.0
+                                : static_cast<double>(instructions) / static_cast<double>(cycles));
+        m_Out << '}';
+    }
+
+    void WriteNumber(double value)
+    {
+        // JSON has no infinity or NaN.
+        if (!std::isfinite(value))
+        {
+            value = 0.0;
+        }
+        char buffer[64];
+        auto const result =
+            std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 3);
+        m_Out.write(buffer, result.ptr - buffer);
+    }
+
+    void WriteString(std::string_view text)
+    {
+        m_Out << '"';
+        for (char const c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                m_Out << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                constexpr char k_Hex[] = "0123456789abcdef";
+                m_Out << "\\u00" << k_Hex[c >> 4] << k_Hex[c & 0xF];
+            }
+            else
+            {
+                m_Out << c;
+            }
+        }
+        m_Out << '"';
+    }
+
+    std::ostream &m_Out;
+    uint64 m_StartTicks;
+    double m_TicksPerMicrosecond;
+    std::vector<ThreadCursor> m_Cursors;
+    uint64 m_FrameCursor = 0;
+    uint64 m_Written = 0;
+    uint64 m_Lost = 0;
+    bool m_Finished = false;
+};
+} // namespace Lateralus::Core::Profile
@@ -1,48 +1,509 @@
+module;
+
+#include <Core.Assert.h>
+
 export module Lateralus.Core.Quaternion;
 
+import <span>;
+import <type_traits>;
+
+import Lateralus.Core;
+import Lateralus.Core.Math;
 import Lateralus.Core.Matrix;
+import Lateralus.Core.SIMD;
 import Lateralus.Core.Vector;
 
 namespace Lateralus::Core
 {
-export struct Quaternion
+// A rotation quaternion stored as (i, j, k, r) where r is the real (scalar) part.
+// Angles are in degrees to match Matrix4x4::CreateRotation, and ToMatrix produces the same
+// column-vector convention (transform with matrix * vector).
+// Aligned so the four components can be loaded straight into a SIMD register. Like Vector4, every
+// non-batch operation also has a scalar path so it can be used in constant expressions.
+export struct alignas(16) Quaternion
 {
     ~Quaternion() = default;
-    Quaternion() = default;
-    Quaternion(Quaternion const &) = default;
-    Quaternion &operator=(Quaternion const &) = default;
-    static Quaternion FromAxisAngle(Vector3 const &axis, float angle) { return Quaternion(); }
-    static Quaternion FromEuler(Vector3 const &angles) { return Quaternion(); }
+    constexpr Quaternion() = default;
+    constexpr Quaternion(float i, float j, float k, float r) : i(i), j(j), k(k), r(r) {}
+    constexpr Quaternion(Quaternion const &) = default;
+    constexpr Quaternion &operator=(Quaternion const &) = default;
 
-    Quaternion operator+(Quaternion const &other) const { return Quaternion(); }
+    static constexpr Quaternion FromAxisAngle(Vector3 const &axis, float angle)
+    {
+        Vector3 const unitAxis = axis.Normalized();
+        float sinHalf, cosHalf;
+        SinCos<Precision::Precise>(0.5f * angle * Deg2Rad, sinHalf, cosHalf);
+        return Quaternion(unitAxis.x * sinHalf, unitAxis.y * sinHalf, unitAxis.z * sinHalf,
+                          cosHalf);
+    }
+
+    // Rotation about x, then y, then z. Equivalent to Matrix4x4::CreateRotation(angles).
+    static constexpr Quaternion FromEuler(Vector3 const &angles)
+    {
+        float sin[4] = {}, cos[4] = {};
+        if (std::is_constant_evaluated())
+        {
+            SinCos(0.5f * angles.x * Deg2Rad, sin[0], cos[0]);
+            SinCos(0.5f * angles.y * Deg2Rad, sin[1], cos[1]);
+            SinCos(0.5f * angles.z * Deg2Rad, sin[2], cos[2]);
+        }
+        else
+        {
+            SIMD::Float4 sines, cosines;
+            SIMD::Float4 const halfAngles = SIMD::Set(angles.x, angles.y, angles.z, 0.0f);
+            SinCos<Precision::Precise>(SIMD::Mul(halfAngles, SIMD::Splat(0.5f * Deg2Rad)), sines,
+                                       cosines);
+            SIMD::StoreUnaligned(sin, sines);
+            SIMD::StoreUnaligned(cos, cosines);
+        }
+        float const sx = sin[0], sy = sin[1], sz = sin[2];
+        float const cx = cos[0], cy = cos[1], cz = cos[2];
 
-    Quaternion operator*(float scalar) const { return Quaternion(); }
-    Quaternion operator-() const { return Quaternion(); }
+        // qz * qy * qx expanded.
+        return Quaternion(sx * cy * cz - cx * sy * sz, cx * sy * cz + sx * cy * sz,
+                          cx * cy * sz - sx * sy * cz, cx * cy * cz + sx * sy * sz);
+    }
 
-    float Length() const { return 0.0f; }
-    float LengthSquared() const { return 0.0f; }
-    Quaternion Normalized() const { return Quaternion(); }
-    Quaternion &Normalize() { return *this; }
+    constexpr Quaternion operator+(Quaternion const &other) const
+    {
+        if (std::is_constant_evaluated())
+        {
+            return Quaternion(i + other.i, j + other.j, k + other.k, r + other.r);
+        }
+        return FromSIMD(SIMD::Add(ToSIMD(), other.ToSIMD()));
+    }
 
-    Matrix4x4 ToMatrix() const { return Matrix4x4(); }
+    constexpr Quaternion operator-(Quaternion const &other) const
+    {
+        if (std::is_constant_evaluated())
+        {
+            return Quaternion(i - other.i, j - other.j, k - other.k, r - other.r);
+        }
+        return FromSIMD(SIMD::Sub(ToSIMD(), other.ToSIMD()));
+    }
 
-    static Quaternion Invert(Quaternion const &quat) { return Quaternion(); }
-    static float DotProduct(Quaternion const &left, Quaternion const &right) { return 0.0f; }
-    static Quaternion Lerp(Quaternion const &start, Quaternion const &end, float t)
+    constexpr Quaternion operator*(float scalar) const
     {
-        return Quaternion();
+        if (std::is_constant_evaluated())
+        {
+            return Quaternion(i * scalar, j * scalar, k * scalar, r * scalar);
+        }
+        return FromSIMD(SIMD::Mul(ToSIMD(), SIMD::Splat(scalar)));
+    }
+
+    constexpr Quaternion operator-() const
+    {
+        if (std::is_constant_evaluated())
+        {
+            return Quaternion(-i, -j, -k, -r);
+        }
+        return FromSIMD(SIMD::Negate(ToSIMD()));
+    }
+
+    // Hamilton product: the result applies other first, then this.
+    constexpr Quaternion operator*(Quaternion const &other) const
+    {
+        if (std::is_constant_evaluated())
+        {
+            return Quaternion(r * other.i + i * other.r + j * other.k - k * other.j,
+                              r * other.j - i * other.k + j * other.r + k * other.i,
+                              r * other.k + i * other.j - j * other.i + k * other.r,
+                              r * other.r - i * other.i - j * other.j - k * other.k);
+        }
+
+        SIMD::Float4 const a = ToSIMD();
+        SIMD::Float4 const b = other.ToSIMD();
+
+        // r1 * b + i1 * (r2, -k2, j2, -i2) + j1 * (k2, r2, -i2, -j2) + k1 * (-j2, i2, r2, -k2)
+        SIMD::Float4 const signI = SIMD::Set(1.0f, -1.0f, 1.0f, -1.0f);
+        SIMD::Float4 const signJ = SIMD::Set(1.0f, 1.0f, -1.0f, -1.0f);
+        SIMD::Float4 const signK = SIMD::Set(-1.0f, 1.0f, 1.0f, -1.0f);
+
+        SIMD::Float4 result = SIMD::Mul(SIMD::Broadcast<3>(a), b);
+        result = SIMD::MulAdd(SIMD::Broadcast<0>(a),
+                              SIMD::Mul(SIMD::Shuffle<3, 2, 1, 0>(b), signI), result);
+        result = SIMD::MulAdd(SIMD::Broadcast<1>(a),
+                              SIMD::Mul(SIMD::Shuffle<2, 3, 0, 1>(b), signJ), result);
+        result = SIMD::MulAdd(SIMD::Broadcast<2>(a),
+                              SIMD::Mul(SIMD::Shuffle<1, 0, 3, 2>(b), signK), result);
+        return FromSIMD(result);
+    }
+
+    constexpr Quaternion &operator*=(Quaternion const &other)
+    {
+        *this = *this * other;
+        return *this;
+    }
+
+    // Rotates v by this (unit) quaternion.
+    constexpr Vector3 Rotate(Vector3 const &v) const
+    {
+        // v + r * t + u x t where u = (i, j, k) and t = 2 * (u x v)
+        Vector3 const u(i, j, k);
+        Vector3 const t = u.Cross(v) * Vector3(2.0f, 2.0f, 2.0f);
+        return v + t * Vector3(r, r, r) + u.Cross(t);
     }
-    static Quaternion Slerp(Quaternion const &start, Quaternion const &end, float t)
+
+    constexpr float Length() const { return Sqrt(LengthSquared()); }
+    constexpr float LengthSquared() const { return DotProduct(*this, *this); }
+
+    constexpr Quaternion Normalized() const
     {
+        float const l = Length();
+        if (l != 0.0f && std::is_constant_evaluated())
+        {
+            return Quaternion(i / l, j / l, k / l, r / l);
+        }
+        if (l != 0.0f)
+        {
+            return FromSIMD(SIMD::Div(ToSIMD(), SIMD::Splat(l)));
+        }
         return Quaternion();
     }
 
-    bool RoughlyEqual(Quaternion const &other) { return false; }
-    bool ExactlyEqual(Quaternion const &other) { return false; }
+    constexpr Quaternion &Normalize()
+    {
+        *this = Normalized();
+        return *this;
+    }
+
+    // The conjugate. For unit quaternions this is also the inverse.
+    constexpr Quaternion Conjugate() const { return Quaternion(-i, -j, -k, r); }
+
+    constexpr Matrix4x4 ToMatrix() const
+    {
+        float const x2 = i + i, y2 = j + j, z2 = k + k;
+        float const xx = i * x2, yy = j * y2, zz = k * z2;
+        float const xy = i * y2, xz = i * z2, yz = j * z2;
+        float const wx = r * x2, wy = r * y2, wz = r * z2;
+
+        return Matrix4x4(1.0f - (yy + zz), xy - wz, xz + wy, 0.0f,
+                         xy + wz, 1.0f - (xx + zz), yz - wx, 0.0f,
+                         xz - wy, yz + wx, 1.0f - (xx + yy), 0.0f,
+                         0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    static constexpr Quaternion Invert(Quaternion const &quat)
+    {
+        float const lengthSq = quat.LengthSquared();
+        if (lengthSq == 0.0f)
+        {
+            return Quaternion();
+        }
+        return quat.Conjugate() * (1.0f / lengthSq);
+    }
+
+    static constexpr float DotProduct(Quaternion const &left, Quaternion const &right)
+    {
+        if (std::is_constant_evaluated())
+        {
+            // Summed in the same order as SIMD::Dot without SSE4.1.
+            return (left.i * right.i + left.k * right.k) + (left.j * right.j + left.r * right.r);
+        }
+        return SIMD::Dot(left.ToSIMD(), right.ToSIMD());
+    }
+
+    // Component-wise interpolation. Not normalized: see NLerp for a rotation blend.
+    static constexpr Quaternion Lerp(Quaternion const &start, Quaternion const &end, float t)
+    {
+        if (std::is_constant_evaluated())
+        {
+            return start + (end - start) * t;
+        }
+        SIMD::Float4 const a = start.ToSIMD();
+        return FromSIMD(SIMD::MulAdd(SIMD::Sub(end.ToSIMD(), a), SIMD::Splat(t), a));
+    }
+
+    // Normalized lerp along the shortest arc. Cheaper than Slerp with a non-constant velocity.
+    static constexpr Quaternion NLerp(Quaternion const &start, Quaternion const &end, float t)
+    {
+        if (std::is_constant_evaluated())
+        {
+            Quaternion const shortest = DotProduct(start, end) < 0.0f ? -end : end;
+            return (start * (1.0f - t) + shortest * t).Normalized();
+        }
+        SIMD::Float4 const a = start.ToSIMD();
+        SIMD::Float4 const b = end.ToSIMD();
+        SIMD::Float4 const shortest = SIMD::FlipSign(b, SIMD::Splat(SIMD::Dot(a, b)));
+        SIMD::Float4 const blended =
+            SIMD::Add(SIMD::Mul(a, SIMD::Splat(1.0f - t)), SIMD::Mul(shortest, SIMD::Splat(t)));
+        return FromSIMD(blended).Normalized();
+    }
+
+    // Constant velocity interpolation along the shortest arc.
+    static constexpr Quaternion Slerp(Quaternion const &start, Quaternion const &end, float t)
+    {
+        if (std::is_constant_evaluated())
+        {
+            float const cosTheta = DotProduct(start, end);
+            Quaternion const shortest = cosTheta < 0.0f ? -end : end;
+            float weightA = 0.0f, weightB = 0.0f;
+            SlerpWeights(Abs(cosTheta), t, weightA, weightB);
+            return start * weightA + shortest * weightB;
+        }
+        SIMD::Float4 const a = start.ToSIMD();
+        SIMD::Float4 b = end.ToSIMD();
+        float cosTheta = SIMD::Dot(a, b);
+        if (cosTheta < 0.0f)
+        {
+            b = SIMD::Negate(b);
+            cosTheta = -cosTheta;
+        }
+
+        float weightA, weightB;
+        SlerpWeights(cosTheta, t, weightA, weightB);
+        return FromSIMD(SIMD::Add(SIMD::Mul(a, SIMD::Splat(weightA)),
+                                  SIMD::Mul(b, SIMD::Splat(weightB))));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Batch operations
+    // out[n] = Op(start[n], end[n], t[n]) (or a shared t). Quaternions are processed four at a time
+    // in structure-of-arrays form. out may be start or end but must not partially overlap them.
+
+    static void Lerp(std::span<Quaternion const> start, std::span<Quaternion const> end,
+                     std::span<float const> t, std::span<Quaternion> out)
+    {
+        Batch<BatchOp::Lerp>(start, end, t, 0.0f, out);
+    }
+    static void Lerp(std::span<Quaternion const> start, std::span<Quaternion const> end, float t,
+                     std::span<Quaternion> out)
+    {
+        Batch<BatchOp::Lerp>(start, end, {}, t, out);
+    }
+
+    static void NLerp(std::span<Quaternion const> start, std::span<Quaternion const> end,
+                      std::span<float const> t, std::span<Quaternion> out)
+    {
+        Batch<BatchOp::NLerp>(start, end, t, 0.0f, out);
+    }
+    static void NLerp(std::span<Quaternion const> start, std::span<Quaternion const> end, float t,
+                      std::span<Quaternion> out)
+    {
+        Batch<BatchOp::NLerp>(start, end, {}, t, out);
+    }
+
+    static void Slerp(std::span<Quaternion const> start, std::span<Quaternion const> end,
+                      std::span<float const> t, std::span<Quaternion> out)
+    {
+        Batch<BatchOp::Slerp>(start, end, t, 0.0f, out);
+    }
+    static void Slerp(std::span<Quaternion const> start, std::span<Quaternion const> end, float t,
+                      std::span<Quaternion> out)
+    {
+        Batch<BatchOp::Slerp>(start, end, {}, t, out);
+    }
+
+    // out[n] = in[n].ToMatrix()
+    static void ToMatrix(std::span<Quaternion const> in, std::span<Matrix4x4> out)
+    {
+        LAT_ASSERT(out.size() >= in.size());
+
+        SIMD::Float4 const one = SIMD::Splat(1.0f);
+        SIMD::Float4 const zero = SIMD::Zero();
+        Vector4 const lastRow(0.0f, 0.0f, 0.0f, 1.0f);
+
+        usz n = 0;
+        for (; n + 4 <= in.size(); n += 4)
+        {
+            SIMD::Float4 x = in[n + 0].ToSIMD();
+            SIMD::Float4 y = in[n + 1].ToSIMD();
+            SIMD::Float4 z = in[n + 2].ToSIMD();
+            SIMD::Float4 w = in[n + 3].ToSIMD();
+            SIMD::Transpose(x, y, z, w);
+
+            SIMD::Float4 const x2 = SIMD::Add(x, x), y2 = SIMD::Add(y, y), z2 = SIMD::Add(z, z);
+            SIMD::Float4 const xx = SIMD::Mul(x, x2), yy = SIMD::Mul(y, y2), zz = SIMD::Mul(z, z2);
+            SIMD::Float4 const xy = SIMD::Mul(x, y2), xz = SIMD::Mul(x, z2), yz = SIMD::Mul(y, z2);
+            SIMD::Float4 const wx = SIMD::Mul(w, x2), wy = SIMD::Mul(w, y2), wz = SIMD::Mul(w, z2);
+
+            // Each register holds one matrix element for four matrices, so transposing a row's
+            // three elements (plus zero) gives that row for each of the four matrices.
+            SIMD::Float4 row0[4] = {SIMD::Sub(one, SIMD::Add(yy, zz)), SIMD::Sub(xy, wz),
+                                    SIMD::Add(xz, wy), zero};
+            SIMD::Float4 row1[4] = {SIMD::Add(xy, wz), SIMD::Sub(one, SIMD::Add(xx, zz)),
+                                    SIMD::Sub(yz, wx), zero};
+            SIMD::Float4 row2[4] = {SIMD::Sub(xz, wy), SIMD::Add(yz, wx),
+                                    SIMD::Sub(one, SIMD::Add(xx, yy)), zero};
+            SIMD::Transpose(row0[0], row0[1], row0[2], row0[3]);
+            SIMD::Transpose(row1[0], row1[1], row1[2], row1[3]);
+            SIMD::Transpose(row2[0], row2[1], row2[2], row2[3]);
+
+            for (usz m = 0; m < 4; ++m)
+            {
+                Matrix4x4 &result = out[n + m];
+                result.r0 = Vector4::FromSIMD(row0[m]);
+                result.r1 = Vector4::FromSIMD(row1[m]);
+                result.r2 = Vector4::FromSIMD(row2[m]);
+                result.r3 = lastRow;
+            }
+        }
+        for (; n < in.size(); ++n)
+        {
+            out[n] = in[n].ToMatrix();
+        }
+    }
+
+    constexpr bool RoughlyEqual(Quaternion const &other) const
+    {
+        return CloseEnough(i, other.i) && CloseEnough(j, other.j) && CloseEnough(k, other.k) &&
+               CloseEnough(r, other.r);
+    }
+    constexpr bool ExactlyEqual(Quaternion const &other) const
+    {
+        return (i == other.i) && (j == other.j) && (k == other.k) && (r == other.r);
+    }
+
+    SIMD::Float4 ToSIMD() const { return SIMD::Load(&i); }
+    static Quaternion FromSIMD(SIMD::Float4 v)
+    {
+        Quaternion result;
+        SIMD::Store(&result.i, v);
+        return result;
+    }
 
     float i = 0.0f;
     float j = 0.0f;
     float k = 0.0f;
     float r = 1.0f;
+
+private:
+    // Above this cosine the arc is too short for sin(theta) to divide by safely; a linear blend is
+    // indistinguishable there.
+    static constexpr float k_SlerpLinearThreshold = 0.9995f;
+
+    // cosTheta must be >= 0 (already on the shortest arc).
+    static constexpr void SlerpWeights(float cosTheta, float t, float &weightStart,
+                                       float &weightEnd)
+    {
+        if (cosTheta > k_SlerpLinearThreshold)
+        {
+            weightStart = 1.0f - t;
+            weightEnd = t;
+            return;
+        }
+        float const theta = ACos(cosTheta);
+        float const invSinTheta = 1.0f / Sin(theta);
+        weightStart = Sin((1.0f - t) * theta) * invSinTheta;
+        weightEnd = Sin(t * theta) * invSinTheta;
+    }
+
+    // SlerpWeights for four lanes at once. Lanes past the threshold divide by a tiny sin(theta) but
+    // their result is replaced by the linear weights.
+    static void SlerpWeights(SIMD::Float4 cosTheta, SIMD::Float4 t, SIMD::Float4 &weightStart,
+                             SIMD::Float4 &weightEnd)
+    {
+        SIMD::Float4 const one = SIMD::Splat(1.0f);
+        SIMD::Float4 const oneMinusT = SIMD::Sub(one, t);
+        SIMD::Float4 const sinTheta = SIMD::Sqrt(
+            SIMD::Max(SIMD::Sub(one, SIMD::Mul(cosTheta, cosTheta)), SIMD::Zero()));
+        SIMD::Float4 const theta = ATan2<Precision::Precise>(sinTheta, cosTheta);
+
+        SIMD::Float4 sinStart, sinEnd, unused;
+        SinCos<Precision::Precise>(SIMD::Mul(oneMinusT, theta), sinStart, unused);
+        SinCos<Precision::Precise>(SIMD::Mul(t, theta), sinEnd, unused);
+
+        SIMD::Float4 const linear = SIMD::Greater(cosTheta, SIMD::Splat(k_SlerpLinearThreshold));
+        weightStart = SIMD::Select(linear, oneMinusT, SIMD::Div(sinStart, sinTheta));
+        weightEnd = SIMD::Select(linear, t, SIMD::Div(sinEnd, sinTheta));
+    }
+
+    enum class BatchOp
+    {
+        Lerp,
+        NLerp,
+        Slerp
+    };
+
+    template <BatchOp Op>
+    static void Batch(std::span<Quaternion const> start, std::span<Quaternion const> end,
+                      std::span<float const> ts, float sharedT, std::span<Quaternion> out)
+    {
+        LAT_ASSERT(end.size() == start.size());
+        LAT_ASSERT(ts.empty() || ts.size() == start.size());
+        LAT_ASSERT(out.size() >= start.size());
+
+        auto tAt = [&ts, sharedT](usz n) { return ts.empty() ? sharedT : ts[n]; };
+
+        usz n = 0;
+        for (; n + 4 <= start.size(); n += 4)
+        {
+            // Structure-of-arrays: ax holds the i component of four start quaternions, and so on.
+            SIMD::Float4 ax = start[n].ToSIMD(), ay = start[n + 1].ToSIMD();
+            SIMD::Float4 az = start[n + 2].ToSIMD(), aw = start[n + 3].ToSIMD();
+            SIMD::Float4 bx = end[n].ToSIMD(), by = end[n + 1].ToSIMD();
+            SIMD::Float4 bz = end[n + 2].ToSIMD(), bw = end[n + 3].ToSIMD();
+            SIMD::Transpose(ax, ay, az, aw);
+            SIMD::Transpose(bx, by, bz, bw);
+
+            SIMD::Float4 const t = SIMD::Set(tAt(n), tAt(n + 1), tAt(n + 2), tAt(n + 3));
+            SIMD::Float4 weightA, weightB;
+
+            if constexpr (Op == BatchOp::Lerp)
+            {
+                weightA = SIMD::Sub(SIMD::Splat(1.0f), t);
+                weightB = t;
+            }
+            else
+            {
+                // Negating the end quaternion's weight is the same as negating the quaternion.
+                SIMD::Float4 dot = SIMD::Mul(ax, bx);
+                dot = SIMD::MulAdd(ay, by, dot);
+                dot = SIMD::MulAdd(az, bz, dot);
+                dot = SIMD::MulAdd(aw, bw, dot);
+
+                if constexpr (Op == BatchOp::NLerp)
+                {
+                    weightA = SIMD::Sub(SIMD::Splat(1.0f), t);
+                    weightB = t;
+                }
+                else
+                {
+                    SlerpWeights(SIMD::Abs(dot), t, weightA, weightB);
+                }
+                weightB = SIMD::FlipSign(weightB, dot);
+            }
+
+            SIMD::Float4 x = SIMD::MulAdd(bx, weightB, SIMD::Mul(ax, weightA));
+            SIMD::Float4 y = SIMD::MulAdd(by, weightB, SIMD::Mul(ay, weightA));
+            SIMD::Float4 z = SIMD::MulAdd(bz, weightB, SIMD::Mul(az, weightA));
+            SIMD::Float4 w = SIMD::MulAdd(bw, weightB, SIMD::Mul(aw, weightA));
+
+            if constexpr (Op == BatchOp::NLerp)
+            {
+                SIMD::Float4 lengthSq = SIMD::Mul(x, x);
+                lengthSq = SIMD::MulAdd(y, y, lengthSq);
+                lengthSq = SIMD::MulAdd(z, z, lengthSq);
+                lengthSq = SIMD::MulAdd(w, w, lengthSq);
+                SIMD::Float4 const length = SIMD::Sqrt(lengthSq);
+                x = SIMD::Div(x, length);
+                y = SIMD::Div(y, length);
+                z = SIMD::Div(z, length);
+                w = SIMD::Div(w, length);
+            }
+
+            SIMD::Transpose(x, y, z, w);
+            out[n] = FromSIMD(x);
+            out[n + 1] = FromSIMD(y);
+            out[n + 2] = FromSIMD(z);
+            out[n + 3] = FromSIMD(w);
+        }
+        for (; n < start.size(); ++n)
+        {
+            if constexpr (Op == BatchOp::Lerp)
+            {
+                out[n] = Lerp(start[n], end[n], tAt(n));
+            }
+            else if constexpr (Op == BatchOp::NLerp)
+            {
+                out[n] = NLerp(start[n], end[n], tAt(n));
+            }
+            else
+            {
+                out[n] = Slerp(start[n], end[n], tAt(n));
+            }
+        }
+    }
 };
-} // namespace Lateralus::Core
\ No newline at end of file
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must map onto one SIMD register");
+} // namespace Lateralus::Core
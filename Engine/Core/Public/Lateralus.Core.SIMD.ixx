@@ -0,0 +1,903 @@
+module;
+
+#include <Core.SIMD.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+export module Lateralus.Core.SIMD;
+
+// Thin wrappers over the 4-wide float register of the compiled instruction set.
+// The backend is picked at compile time (see Core.SIMD.h): SSE on x86/x64, NEON on ARM and a plain
+// array everywhere else. Everything here is expected to inline down to single instructions.
+
+namespace Lateralus::Core::SIMD
+{
+#if LATERALUS_SIMD_SSE
+export using Float4 = __m128;
+#elif LATERALUS_SIMD_NEON
+export using Float4 = float32x4_t;
+#else
+export struct alignas(16) Float4
+{
+    float v[4];
+};
+#endif
+
+// Loads 4 floats from 16 byte aligned memory.
+export inline Float4 Load(float const *src)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_load_ps(src);
+#elif LATERALUS_SIMD_NEON
+    return vld1q_f32(src);
+#else
+    return Float4{{src[0], src[1], src[2], src[3]}};
+#endif
+}
+
+export inline Float4 LoadUnaligned(float const *src)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_loadu_ps(src);
+#else
+    return Load(src);
+#endif
+}
+
+// Stores 4 floats to 16 byte aligned memory.
+export inline void Store(float *dest, Float4 v)
+{
+#if LATERALUS_SIMD_SSE
+    _mm_store_ps(dest, v);
+#elif LATERALUS_SIMD_NEON
+    vst1q_f32(dest, v);
+#else
+    dest[0] = v.v[0];
+    dest[1] = v.v[1];
+    dest[2] = v.v[2];
+    dest[3] = v.v[3];
+#endif
+}
+
+export inline void StoreUnaligned(float *dest, Float4 v)
+{
+#if LATERALUS_SIMD_SSE
+    _mm_storeu_ps(dest, v);
+#else
+    Store(dest, v);
+#endif
+}
+
+export inline Float4 Set(float x, float y, float z, float w)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_setr_ps(x, y, z, w);
+#elif LATERALUS_SIMD_NEON
+    float const values[4] = {x, y, z, w};
+    return vld1q_f32(values);
+#else
+    return Float4{{x, y, z, w}};
+#endif
+}
+
+// All four lanes set to val.
+export inline Float4 Splat(float val)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_set1_ps(val);
+#elif LATERALUS_SIMD_NEON
+    return vdupq_n_f32(val);
+#else
+    return Float4{{val, val, val, val}};
+#endif
+}
+
+export inline Float4 Zero()
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_setzero_ps();
+#else
+    return Splat(0.0f);
+#endif
+}
+
+export inline Float4 Add(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_add_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vaddq_f32(a, b);
+#else
+    return Float4{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+#endif
+}
+
+export inline Float4 Sub(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_sub_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vsubq_f32(a, b);
+#else
+    return Float4{{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+#endif
+}
+
+export inline Float4 Mul(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_mul_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vmulq_f32(a, b);
+#else
+    return Float4{{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+#endif
+}
+
+export inline Float4 Div(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_div_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vdivq_f32(a, b);
+#else
+    // ARMv7 has no divide: refine the reciprocal estimate twice (~23 bits) then multiply.
+    float32x4_t recip = vrecpeq_f32(b);
+    recip = vmulq_f32(vrecpsq_f32(b, recip), recip);
+    recip = vmulq_f32(vrecpsq_f32(b, recip), recip);
+    return vmulq_f32(a, recip);
+#endif
+#else
+    return Float4{{a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3]}};
+#endif
+}
+
+// (a * b) + c, fused when the instruction set allows it.
+export inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)
+{
+#if LATERALUS_SIMD_SSE && LATERALUS_HAS_FMA
+    return _mm_fmadd_ps(a, b, c);
+#elif LATERALUS_SIMD_NEON
+    return vmlaq_f32(c, a, b);
+#else
+    return Add(Mul(a, b), c);
+#endif
+}
+
+// The first lane.
+export inline float GetX(Float4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_cvtss_f32(v);
+#elif LATERALUS_SIMD_NEON
+    return vgetq_lane_f32(v, 0);
+#else
+    return v.v[0];
+#endif
+}
+
+// Sum of all four lanes.
+export inline float HorizontalSum(Float4 v)
+{
+#if LATERALUS_SIMD_SSE
+    // (x+z, y+w, ...) then ((x+z)+(y+w), ...)
+    Float4 const swapped = _mm_movehl_ps(v, v);
+    Float4 const pairs = _mm_add_ps(v, swapped);
+    Float4 const odd = _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, odd));
+#elif LATERALUS_SIMD_NEON
+    float32x2_t const pairs = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+#else
+    return (v.v[0] + v.v[1]) + (v.v[2] + v.v[3]);
+#endif
+}
+
+// Four lane dot product.
+export inline float Dot(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE && LATERALUS_SSE_CURRENT >= LATERALUS_SSE4_1
+    return _mm_cvtss_f32(_mm_dp_ps(a, b, 0xFF));
+#else
+    return HorizontalSum(Mul(a, b));
+#endif
+}
+
+// Transposes the 4x4 matrix held by r0-r3 in place.
+export inline void Transpose(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3)
+{
+#if LATERALUS_SIMD_SSE
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+#elif LATERALUS_SIMD_NEON
+    float32x4x2_t const t01 = vtrnq_f32(r0, r1);
+    float32x4x2_t const t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#else
+    Float4 const a = r0, b = r1, c = r2, d = r3;
+    r0 = Float4{{a.v[0], b.v[0], c.v[0], d.v[0]}};
+    r1 = Float4{{a.v[1], b.v[1], c.v[1], d.v[1]}};
+    r2 = Float4{{a.v[2], b.v[2], c.v[2], d.v[2]}};
+    r3 = Float4{{a.v[3], b.v[3], c.v[3], d.v[3]}};
+#endif
+}
+
+export inline Float4 Sqrt(Float4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_sqrt_ps(v);
+#elif LATERALUS_SIMD_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+    return vsqrtq_f32(v);
+#elif LATERALUS_SIMD_NEON
+    // sqrt(v) = v * rsqrt(v), refining the estimate twice. Zero lanes stay zero.
+    float32x4_t rsqrt = vrsqrteq_f32(v);
+    rsqrt = vmulq_f32(vrsqrtsq_f32(vmulq_f32(v, rsqrt), rsqrt), rsqrt);
+    rsqrt = vmulq_f32(vrsqrtsq_f32(vmulq_f32(v, rsqrt), rsqrt), rsqrt);
+    uint32x4_t const isZero = vceqq_f32(v, vdupq_n_f32(0.0f));
+    return vbslq_f32(isZero, v, vmulq_f32(v, rsqrt));
+#else
+    return Float4{{::sqrtf(v.v[0]), ::sqrtf(v.v[1]), ::sqrtf(v.v[2]), ::sqrtf(v.v[3])}};
+#endif
+}
+
+// Approximate 1 / sqrt(v). Relative error is under 1.5 * 2^-12 on SSE; the NEON estimate is
+// refined once to get close to that.
+export inline Float4 RSqrtEstimate(Float4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_rsqrt_ps(v);
+#elif LATERALUS_SIMD_NEON
+    float32x4_t const estimate = vrsqrteq_f32(v);
+    return vmulq_f32(vrsqrtsq_f32(vmulq_f32(v, estimate), estimate), estimate);
+#else
+    return Float4{{1.0f / ::sqrtf(v.v[0]), 1.0f / ::sqrtf(v.v[1]), 1.0f / ::sqrtf(v.v[2]),
+                   1.0f / ::sqrtf(v.v[3])}};
+#endif
+}
+
+export inline Float4 Negate(Float4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_xor_ps(v, _mm_set1_ps(-0.0f));
+#elif LATERALUS_SIMD_NEON
+    return vnegq_f32(v);
+#else
+    return Float4{{-v.v[0], -v.v[1], -v.v[2], -v.v[3]}};
+#endif
+}
+
+// Flips the sign of each lane of v whose matching lane in sign is negative (sign bit set).
+export inline Float4 FlipSign(Float4 v, Float4 sign)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_xor_ps(v, _mm_and_ps(sign, _mm_set1_ps(-0.0f)));
+#elif LATERALUS_SIMD_NEON
+    uint32x4_t const signBits = vandq_u32(vreinterpretq_u32_f32(sign), vdupq_n_u32(0x80000000u));
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), signBits));
+#else
+    Float4 result = v;
+    for (int i = 0; i < 4; ++i)
+    {
+        result.v[i] = ::signbit(sign.v[i]) ? -v.v[i] : v.v[i];
+    }
+    return result;
+#endif
+}
+
+// Lanes reordered: (v[X], v[Y], v[Z], v[W]).
+export template <int X, int Y, int Z, int W> Float4 Shuffle(Float4 v)
+{
+    static_assert(X >= 0 && X < 4 && Y >= 0 && Y < 4 && Z >= 0 && Z < 4 && W >= 0 && W < 4);
+#if LATERALUS_SIMD_SSE
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+#elif LATERALUS_SIMD_NEON
+    return Set(vgetq_lane_f32(v, X), vgetq_lane_f32(v, Y), vgetq_lane_f32(v, Z),
+               vgetq_lane_f32(v, W));
+#else
+    return Float4{{v.v[X], v.v[Y], v.v[Z], v.v[W]}};
+#endif
+}
+
+// Every lane set to lane Lane of v.
+export template <int Lane> Float4 Broadcast(Float4 v)
+{
+    static_assert(Lane >= 0 && Lane < 4);
+#if LATERALUS_SIMD_SSE
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+#elif LATERALUS_SIMD_NEON
+    return vdupq_n_f32(vgetq_lane_f32(v, Lane));
+#else
+    return Splat(v.v[Lane]);
+#endif
+}
+
+// Loads 4 consecutive xyz triplets (12 floats, no alignment requirement) and splits them into one
+// register per component.
+export inline void LoadDeinterleave3(float const *src, Float4 &x, Float4 &y, Float4 &z)
+{
+#if LATERALUS_SIMD_SSE
+    Float4 const x0y0z0x1 = _mm_loadu_ps(src);
+    Float4 const y1z1x2y2 = _mm_loadu_ps(src + 4);
+    Float4 const z2x3y3z3 = _mm_loadu_ps(src + 8);
+    Float4 const x2y2x3y3 = _mm_shuffle_ps(y1z1x2y2, z2x3y3z3, _MM_SHUFFLE(2, 1, 3, 2));
+    Float4 const y0z0y1z1 = _mm_shuffle_ps(x0y0z0x1, y1z1x2y2, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm_shuffle_ps(x0y0z0x1, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(y0z0y1z1, z2x3y3z3, _MM_SHUFFLE(3, 0, 3, 1));
+#elif LATERALUS_SIMD_NEON
+    float32x4x3_t const xyz = vld3q_f32(src);
+    x = xyz.val[0];
+    y = xyz.val[1];
+    z = xyz.val[2];
+#else
+    x = Float4{{src[0], src[3], src[6], src[9]}};
+    y = Float4{{src[1], src[4], src[7], src[10]}};
+    z = Float4{{src[2], src[5], src[8], src[11]}};
+#endif
+}
+
+// The inverse of LoadDeinterleave3: writes 4 xyz triplets (12 floats) to dest.
+export inline void StoreInterleave3(float *dest, Float4 x, Float4 y, Float4 z)
+{
+#if LATERALUS_SIMD_SSE
+    Float4 const x0y0x1y1 = _mm_unpacklo_ps(x, y);
+    Float4 const x2y2x3y3 = _mm_unpackhi_ps(x, y);
+    Float4 const z0z0x1x1 = _mm_shuffle_ps(z, x0y0x1y1, _MM_SHUFFLE(2, 2, 0, 0));
+    Float4 const y1y1z1z1 = _mm_shuffle_ps(x0y0x1y1, z, _MM_SHUFFLE(1, 1, 3, 3));
+    Float4 const z2z2x3x3 = _mm_shuffle_ps(z, x2y2x3y3, _MM_SHUFFLE(2, 2, 2, 2));
+    Float4 const y3y3z3z3 = _mm_shuffle_ps(x2y2x3y3, z, _MM_SHUFFLE(3, 3, 3, 3));
+    _mm_storeu_ps(dest, _mm_shuffle_ps(x0y0x1y1, z0z0x1x1, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dest + 4, _mm_shuffle_ps(y1y1z1z1, x2y2x3y3, _MM_SHUFFLE(1, 0, 2, 0)));
+    _mm_storeu_ps(dest + 8, _mm_shuffle_ps(z2z2x3x3, y3y3z3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+#elif LATERALUS_SIMD_NEON
+    float32x4x3_t xyz;
+    xyz.val[0] = x;
+    xyz.val[1] = y;
+    xyz.val[2] = z;
+    vst3q_f32(dest, xyz);
+#else
+    for (int i = 0; i < 4; ++i)
+    {
+        dest[i * 3 + 0] = x.v[i];
+        dest[i * 3 + 1] = y.v[i];
+        dest[i * 3 + 2] = z.v[i];
+    }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Masks and bitwise operations
+// Comparisons produce a mask with every bit of a lane set where the comparison holds.
+
+#if LATERALUS_SIMD_SCALAR
+uint32_t Bits(float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+float FromBits(uint32_t u)
+{
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+float Mask(bool b) { return FromBits(b ? 0xFFFFFFFFu : 0u); }
+
+template <typename Op> Float4 BitwiseOp(Float4 a, Float4 b, Op op)
+{
+    Float4 result;
+    for (int i = 0; i < 4; ++i)
+    {
+        result.v[i] = FromBits(op(Bits(a.v[i]), Bits(b.v[i])));
+    }
+    return result;
+}
+
+template <typename Op> Float4 CompareOp(Float4 a, Float4 b, Op op)
+{
+    return Float4{{Mask(op(a.v[0], b.v[0])), Mask(op(a.v[1], b.v[1])), Mask(op(a.v[2], b.v[2])),
+                   Mask(op(a.v[3], b.v[3]))}};
+}
+#endif
+
+export inline Float4 And(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_and_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+#else
+    return BitwiseOp(a, b, [](uint32_t x, uint32_t y) { return x & y; });
+#endif
+}
+
+// (~a) & b
+export inline Float4 AndNot(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_andnot_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(b), vreinterpretq_u32_f32(a)));
+#else
+    return BitwiseOp(a, b, [](uint32_t x, uint32_t y) { return ~x & y; });
+#endif
+}
+
+export inline Float4 Or(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_or_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+#else
+    return BitwiseOp(a, b, [](uint32_t x, uint32_t y) { return x | y; });
+#endif
+}
+
+export inline Float4 Xor(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_xor_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+#else
+    return BitwiseOp(a, b, [](uint32_t x, uint32_t y) { return x ^ y; });
+#endif
+}
+
+export inline Float4 Less(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_cmplt_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_f32_u32(vcltq_f32(a, b));
+#else
+    return CompareOp(a, b, [](float x, float y) { return x < y; });
+#endif
+}
+
+export inline Float4 LessEqual(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_cmple_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_f32_u32(vcleq_f32(a, b));
+#else
+    return CompareOp(a, b, [](float x, float y) { return x <= y; });
+#endif
+}
+
+export inline Float4 Greater(Float4 a, Float4 b) { return Less(b, a); }
+export inline Float4 GreaterEqual(Float4 a, Float4 b) { return LessEqual(b, a); }
+
+export inline Float4 Equal(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_cmpeq_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_f32_u32(vceqq_f32(a, b));
+#else
+    return CompareOp(a, b, [](float x, float y) { return x == y; });
+#endif
+}
+
+// The sign bit of each lane packed into the low four bits, lane 0 in bit 0. On a comparison
+// result that's one bit per lane that passed.
+export inline uint32_t MoveMask(Float4 mask)
+{
+#if LATERALUS_SIMD_SSE
+    return static_cast<uint32_t>(_mm_movemask_ps(mask));
+#elif LATERALUS_SIMD_NEON
+    int32_t const shifts[4] = {0, 1, 2, 3};
+    uint32x4_t const signs = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+    uint32x4_t const bits = vshlq_u32(signs, vld1q_s32(shifts));
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vaddvq_u32(bits);
+#else
+    // ARMv7 has no across-vector add: add pairs twice.
+    uint32x2_t const pairs = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+    return vget_lane_u32(vpadd_u32(pairs, pairs), 0);
+#endif
+#else
+    uint32_t result = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        result |= (Bits(mask.v[i]) >> 31) << i;
+    }
+    return result;
+#endif
+}
+
+// Per lane: mask ? a : b
+export inline Float4 Select(Float4 mask, Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE && LATERALUS_SSE_CURRENT >= LATERALUS_SSE4_1
+    return _mm_blendv_ps(b, a, mask);
+#elif LATERALUS_SIMD_NEON
+    return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+#else
+    return Or(And(mask, a), AndNot(mask, b));
+#endif
+}
+
+export inline Float4 Abs(Float4 v) { return AndNot(Splat(-0.0f), v); }
+
+export inline Float4 Min(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_min_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vminq_f32(a, b);
+#else
+    return Select(Less(a, b), a, b);
+#endif
+}
+
+export inline Float4 Max(Float4 a, Float4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_max_ps(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vmaxq_f32(a, b);
+#else
+    return Select(Less(b, a), a, b);
+#endif
+}
+
+// Rounds to the nearest integer, ties to even. Lanes must be within +-2^22 where SSE4.1 and
+// ARMv8 aren't available.
+export inline Float4 Round(Float4 v)
+{
+#if LATERALUS_SIMD_SSE && LATERALUS_SSE_CURRENT >= LATERALUS_SSE4_1
+    return _mm_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#elif LATERALUS_SIMD_SSE
+    return _mm_cvtepi32_ps(_mm_cvtps_epi32(v));
+#elif LATERALUS_SIMD_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+    return vrndnq_f32(v);
+#elif LATERALUS_SIMD_NEON
+    // Adding and removing 1.5 * 2^23 pushes the fraction out of the mantissa.
+    float32x4_t const magic = vdupq_n_f32(12582912.0f);
+    return vsubq_f32(vaddq_f32(v, magic), magic);
+#else
+    return Float4{{::nearbyintf(v.v[0]), ::nearbyintf(v.v[1]), ::nearbyintf(v.v[2]),
+                   ::nearbyintf(v.v[3])}};
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 32 bit integer lanes
+// Just enough to pick apart and build floats (exponents, quadrants and the like).
+
+#if LATERALUS_SIMD_SSE
+export using Int4 = __m128i;
+#elif LATERALUS_SIMD_NEON
+export using Int4 = int32x4_t;
+#else
+export struct alignas(16) Int4
+{
+    int32_t v[4];
+};
+#endif
+
+export inline Int4 SplatInt(int32_t val)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_set1_epi32(val);
+#elif LATERALUS_SIMD_NEON
+    return vdupq_n_s32(val);
+#else
+    return Int4{{val, val, val, val}};
+#endif
+}
+
+export inline Int4 Add(Int4 a, Int4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_add_epi32(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vaddq_s32(a, b);
+#else
+    return Int4{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+#endif
+}
+
+export inline Int4 Sub(Int4 a, Int4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_sub_epi32(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vsubq_s32(a, b);
+#else
+    return Int4{{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+#endif
+}
+
+export inline Int4 And(Int4 a, Int4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_and_si128(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vandq_s32(a, b);
+#else
+    return Int4{{a.v[0] & b.v[0], a.v[1] & b.v[1], a.v[2] & b.v[2], a.v[3] & b.v[3]}};
+#endif
+}
+
+// Mask of the lanes where a == b.
+export inline Int4 Equal(Int4 a, Int4 b)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_cmpeq_epi32(a, b);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_s32_u32(vceqq_s32(a, b));
+#else
+    return Int4{{-(a.v[0] == b.v[0]), -(a.v[1] == b.v[1]), -(a.v[2] == b.v[2]),
+                 -(a.v[3] == b.v[3])}};
+#endif
+}
+
+export template <int Bits> Int4 ShiftLeft(Int4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_slli_epi32(v, Bits);
+#elif LATERALUS_SIMD_NEON
+    return vshlq_n_s32(v, Bits);
+#else
+    return Int4{{static_cast<int32_t>(static_cast<uint32_t>(v.v[0]) << Bits),
+                 static_cast<int32_t>(static_cast<uint32_t>(v.v[1]) << Bits),
+                 static_cast<int32_t>(static_cast<uint32_t>(v.v[2]) << Bits),
+                 static_cast<int32_t>(static_cast<uint32_t>(v.v[3]) << Bits)}};
+#endif
+}
+
+// Logical (zero filling) shift.
+export template <int Bits> Int4 ShiftRight(Int4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_srli_epi32(v, Bits);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), Bits));
+#else
+    return Int4{{static_cast<int32_t>(static_cast<uint32_t>(v.v[0]) >> Bits),
+                 static_cast<int32_t>(static_cast<uint32_t>(v.v[1]) >> Bits),
+                 static_cast<int32_t>(static_cast<uint32_t>(v.v[2]) >> Bits),
+                 static_cast<int32_t>(static_cast<uint32_t>(v.v[3]) >> Bits)}};
+#endif
+}
+
+// Converts to the nearest integer (see Round for the valid range).
+export inline Int4 ToInt(Float4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_cvtps_epi32(v);
+#elif LATERALUS_SIMD_NEON
+    return vcvtq_s32_f32(Round(v));
+#else
+    Float4 const rounded = Round(v);
+    return Int4{{static_cast<int32_t>(rounded.v[0]), static_cast<int32_t>(rounded.v[1]),
+                 static_cast<int32_t>(rounded.v[2]), static_cast<int32_t>(rounded.v[3])}};
+#endif
+}
+
+export inline Float4 ToFloat(Int4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_cvtepi32_ps(v);
+#elif LATERALUS_SIMD_NEON
+    return vcvtq_f32_s32(v);
+#else
+    return Float4{{static_cast<float>(v.v[0]), static_cast<float>(v.v[1]),
+                   static_cast<float>(v.v[2]), static_cast<float>(v.v[3])}};
+#endif
+}
+
+// Reinterprets the bits of each lane.
+export inline Int4 AsInt(Float4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_castps_si128(v);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_s32_f32(v);
+#else
+    Int4 result;
+    memcpy(&result, &v, sizeof(result));
+    return result;
+#endif
+}
+
+export inline Float4 AsFloat(Int4 v)
+{
+#if LATERALUS_SIMD_SSE
+    return _mm_castsi128_ps(v);
+#elif LATERALUS_SIMD_NEON
+    return vreinterpretq_f32_s32(v);
+#else
+    Float4 result;
+    memcpy(&result, &v, sizeof(result));
+    return result;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// 8-wide
+
+#if LATERALUS_SIMD_AVX
+export using Float8 = __m256;
+#else
+export struct Float8
+{
+    Float4 lo, hi;
+};
+#endif
+
+export inline Float8 LoadUnaligned8(float const *src)
+{
+#if LATERALUS_SIMD_AVX
+    return _mm256_loadu_ps(src);
+#else
+    return Float8{LoadUnaligned(src), LoadUnaligned(src + 4)};
+#endif
+}
+
+export inline void StoreUnaligned8(float *dest, Float8 v)
+{
+#if LATERALUS_SIMD_AVX
+    _mm256_storeu_ps(dest, v);
+#else
+    StoreUnaligned(dest, v.lo);
+    StoreUnaligned(dest + 4, v.hi);
+#endif
+}
+
+export inline Float8 Splat8(float val)
+{
+#if LATERALUS_SIMD_AVX
+    return _mm256_set1_ps(val);
+#else
+    return Float8{Splat(val), Splat(val)};
+#endif
+}
+
+// Both 4-wide halves set to v.
+export inline Float8 Duplicate(Float4 v)
+{
+#if LATERALUS_SIMD_AVX
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(v), v, 1);
+#else
+    return Float8{v, v};
+#endif
+}
+
+export inline Float8 Add(Float8 a, Float8 b)
+{
+#if LATERALUS_SIMD_AVX
+    return _mm256_add_ps(a, b);
+#else
+    return Float8{Add(a.lo, b.lo), Add(a.hi, b.hi)};
+#endif
+}
+
+export inline Float8 Sub(Float8 a, Float8 b)
+{
+#if LATERALUS_SIMD_AVX
+    return _mm256_sub_ps(a, b);
+#else
+    return Float8{Sub(a.lo, b.lo), Sub(a.hi, b.hi)};
+#endif
+}
+
+export inline Float8 Mul(Float8 a, Float8 b)
+{
+#if LATERALUS_SIMD_AVX
+    return _mm256_mul_ps(a, b);
+#else
+    return Float8{Mul(a.lo, b.lo), Mul(a.hi, b.hi)};
+#endif
+}
+
+export inline Float8 MulAdd(Float8 a, Float8 b, Float8 c)
+{
+#if LATERALUS_SIMD_AVX && LATERALUS_HAS_FMA
+    return _mm256_fmadd_ps(a, b, c);
+#elif LATERALUS_SIMD_AVX
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#else
+    return Float8{MulAdd(a.lo, b.lo, c.lo), MulAdd(a.hi, b.hi, c.hi)};
+#endif
+}
+
+// Broadcast within each 4-wide half: (a[Lane] x4, b[Lane] x4) for a register holding (a, b).
+export template <int Lane> Float8 Broadcast(Float8 v)
+{
+    static_assert(Lane >= 0 && Lane < 4);
+#if LATERALUS_SIMD_AVX
+    return _mm256_permute_ps(v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+#else
+    return Float8{Broadcast<Lane>(v.lo), Broadcast<Lane>(v.hi)};
+#endif
+}
+
+// 8 xyz triplets (24 floats), see LoadDeinterleave3.
+export inline void LoadDeinterleave3(float const *src, Float8 &x, Float8 &y, Float8 &z)
+{
+#if LATERALUS_SIMD_AVX
+    // The 128 bit halves of each AVX register are shuffled independently, so the first 4 triplets
+    // go in the low halves and the next 4 in the high halves; the SSE shuffles then apply as-is.
+    auto load = [src](int offset) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + offset)),
+                                    _mm_loadu_ps(src + offset + 12), 1);
+    };
+    Float8 const x0y0z0x1 = load(0);
+    Float8 const y1z1x2y2 = load(4);
+    Float8 const z2x3y3z3 = load(8);
+    Float8 const x2y2x3y3 = _mm256_shuffle_ps(y1z1x2y2, z2x3y3z3, _MM_SHUFFLE(2, 1, 3, 2));
+    Float8 const y0z0y1z1 = _mm256_shuffle_ps(x0y0z0x1, y1z1x2y2, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm256_shuffle_ps(x0y0z0x1, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm256_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm256_shuffle_ps(y0z0y1z1, z2x3y3z3, _MM_SHUFFLE(3, 0, 3, 1));
+#else
+    LoadDeinterleave3(src, x.lo, y.lo, z.lo);
+    LoadDeinterleave3(src + 12, x.hi, y.hi, z.hi);
+#endif
+}
+
+// 8 xyz triplets (24 floats), see StoreInterleave3.
+export inline void StoreInterleave3(float *dest, Float8 x, Float8 y, Float8 z)
+{
+#if LATERALUS_SIMD_AVX
+    Float8 const x0y0x1y1 = _mm256_unpacklo_ps(x, y);
+    Float8 const x2y2x3y3 = _mm256_unpackhi_ps(x, y);
+    Float8 const z0z0x1x1 = _mm256_shuffle_ps(z, x0y0x1y1, _MM_SHUFFLE(2, 2, 0, 0));
+    Float8 const y1y1z1z1 = _mm256_shuffle_ps(x0y0x1y1, z, _MM_SHUFFLE(1, 1, 3, 3));
+    Float8 const z2z2x3x3 = _mm256_shuffle_ps(z, x2y2x3y3, _MM_SHUFFLE(2, 2, 2, 2));
+    Float8 const y3y3z3z3 = _mm256_shuffle_ps(x2y2x3y3, z, _MM_SHUFFLE(3, 3, 3, 3));
+    Float8 const a = _mm256_shuffle_ps(x0y0x1y1, z0z0x1x1, _MM_SHUFFLE(2, 0, 1, 0));
+    Float8 const b = _mm256_shuffle_ps(y1y1z1z1, x2y2x3y3, _MM_SHUFFLE(1, 0, 2, 0));
+    Float8 const c = _mm256_shuffle_ps(z2z2x3x3, y3y3z3z3, _MM_SHUFFLE(2, 0, 2, 0));
+    _mm_storeu_ps(dest, _mm256_castps256_ps128(a));
+    _mm_storeu_ps(dest + 4, _mm256_castps256_ps128(b));
+    _mm_storeu_ps(dest + 8, _mm256_castps256_ps128(c));
+    _mm_storeu_ps(dest + 12, _mm256_extractf128_ps(a, 1));
+    _mm_storeu_ps(dest + 16, _mm256_extractf128_ps(b, 1));
+    _mm_storeu_ps(dest + 20, _mm256_extractf128_ps(c, 1));
+#else
+    StoreInterleave3(dest, x.lo, y.lo, z.lo);
+    StoreInterleave3(dest + 12, x.hi, y.hi, z.hi);
+#endif
+}
+
+export inline Float8 Or(Float8 a, Float8 b)
+{
+#if LATERALUS_SIMD_AVX
+    return _mm256_or_ps(a, b);
+#else
+    return Float8{Or(a.lo, b.lo), Or(a.hi, b.hi)};
+#endif
+}
+
+export inline Float8 Less(Float8 a, Float8 b)
+{
+#if LATERALUS_SIMD_AVX
+    return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+#else
+    return Float8{Less(a.lo, b.lo), Less(a.hi, b.hi)};
+#endif
+}
+
+// As MoveMask(Float4), eight bits.
+export inline uint32_t MoveMask(Float8 mask)
+{
+#if LATERALUS_SIMD_AVX
+    return static_cast<uint32_t>(_mm256_movemask_ps(mask));
+#else
+    return MoveMask(mask.lo) | (MoveMask(mask.hi) << 4);
+#endif
+}
+} // namespace Lateralus::Core::SIMD
@@ -1,27 +1,103 @@
 export module Lateralus.Core.Signal;
-import <functional>;
-import <list>;
+import <atomic>;
+import <memory>;
 import <mutex>;
+import <tuple>;
+import <type_traits>;
+import <vector>;
 import Lateralus.Core;
+import Lateralus.Core.Delegate;
+import Lateralus.Core.Memory;
+import Lateralus.Core.MPSCQueue;
 
 using namespace std;
 
 namespace Lateralus::Core
 {
+// Identifies one subscription. Tokens carry the generation of the slot they were issued for, so
+// removing with a token whose subscription is already gone is a safe no-op.
+export struct SignalToken
+{
+    uint32 Slot = ~0u;
+    uint32 Generation = 0;
+};
+
 export template <typename T> class iSignalSubscribe
 {
 public:
-    using Delegate = function<T>;
-    using Token = list<Delegate>::iterator;
+    using Delegate = Core::Delegate<T>;
+    using Token = SignalToken;
 
     virtual Token Add(Delegate func) = 0;
     virtual bool Remove(Token &token) = 0;
 
-    Token operator+=(function<T> func) { return Add(func); }
+    Token operator+=(Delegate func) { return Add(move(func)); }
 
     bool operator-=(Token &token) { return Remove(token); }
 };
 
+// The subscriptions of a signal, kept contiguous in the order they were added so invoking walks
+// one array.
+template <typename T> class SignalDelegates
+{
+public:
+    using Delegate = Core::Delegate<T>;
+
+    SignalToken Add(Delegate func)
+    {
+        uint32 slot;
+        if (m_FreeSlots.empty())
+        {
+            slot = static_cast<uint32>(m_Slots.size());
+            m_Slots.emplace_back();
+        }
+        else
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        m_Slots[slot].Index = static_cast<uint32>(m_Delegates.size());
+        m_Delegates.push_back(move(func));
+        m_DelegateSlots.push_back(slot);
+        return SignalToken{slot, m_Slots[slot].Generation};
+    }
+
+    bool Remove(SignalToken &token)
+    {
+        if (token.Slot >= m_Slots.size() || m_Slots[token.Slot].Generation != token.Generation)
+        {
+            return false;
+        }
+        Slot &slot = m_Slots[token.Slot];
+        usz const index = slot.Index;
+        m_Delegates.erase(m_Delegates.begin() + index);
+        m_DelegateSlots.erase(m_DelegateSlots.begin() + index);
+        for (usz i = index; i < m_DelegateSlots.size(); ++i)
+        {
+            m_Slots[m_DelegateSlots[i]].Index = static_cast<uint32>(i);
+        }
+        ++slot.Generation;
+        m_FreeSlots.push_back(token.Slot);
+        token = SignalToken{};
+        return true;
+    }
+
+    vector<Delegate> const &Get() const { return m_Delegates; }
+
+private:
+    struct Slot
+    {
+        uint32 Generation = 0;
+        // Where the slot's delegate is in m_Delegates.
+        uint32 Index = 0;
+    };
+
+    vector<Delegate> m_Delegates;
+    vector<uint32> m_DelegateSlots;
+    vector<Slot> m_Slots;
+    vector<uint32> m_FreeSlots;
+};
+
 // Can be used as the LockType template parameter of a signal
 // When you do - the signal will use a mutex to protect it's function list.
 export struct SignalLockMutex
@@ -31,43 +107,49 @@ export struct SignalLockMutex
 };
 
 // Can be used as the LockType template parameter of a signal
-// When you do - the signal is lockless.
+// When you do - the signal is lockless. Its functions must not add or remove functions of the
+// same signal while it's being invoked.
 export struct SignalLockNull
 {
     auto Lock() { return 0; }
 };
 
+// Can be used as the LockType template parameter of a signal
+// When you do - invoking never blocks. Invoke calls an immutable snapshot of the function list,
+// and Add / Remove publish a new snapshot under a mutex only writers take.
+// Functions may add or remove functions (themselves included) while being invoked; the change
+// applies from the next invoke. An invoke already running on another thread may still call a
+// function after it has been removed.
+export struct SignalLockCopyOnWrite
+{
+    auto Lock() { return lock_guard(m_Mutex); }
+    mutex m_Mutex;
+};
+
 export template <typename T, typename LockType = SignalLockMutex>
 class Signal : public iSignalSubscribe<T>
 {
 public:
     using SignalSubscribe = iSignalSubscribe<T>;
-    using Delegate = function<T>;
-    using Token = list<Delegate>::iterator;
+    using Delegate = Core::Delegate<T>;
+    using Token = SignalToken;
 
     Token Add(Delegate func) override
     {
         auto lock = m_Lock.Lock();
-        m_Functions.push_back(func);
-        return --m_Functions.end();
+        return m_Functions.Add(move(func));
     }
 
     bool Remove(Token &token) override
     {
         auto lock = m_Lock.Lock();
-        if (token != m_Functions.end())
-        {
-            m_Functions.erase(token);
-            token = m_Functions.end();
-            return true;
-        }
-        return false;
+        return m_Functions.Remove(token);
     }
 
     template <typename... Args> void Invoke(Args &&...args) const
     {
         auto lock = m_Lock.Lock();
-        for (auto const &func : m_Functions)
+        for (auto const &func : m_Functions.Get())
         {
             func(forward<Args>(args)...);
         }
@@ -76,7 +158,7 @@ public:
     template <typename... Args> void operator()(Args &&...args) const
     {
         auto lock = m_Lock.Lock();
-        for (auto const &func : m_Functions)
+        for (auto const &func : m_Functions.Get())
         {
             func(forward<Args>(args)...);
         }
@@ -84,6 +166,136 @@ public:
 
 private:
     mutable LockType m_Lock;
-    list<Delegate> m_Functions;
+    SignalDelegates<T> m_Functions;
+};
+
+// Writers copy the delegates into a new snapshot on every change. That makes Add / Remove O(n),
+// which suits signals invoked far more often than they're subscribed to.
+export template <typename T>
+class Signal<T, SignalLockCopyOnWrite> : public iSignalSubscribe<T>
+{
+public:
+    using SignalSubscribe = iSignalSubscribe<T>;
+    using Delegate = Core::Delegate<T>;
+    using Token = SignalToken;
+
+    Token Add(Delegate func) override
+    {
+        auto lock = m_Lock.Lock();
+        Token const token = m_Functions.Add(move(func));
+        Publish();
+        return token;
+    }
+
+    bool Remove(Token &token) override
+    {
+        auto lock = m_Lock.Lock();
+        if (m_Functions.Remove(token))
+        {
+            Publish();
+            return true;
+        }
+        return false;
+    }
+
+    template <typename... Args> void Invoke(Args &&...args) const
+    {
+        // Holding the snapshot keeps it, and every function in it, alive until we're done.
+        shared_ptr<Snapshot const> const snapshot = m_Snapshot.load(memory_order_acquire);
+        if (snapshot)
+        {
+            for (auto const &func : *snapshot)
+            {
+                func(forward<Args>(args)...);
+            }
+        }
+    }
+
+    template <typename... Args> void operator()(Args &&...args) const
+    {
+        Invoke(forward<Args>(args)...);
+    }
+
+private:
+    using Snapshot = vector<Delegate>;
+
+    void Publish()
+    {
+        shared_ptr<Snapshot const> snapshot;
+        if (!m_Functions.Get().empty())
+        {
+            snapshot = MakePoolShared<Snapshot const>(m_Functions.Get());
+        }
+        m_Snapshot.store(move(snapshot), memory_order_release);
+    }
+
+    SignalLockCopyOnWrite m_Lock;
+    SignalDelegates<T> m_Functions;
+    atomic<shared_ptr<Snapshot const>> m_Snapshot;
+};
+
+export template <typename T> class QueuedSignal;
+
+/// <summary>
+/// A signal whose invocations are queued instead of run. Any thread can raise it; the handlers run
+/// later, in one batch, on whichever thread calls Dispatch (e.g. the main thread right after
+/// polling window events). Raising never blocks and never runs a handler.
+///
+/// Arguments are stored decayed (by value), so pointers and views passed in must stay valid until
+/// the event is dispatched. When more than the queue's capacity is raised between dispatches the
+/// extra events are dropped and counted.
+///
+/// Handlers may be added or removed from any thread, including from a handler.
+/// </summary>
+export template <typename... Args>
+class QueuedSignal<void(Args...)> : public iSignalSubscribe<void(Args...)>
+{
+public:
+    using SignalSubscribe = iSignalSubscribe<void(Args...)>;
+    using Delegate = Core::Delegate<void(Args...)>;
+    using Token = SignalToken;
+    using Payload = tuple<decay_t<Args>...>;
+
+    // capacity must be a power of two.
+    explicit QueuedSignal(usz capacity = 256) : m_Queue(capacity) {}
+
+    Token Add(Delegate func) override { return m_Signal.Add(move(func)); }
+
+    bool Remove(Token &token) override { return m_Signal.Remove(token); }
+
+    // Queues an event. Returns false when the queue is full and the event was dropped.
+    bool Enqueue(Args... args) const
+    {
+        if (!m_Queue.TryPush(Payload(forward<Args>(args)...)))
+        {
+            m_DroppedCount.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    void operator()(Args... args) const { Enqueue(forward<Args>(args)...); }
+
+    // Runs the handlers for the events queued so far, oldest first, and returns how many there
+    // were. Events raised while dispatching wait for the next call. One thread at a time.
+    usz Dispatch()
+    {
+        usz const pending = m_Queue.GetSizeApprox();
+        usz dispatched = 0;
+        Payload payload;
+        while (dispatched < pending && m_Queue.TryPop(payload))
+        {
+            apply([this](auto &...values) { m_Signal.Invoke(values...); }, payload);
+            ++dispatched;
+        }
+        return dispatched;
+    }
+
+    usz GetDroppedCount() const { return m_DroppedCount.load(memory_order_relaxed); }
+
+private:
+    mutable MPSCQueue<Payload> m_Queue;
+    mutable atomic<usz> m_DroppedCount = 0;
+    Signal<void(Args...), SignalLockCopyOnWrite> m_Signal;
 };
-} // namespace Lateralus
\ No newline at end of file
+} // namespace Lateralus
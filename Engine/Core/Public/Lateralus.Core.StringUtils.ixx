@@ -1,13 +1,206 @@
+module;
+
+#include <Core.SIMD.h>
+
 export module Lateralus.Core.StringUtils;
 
 import <algorithm>;
+import <bit>;
 import <string>;
 import <vector>;
 
+import Lateralus.Core;
+import Lateralus.Core.Dispatch;
+import Lateralus.Core.SIMDSupport;
+
 using namespace std;
 
 namespace Lateralus::Core::StringUtils
 {
+//////////////////////////////////////////////////////////////////////////
+// Byte set scanning
+// The search kernels behind SplitStringView for single byte character types. Each block of input is
+// compared against every byte in the set, so they're meant for the handful of delimiters
+// splitting usually deals with.
+
+bool IsInByteSet(char c, char const *set, usz setSize)
+{
+    return find(set, set + setSize, c) != set + setSize;
+}
+
+// Index of the first byte at or after start whose membership in set equals inSet, or size.
+using FindInByteSetFn = usz(char const *data, usz size, usz start, char const *set, usz setSize,
+                            bool inSet);
+// Number of bytes in data that are in set.
+using CountInByteSetFn = usz(char const *data, usz size, char const *set, usz setSize);
+
+usz FindInByteSetScalar(char const *data, usz size, usz start, char const *set, usz setSize,
+                        bool inSet)
+{
+    usz i = start;
+    while (i < size && IsInByteSet(data[i], set, setSize) != inSet)
+    {
+        ++i;
+    }
+    return i;
+}
+
+usz CountInByteSetScalar(char const *data, usz size, char const *set, usz setSize)
+{
+    return count_if(data, data + size,
+                    [set, setSize](char c) { return IsInByteSet(c, set, setSize); });
+}
+
+#if LATERALUS_SIMD_SSE
+// SSE2 is the x64 baseline, so this is the variant every x86 build can run.
+uint32 MatchByteSetSSE2(__m128i block, char const *set, usz setSize)
+{
+    __m128i matches = _mm_setzero_si128();
+    for (usz s = 0; s < setSize; ++s)
+    {
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(set[s])));
+    }
+    return static_cast<uint32>(_mm_movemask_epi8(matches));
+}
+
+usz FindInByteSetSSE2(char const *data, usz size, usz start, char const *set, usz setSize,
+                      bool inSet)
+{
+    uint32 const flip = inSet ? 0u : 0xFFFFu;
+    usz i = start;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + i));
+        uint32 const found = MatchByteSetSSE2(block, set, setSize) ^ flip;
+        if (found != 0)
+        {
+            return i + countr_zero(found);
+        }
+    }
+    return FindInByteSetScalar(data, size, i, set, setSize, inSet);
+}
+
+usz CountInByteSetSSE2(char const *data, usz size, char const *set, usz setSize)
+{
+    usz result = 0;
+    usz i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + i));
+        result += popcount(MatchByteSetSSE2(block, set, setSize));
+    }
+    return result + CountInByteSetScalar(data + i, size - i, set, setSize);
+}
+
+LATERALUS_TARGET_AVX2 uint32 MatchByteSetAVX2(__m256i block, char const *set, usz setSize)
+{
+    __m256i matches = _mm256_setzero_si256();
+    for (usz s = 0; s < setSize; ++s)
+    {
+        matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(set[s])));
+    }
+    return static_cast<uint32>(_mm256_movemask_epi8(matches));
+}
+
+LATERALUS_TARGET_AVX2 usz FindInByteSetAVX2(char const *data, usz size, usz start,
+                                            char const *set, usz setSize, bool inSet)
+{
+    uint32 const flip = inSet ? 0u : 0xFFFFFFFFu;
+    usz i = start;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i));
+        uint32 const found = MatchByteSetAVX2(block, set, setSize) ^ flip;
+        if (found != 0)
+        {
+            return i + _tzcnt_u32(found);
+        }
+    }
+    return FindInByteSetSSE2(data, size, i, set, setSize, inSet);
+}
+
+LATERALUS_TARGET_AVX2 usz CountInByteSetAVX2(char const *data, usz size, char const *set,
+                                             usz setSize)
+{
+    usz result = 0;
+    usz i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i));
+        result += popcount(MatchByteSetAVX2(block, set, setSize));
+    }
+    return result + CountInByteSetSSE2(data + i, size - i, set, setSize);
+}
+
+// Blocks are loaded with a mask so the tail needs no separate loop. Bytes outside the mask are
+// never reported.
+LATERALUS_TARGET_AVX512 uint64 MatchByteSetAVX512(__mmask64 load, char const *data,
+                                                  char const *set, usz setSize)
+{
+    __m512i const block = _mm512_maskz_loadu_epi8(load, data);
+    __mmask64 matches = 0;
+    for (usz s = 0; s < setSize; ++s)
+    {
+        matches |= _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8(set[s]));
+    }
+    return matches & load;
+}
+
+LATERALUS_TARGET_AVX512 __mmask64 LoadMask64(usz remaining)
+{
+    return remaining >= 64 ? ~__mmask64(0) : __mmask64((uint64(1) << remaining) - 1);
+}
+
+LATERALUS_TARGET_AVX512 usz FindInByteSetAVX512(char const *data, usz size, usz start,
+                                                char const *set, usz setSize, bool inSet)
+{
+    for (usz i = start; i < size; i += 64)
+    {
+        __mmask64 const load = LoadMask64(size - i);
+        uint64 found = MatchByteSetAVX512(load, data + i, set, setSize);
+        if (!inSet)
+        {
+            found = ~found & load;
+        }
+        if (found != 0)
+        {
+            return i + _tzcnt_u64(found);
+        }
+    }
+    return size;
+}
+
+LATERALUS_TARGET_AVX512 usz CountInByteSetAVX512(char const *data, usz size, char const *set,
+                                                 usz setSize)
+{
+    usz result = 0;
+    for (usz i = 0; i < size; i += 64)
+    {
+        result += popcount(MatchByteSetAVX512(LoadMask64(size - i), data + i, set, setSize));
+    }
+    return result;
+}
+#endif
+
+DispatchedFunction<FindInByteSetFn> g_FindInByteSet{
+#if LATERALUS_SIMD_SSE
+    {SSEVersion::None, &FindInByteSetSSE2},
+    {SSEVersion::AVX2, &FindInByteSetAVX2},
+    {SSEVersion::AVX512, &FindInByteSetAVX512},
+#else
+    {SSEVersion::None, &FindInByteSetScalar},
+#endif
+};
+
+DispatchedFunction<CountInByteSetFn> g_CountInByteSet{
+#if LATERALUS_SIMD_SSE
+    {SSEVersion::None, &CountInByteSetSSE2},
+    {SSEVersion::AVX2, &CountInByteSetAVX2},
+    {SSEVersion::AVX512, &CountInByteSetAVX512},
+#else
+    {SSEVersion::None, &CountInByteSetScalar},
+#endif
+};
 
 template <typename CharType> bool CaseInsensitiveCompareChar(CharType a, CharType b)
 {
@@ -55,51 +248,64 @@ export bool CaseInsensitiveCompare(char8_t a, char8_t b)
 /// </summary>
 /// <param name="input">The input string to split.</param>
 /// <param name="delims">A string with characters to split on.</param>
+/// <param name="allocator">Allocates the result, for example GetFrameAllocator for a
+/// std::pmr::vector that only lives for the frame.</param>
 /// <returns>A collection of string views for each non-delim sequence.</returns>
-export template <typename string_view_type>
-vector<string_view_type> SplitStringView(string_view_type const &input,
-                                         string_view_type const &delims)
+export template <typename string_view_type, typename Allocator = allocator<string_view_type>>
+vector<string_view_type, Allocator> SplitStringView(string_view_type const &input,
+                                                    string_view_type const &delims,
+                                                    Allocator const &allocator = Allocator())
 {
-    auto IsDelimChar = [delims](char8_t c) {
-        return delims.find_first_of(c) != string_view_type::npos;
-    };
-
-    vector<string_view_type> result;
+    using char_type = typename string_view_type::value_type;
 
-    // fast forward to the first legitimate begining position
-    // (needed when strings begin with delims)
-    size_t i = 0;
-    while (i < input.size() && IsDelimChar(input[i]))
-    {
-        ++i;
-    }
-    size_t lastStart = i;
-
-    // Guarentee one allocation for the function.
-    result.reserve(count_if(input.begin(), input.end(), IsDelimChar));
-
-    for (; i < input.size(); ++i)
-    {
-        if (IsDelimChar(input[i]))
+    // Single byte characters go through the vectorized scanning kernels.
+    auto FindDelim = [&input, &delims](size_t from, bool isDelim) -> size_t {
+        if constexpr (sizeof(char_type) == 1)
         {
-            // add the new string up to this point
-            result.emplace_back(input.substr(lastStart, i - lastStart));
-
-            // skip all following delims
-            while (i < input.size() && IsDelimChar(input[i]))
+            return g_FindInByteSet(reinterpret_cast<char const *>(input.data()), input.size(), from,
+                                   reinterpret_cast<char const *>(delims.data()), delims.size(),
+                                   isDelim);
+        }
+        else
+        {
+            while (from < input.size() &&
+                   (delims.find_first_of(input[from]) != string_view_type::npos) != isDelim)
             {
-                ++i;
+                ++from;
             }
-
-            // record a new starting position
-            lastStart = i;
+            return from;
         }
-    }
+    };
+    auto CountDelims = [&input, &delims]() -> size_t {
+        if constexpr (sizeof(char_type) == 1)
+        {
+            return g_CountInByteSet(reinterpret_cast<char const *>(input.data()), input.size(),
+                                    reinterpret_cast<char const *>(delims.data()), delims.size());
+        }
+        else
+        {
+            return count_if(input.begin(), input.end(), [&delims](char_type c) {
+                return delims.find_first_of(c) != string_view_type::npos;
+            });
+        }
+    };
 
-    // (needed when strings don't end in delims)
-    if (lastStart < input.size())
+    vector<string_view_type, Allocator> result(allocator);
+
+    // Guarentee one allocation for the function.
+    result.reserve(CountDelims());
+
+    // fast forward to the first legitimate begining position
+    // (needed when strings begin with delims)
+    size_t i = FindDelim(0, false);
+    while (i < input.size())
     {
-        result.emplace_back(&input.data()[lastStart], input.size() - lastStart);
+        // add the string up to the next delim (or the end, when strings don't end in delims)
+        size_t const end = FindDelim(i, true);
+        result.emplace_back(input.substr(i, end - i));
+
+        // skip all following delims and record a new starting position
+        i = FindDelim(end, false);
     }
 
     return result;
@@ -0,0 +1,464 @@
+module;
+
+#include <Core.Assert.h>
+
+export module Lateralus.Core.Task;
+
+import <array>;
+import <atomic>;
+import <coroutine>;
+import <exception>;
+import <mutex>;
+import <optional>;
+import <span>;
+import <type_traits>;
+import <utility>;
+import <vector>;
+
+import Lateralus.Core;
+import Lateralus.Core.Jobs;
+import Lateralus.Core.Memory;
+
+namespace Lateralus::Core
+{
+export template <typename T = void> class Task;
+
+// Continues whatever awaited the task once its body is done.
+struct TaskFinalAwaiter
+{
+    bool await_ready() noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+    {
+        return handle.promise().Finish();
+    }
+
+    void await_resume() noexcept {}
+};
+
+// What Task<T> and Task<void> promises share: where to continue once the body is done.
+class TaskPromiseBase
+{
+public:
+    // Coroutine frames come from the pool; tasks are made and finished at a high rate.
+    static void *operator new(usz bytes) { return PoolAllocate(bytes); }
+    static void operator delete(void *frame, usz bytes) { PoolFree(frame, bytes); }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    TaskFinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() { m_Exception = std::current_exception(); }
+
+    bool IsDone() const { return m_Done.load(std::memory_order_acquire); }
+
+    void SetContinuation(std::coroutine_handle<> continuation) { m_Continuation = continuation; }
+
+    std::coroutine_handle<> Finish() noexcept
+    {
+        // Read before publishing: once done, the owner may destroy the frame.
+        std::coroutine_handle<> const continuation = m_Continuation;
+        m_Done.store(true, std::memory_order_release);
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+protected:
+    void RethrowIfFailed() const
+    {
+        if (m_Exception)
+        {
+            std::rethrow_exception(m_Exception);
+        }
+    }
+
+private:
+    std::coroutine_handle<> m_Continuation;
+    std::exception_ptr m_Exception;
+    std::atomic<bool> m_Done = false;
+};
+
+template <typename T> class TaskPromise : public TaskPromiseBase
+{
+public:
+    Task<T> get_return_object();
+
+    template <typename Value>
+        requires std::is_convertible_v<Value &&, T>
+    void return_value(Value &&value)
+    {
+        m_Value.emplace(std::forward<Value>(value));
+    }
+
+    T &GetResult()
+    {
+        RethrowIfFailed();
+        return *m_Value;
+    }
+
+    // Moves the value out, for awaiting a temporary task whose frame goes with it.
+    T TakeResult()
+    {
+        RethrowIfFailed();
+        return std::move(*m_Value);
+    }
+
+private:
+    std::optional<T> m_Value;
+};
+
+template <> class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+    Task<void> get_return_object();
+
+    void return_void() {}
+
+    void GetResult() { RethrowIfFailed(); }
+
+    void TakeResult() { RethrowIfFailed(); }
+};
+
+/// <summary>
+/// The result of a coroutine that produces a T. The body doesn't start until the task is awaited
+/// with co_await, or started with Start, and an awaiting coroutine continues on whichever thread
+/// the task finishes on.
+///
+/// Each task is awaited or started once. Moving to a worker or the main thread is explicit, see
+/// ResumeOn and ResumeQueue:
+///
+///     Task<int> CountLines(JobSystem &jobs, ResumeQueue &mainThread)
+///     {
+///         co_await ResumeOn(jobs);
+///         int lines = ...;
+///         co_await mainThread;
+///         co_return lines;
+///     }
+/// </summary>
+export template <typename T> class [[nodiscard]] Task
+{
+public:
+    using promise_type = TaskPromise<T>;
+
+    Task() = default;
+    explicit Task(std::coroutine_handle<promise_type> handle) : m_Handle(handle) {}
+    Task(Task &&other) noexcept : m_Handle(std::exchange(other.m_Handle, nullptr)) {}
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Destroy();
+            m_Handle = std::exchange(other.m_Handle, nullptr);
+        }
+        return *this;
+    }
+    Task(Task const &) = delete;
+    Task &operator=(Task const &) = delete;
+
+    // A task must be done, or never started, by the time it's destroyed.
+    ~Task() { Destroy(); }
+
+    // Runs the body on the calling thread up to its first suspension, for tasks nothing awaits.
+    // Poll IsDone to find out when it has finished.
+    void Start()
+    {
+        LAT_ASSERT(m_Handle && !m_Handle.done());
+        m_Handle.resume();
+    }
+
+    bool IsDone() const { return m_Handle && m_Handle.promise().IsDone(); }
+
+    // The value returned by the body, or its exception rethrown. Only once done.
+    decltype(auto) Get()
+    {
+        LAT_ASSERT(IsDone());
+        return m_Handle.promise().GetResult();
+    }
+
+    // Awaiting a task kept in a variable gives a reference to its value, like Get.
+    auto operator co_await() & noexcept
+    {
+        LAT_ASSERT(m_Handle);
+        return Awaiter<false>{m_Handle};
+    }
+
+    // Awaiting a temporary, e.g. co_await MakeTask(), gives the value itself. The frame holding it
+    // is destroyed with the task at the end of the full expression.
+    auto operator co_await() && noexcept
+    {
+        LAT_ASSERT(m_Handle);
+        return Awaiter<true>{m_Handle};
+    }
+
+private:
+    template <bool TakeResult> struct Awaiter
+    {
+        std::coroutine_handle<promise_type> Handle;
+
+        bool await_ready() const noexcept { return Handle.promise().IsDone(); }
+
+        // Symmetric transfer: starting the task doesn't grow the stack.
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            Handle.promise().SetContinuation(awaiting);
+            return Handle;
+        }
+
+        decltype(auto) await_resume()
+        {
+            if constexpr (TakeResult)
+            {
+                return Handle.promise().TakeResult();
+            }
+            else
+            {
+                return Handle.promise().GetResult();
+            }
+        }
+    };
+
+    void Destroy()
+    {
+        if (m_Handle)
+        {
+            m_Handle.destroy();
+            m_Handle = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> m_Handle;
+};
+
+template <typename T> Task<T> TaskPromise<T>::get_return_object()
+{
+    return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object()
+{
+    return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+// co_await ResumeOn(jobs) continues the coroutine as a job on one of the system's threads.
+export auto ResumeOn(JobSystem &jobs)
+{
+    struct Awaiter
+    {
+        JobSystem &Jobs;
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            Jobs.Run([handle] { handle.resume(); });
+        }
+
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{jobs};
+}
+
+/// <summary>
+/// Coroutines waiting for a particular thread. co_await on the queue suspends until that thread
+/// calls ResumeAll, which continues them on it.
+///
+/// Coroutines queued while ResumeAll runs are left for the next call.
+/// </summary>
+export class ResumeQueue
+{
+public:
+    ResumeQueue() = default;
+    ResumeQueue(ResumeQueue const &) = delete;
+    ResumeQueue &operator=(ResumeQueue const &) = delete;
+
+    auto operator co_await() noexcept
+    {
+        struct Awaiter
+        {
+            ResumeQueue &Queue;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                std::lock_guard lock(Queue.m_Mutex);
+                Queue.m_Queued.push_back(handle);
+            }
+
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    // Returns how many coroutines were continued.
+    usz ResumeAll()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Resuming.swap(m_Queued);
+        }
+        usz const count = m_Resuming.size();
+        for (std::coroutine_handle<> handle : m_Resuming)
+        {
+            handle.resume();
+        }
+        m_Resuming.clear();
+        return count;
+    }
+
+private:
+    std::mutex m_Mutex;
+    std::vector<std::coroutine_handle<>> m_Queued;
+    // Kept between calls so its capacity is reused.
+    std::vector<std::coroutine_handle<>> m_Resuming;
+};
+
+// Shared by the branches of one WhenAll: the last to finish continues the awaiting coroutine.
+struct WhenAllLatch
+{
+    std::atomic<usz> Remaining;
+    std::coroutine_handle<> Awaiting;
+};
+
+// Awaits one task of a WhenAll and counts it off the latch when done.
+class WhenAllBranch
+{
+public:
+    struct promise_type
+    {
+        template <typename Awaitable>
+        promise_type(Awaitable &, WhenAllLatch &latch) : Latch(&latch)
+        {
+        }
+
+        WhenAllBranch get_return_object()
+        {
+            return WhenAllBranch(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        auto final_suspend() noexcept
+        {
+            struct FinalAwaiter
+            {
+                bool await_ready() noexcept { return false; }
+
+                std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+                {
+                    WhenAllLatch &latch = *handle.promise().Latch;
+                    if (latch.Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        return latch.Awaiting;
+                    }
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() noexcept {}
+            };
+            return FinalAwaiter{};
+        }
+
+        void return_void() {}
+
+        // The exception stays with the task; Get rethrows it.
+        void unhandled_exception() {}
+
+        WhenAllLatch *Latch;
+    };
+
+    WhenAllBranch() = default;
+    explicit WhenAllBranch(std::coroutine_handle<promise_type> handle) : m_Handle(handle) {}
+    WhenAllBranch(WhenAllBranch &&other) noexcept
+        : m_Handle(std::exchange(other.m_Handle, nullptr))
+    {
+    }
+    WhenAllBranch &operator=(WhenAllBranch &&other) noexcept
+    {
+        std::swap(m_Handle, other.m_Handle);
+        return *this;
+    }
+    ~WhenAllBranch()
+    {
+        if (m_Handle)
+        {
+            m_Handle.destroy();
+        }
+    }
+
+    void Start() { m_Handle.resume(); }
+
+private:
+    std::coroutine_handle<promise_type> m_Handle;
+};
+
+template <typename Awaitable> WhenAllBranch AwaitBranch(Awaitable &task, WhenAllLatch &)
+{
+    try
+    {
+        co_await task;
+    }
+    catch (...)
+    {
+        // Left in the task for its owner.
+    }
+}
+
+// Starts every branch, suspending the caller until all have finished.
+template <typename Branches> class WhenAllAwaiter
+{
+public:
+    template <typename MakeBranches>
+    WhenAllAwaiter(usz count, MakeBranches &&makeBranches)
+        : m_Latch{count + 1, nullptr}, m_Branches(makeBranches(m_Latch))
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> awaiting)
+    {
+        m_Latch.Awaiting = awaiting;
+        for (WhenAllBranch &branch : m_Branches)
+        {
+            branch.Start();
+        }
+        // The extra count keeps the branches from resuming the caller before it has suspended.
+        return m_Latch.Remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    WhenAllLatch m_Latch;
+    Branches m_Branches;
+};
+
+/// <summary>
+/// co_await WhenAll(a, b, ...) starts the tasks and continues once every one of them has
+/// finished, on the thread of whichever finished last. The results stay in the tasks, read them
+/// with Get.
+/// </summary>
+export template <typename... Ts> auto WhenAll(Task<Ts> &...tasks)
+{
+    using Branches = std::array<WhenAllBranch, sizeof...(Ts)>;
+    return WhenAllAwaiter<Branches>(sizeof...(Ts), [&tasks...](WhenAllLatch &latch) {
+        return Branches{AwaitBranch(tasks, latch)...};
+    });
+}
+
+export template <typename T> auto WhenAll(std::span<Task<T>> tasks)
+{
+    using Branches = std::vector<WhenAllBranch>;
+    return WhenAllAwaiter<Branches>(tasks.size(), [tasks](WhenAllLatch &latch) {
+        Branches branches;
+        branches.reserve(tasks.size());
+        for (Task<T> &task : tasks)
+        {
+            branches.push_back(AwaitBranch(task, latch));
+        }
+        return branches;
+    });
+}
+} // namespace Lateralus::Core
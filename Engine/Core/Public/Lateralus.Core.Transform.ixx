@@ -0,0 +1,352 @@
+module;
+
+#include <Core.Assert.h>
+
+export module Lateralus.Core.Transform;
+
+import <algorithm>;
+import <atomic>;
+import <vector>;
+
+import Lateralus.Core;
+import Lateralus.Core.Matrix;
+import Lateralus.Core.Quaternion;
+import Lateralus.Core.Vector;
+
+namespace Lateralus::Core
+{
+// Same as CreateTranslation(translation) * rotation.ToMatrix() * CreateScale(scale), without the
+// two matrix products.
+export constexpr Matrix4x4 CreateTRS(Vector3 const &translation, Quaternion const &rotation,
+                                     Vector3 const &scale)
+{
+    Matrix4x4 result = rotation.ToMatrix();
+    Vector4 const columnScale(scale.x, scale.y, scale.z, 1.0f);
+    result.r0 = result.r0 * columnScale;
+    result.r1 = result.r1 * columnScale;
+    result.r2 = result.r2 * columnScale;
+    result.r0.w = translation.x;
+    result.r1.w = translation.y;
+    result.r2.w = translation.z;
+    return result;
+}
+
+// Stable handle to a node in a TransformHierarchy. Default constructed ids refer to nothing.
+export struct TransformId
+{
+    static constexpr uint32 k_Invalid = ~0u;
+
+    uint32 Index = k_Invalid;
+
+    constexpr bool IsValid() const { return Index != k_Invalid; }
+    constexpr bool operator==(TransformId const &) const = default;
+};
+
+/// <summary>
+/// A scene graph of translation/rotation/scale transforms and the world matrices they produce.
+///
+/// Nodes are kept in arrays sorted by depth, so one pass over them in order always sees a parent
+/// before its children, and every node of one depth can be updated at the same time. Setting a
+/// local transform marks the node dirty; Update recomputes only dirty nodes and their descendants.
+///
+/// Structural changes (Create, SetParent, Destroy) re-sort the arrays at the next Update, so they
+/// cost O(node count) once per frame however many there were.
+///
+/// Not thread safe: nothing may touch the hierarchy while Update runs, except the ranges Update
+/// hands to its parallelFor.
+/// </summary>
+export class TransformHierarchy
+{
+public:
+    // Adds a node with an identity local transform under parent, or as a root.
+    TransformId Create(TransformId parent = {})
+    {
+        uint32 id;
+        if (m_FreeIds.empty())
+        {
+            id = static_cast<uint32>(m_Slots.size());
+            m_Slots.push_back(k_NoSlot);
+        }
+        else
+        {
+            id = m_FreeIds.back();
+            m_FreeIds.pop_back();
+        }
+
+        uint32 const slot = static_cast<uint32>(m_Ids.size());
+        m_Slots[id] = slot;
+        m_Ids.push_back(id);
+        m_Parents.push_back(parent.IsValid() ? SlotOf(parent) : k_NoSlot);
+        m_Positions.emplace_back();
+        m_Rotations.emplace_back();
+        m_Scales.emplace_back(1.0f, 1.0f, 1.0f);
+        m_WorldMatrices.emplace_back();
+        m_Dirty.push_back(1);
+        // Appended at the end for now; it moves into its level at the next Update.
+        m_NeedsSort = true;
+        return TransformId{id};
+    }
+
+    // Removes the node and everything below it. Their ids become invalid.
+    void Destroy(TransformId id)
+    {
+        SortIfNeeded();
+        uint32 const root = SlotOf(id);
+        // Descendants come later in depth order, so one pass finds them all.
+        std::vector<uint8> doomed(m_Ids.size(), 0);
+        doomed[root] = 1;
+        for (usz slot = root + 1; slot < m_Ids.size(); ++slot)
+        {
+            doomed[slot] = m_Parents[slot] != k_NoSlot && doomed[m_Parents[slot]];
+        }
+        for (usz slot = root; slot < m_Ids.size(); ++slot)
+        {
+            if (doomed[slot])
+            {
+                m_Slots[m_Ids[slot]] = k_NoSlot;
+                m_FreeIds.push_back(m_Ids[slot]);
+                m_Ids[slot] = k_NoSlot;
+            }
+        }
+        m_NeedsSort = true;
+    }
+
+    // Moves the node, with its subtree, under parent, or makes it a root. Its local transform is
+    // kept, so its world transform changes with the new parent.
+    void SetParent(TransformId id, TransformId parent)
+    {
+        uint32 const slot = SlotOf(id);
+        uint32 const parentSlot = parent.IsValid() ? SlotOf(parent) : k_NoSlot;
+        for (uint32 it = parentSlot; it != k_NoSlot; it = m_Parents[it])
+        {
+            LAT_ASSERT(it != slot); // would create a cycle
+        }
+        m_Parents[slot] = parentSlot;
+        m_Dirty[slot] = 1;
+        m_NeedsSort = true;
+    }
+
+    TransformId GetParent(TransformId id) const
+    {
+        uint32 const parent = m_Parents[SlotOf(id)];
+        return parent == k_NoSlot ? TransformId{} : TransformId{m_Ids[parent]};
+    }
+
+    bool Contains(TransformId id) const
+    {
+        return id.IsValid() && id.Index < m_Slots.size() && m_Slots[id.Index] != k_NoSlot;
+    }
+
+    void SetLocalPosition(TransformId id, Vector3 const &position)
+    {
+        uint32 const slot = SlotOf(id);
+        m_Positions[slot] = position;
+        m_Dirty[slot] = 1;
+    }
+
+    void SetLocalRotation(TransformId id, Quaternion const &rotation)
+    {
+        uint32 const slot = SlotOf(id);
+        m_Rotations[slot] = rotation;
+        m_Dirty[slot] = 1;
+    }
+
+    void SetLocalScale(TransformId id, Vector3 const &scale)
+    {
+        uint32 const slot = SlotOf(id);
+        m_Scales[slot] = scale;
+        m_Dirty[slot] = 1;
+    }
+
+    void SetLocal(TransformId id, Vector3 const &position, Quaternion const &rotation,
+                  Vector3 const &scale)
+    {
+        uint32 const slot = SlotOf(id);
+        m_Positions[slot] = position;
+        m_Rotations[slot] = rotation;
+        m_Scales[slot] = scale;
+        m_Dirty[slot] = 1;
+    }
+
+    Vector3 const &GetLocalPosition(TransformId id) const { return m_Positions[SlotOf(id)]; }
+    Quaternion const &GetLocalRotation(TransformId id) const { return m_Rotations[SlotOf(id)]; }
+    Vector3 const &GetLocalScale(TransformId id) const { return m_Scales[SlotOf(id)]; }
+
+    // The world matrix as of the last Update.
+    Matrix4x4 const &GetWorldMatrix(TransformId id) const
+    {
+        return m_WorldMatrices[SlotOf(id)];
+    }
+
+    usz GetCount() const { return m_Slots.size() - m_FreeIds.size(); }
+    // Number of distinct depths, i.e. the number of sequential steps Update takes.
+    usz GetLevelCount() const { return m_LevelStarts.empty() ? 0 : m_LevelStarts.size() - 1; }
+
+    // Recomputes world matrices on the calling thread. Returns how many were recomputed.
+    usz Update()
+    {
+        return Update([](usz count, auto &&function) { function(0, count); });
+    }
+
+    /// <summary>
+    /// Recomputes world matrices one depth level at a time, splitting each level with parallelFor.
+    /// It's called as parallelFor(usz count, function) and must call function(usz begin, usz end)
+    /// on ranges covering [0, count) exactly once, on any threads, returning once all are done.
+    /// Returns how many world matrices were recomputed.
+    /// </summary>
+    template <typename ParallelFor> usz Update(ParallelFor &&parallelFor)
+    {
+        SortIfNeeded();
+        std::atomic<usz> updated = 0;
+        for (usz level = 0; level + 1 < m_LevelStarts.size(); ++level)
+        {
+            usz const first = m_LevelStarts[level];
+            usz const count = m_LevelStarts[level + 1] - first;
+            parallelFor(count, [&](usz begin, usz end) {
+                updated.fetch_add(UpdateRange(first + begin, first + end),
+                                  std::memory_order_relaxed);
+            });
+        }
+        // A node's flag told its children to update; every level is done with them now.
+        std::fill(m_Dirty.begin(), m_Dirty.end(), uint8(0));
+        return updated.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32 k_NoSlot = ~0u;
+
+    uint32 SlotOf(TransformId id) const
+    {
+        LAT_ASSERT(Contains(id));
+        return m_Slots[id.Index];
+    }
+
+    usz UpdateRange(usz begin, usz end)
+    {
+        usz updated = 0;
+        for (usz slot = begin; slot < end; ++slot)
+        {
+            uint32 const parent = m_Parents[slot];
+            bool const parentChanged = parent != k_NoSlot && m_Dirty[parent];
+            if (!m_Dirty[slot] && !parentChanged)
+            {
+                continue;
+            }
+            Matrix4x4 const local = CreateTRS(m_Positions[slot], m_Rotations[slot], m_Scales[slot]);
+            m_WorldMatrices[slot] = parent == k_NoSlot ? local : m_WorldMatrices[parent] * local;
+            m_Dirty[slot] = 1;
+            ++updated;
+        }
+        return updated;
+    }
+
+    // Drops destroyed nodes and restores depth order after structural changes.
+    void SortIfNeeded()
+    {
+        if (!m_NeedsSort)
+        {
+            return;
+        }
+        m_NeedsSort = false;
+
+        // Reparenting can put a parent after its child, so depths are found by walking up.
+        usz const count = m_Ids.size();
+        std::vector<uint32> depths(count, k_NoSlot);
+        std::vector<uint32> path;
+        uint32 maxDepth = 0;
+        usz liveCount = 0;
+        for (usz slot = 0; slot < count; ++slot)
+        {
+            if (m_Ids[slot] == k_NoSlot)
+            {
+                continue;
+            }
+            ++liveCount;
+            uint32 it = static_cast<uint32>(slot);
+            while (it != k_NoSlot && depths[it] == k_NoSlot)
+            {
+                path.push_back(it);
+                it = m_Parents[it];
+            }
+            uint32 depth = it == k_NoSlot ? 0 : depths[it] + 1;
+            for (usz n = path.size(); n-- > 0; ++depth)
+            {
+                depths[path[n]] = depth;
+            }
+            maxDepth = std::max(maxDepth, depth - 1);
+            path.clear();
+        }
+
+        // Counting sort by depth. It's stable, so nodes that didn't move keep their order.
+        m_LevelStarts.assign(liveCount > 0 ? maxDepth + 2 : 0, 0);
+        for (usz slot = 0; slot < count; ++slot)
+        {
+            if (m_Ids[slot] != k_NoSlot)
+            {
+                ++m_LevelStarts[depths[slot] + 1];
+            }
+        }
+        for (usz level = 1; level < m_LevelStarts.size(); ++level)
+        {
+            m_LevelStarts[level] += m_LevelStarts[level - 1];
+        }
+
+        std::vector<uint32> newSlots(count, k_NoSlot);
+        std::vector<usz> cursors(m_LevelStarts);
+        for (usz slot = 0; slot < count; ++slot)
+        {
+            if (m_Ids[slot] != k_NoSlot)
+            {
+                newSlots[slot] = static_cast<uint32>(cursors[depths[slot]]++);
+            }
+        }
+
+        std::vector<uint32> ids(liveCount), parents(liveCount);
+        std::vector<Vector3> positions(liveCount), scales(liveCount);
+        std::vector<Quaternion> rotations(liveCount);
+        std::vector<Matrix4x4> worldMatrices(liveCount);
+        std::vector<uint8> dirty(liveCount);
+        for (usz slot = 0; slot < count; ++slot)
+        {
+            uint32 const to = newSlots[slot];
+            if (to == k_NoSlot)
+            {
+                continue;
+            }
+            uint32 const parent = m_Parents[slot];
+            ids[to] = m_Ids[slot];
+            parents[to] = parent == k_NoSlot ? k_NoSlot : newSlots[parent];
+            positions[to] = m_Positions[slot];
+            rotations[to] = m_Rotations[slot];
+            scales[to] = m_Scales[slot];
+            worldMatrices[to] = m_WorldMatrices[slot];
+            dirty[to] = m_Dirty[slot];
+            m_Slots[m_Ids[slot]] = to;
+        }
+        m_Ids = std::move(ids);
+        m_Parents = std::move(parents);
+        m_Positions = std::move(positions);
+        m_Rotations = std::move(rotations);
+        m_Scales = std::move(scales);
+        m_WorldMatrices = std::move(worldMatrices);
+        m_Dirty = std::move(dirty);
+    }
+
+    // Indexed by TransformId::Index: the node's current slot in the arrays below.
+    std::vector<uint32> m_Slots;
+    std::vector<uint32> m_FreeIds;
+
+    // Indexed by slot, sorted by depth.
+    std::vector<uint32> m_Ids;
+    std::vector<uint32> m_Parents;
+    std::vector<Vector3> m_Positions;
+    std::vector<Quaternion> m_Rotations;
+    std::vector<Vector3> m_Scales;
+    std::vector<Matrix4x4> m_WorldMatrices;
+    std::vector<uint8> m_Dirty;
+
+    // Level d holds slots [m_LevelStarts[d], m_LevelStarts[d + 1]).
+    std::vector<usz> m_LevelStarts;
+    bool m_NeedsSort = false;
+};
+} // namespace Lateralus::Core
@@ -1,10 +1,9 @@
-module;
-
-#include <math.h>
-
 export module Lateralus.Core.Vector;
 
+import <type_traits>;
+
 import Lateralus.Core.Math;
+import Lateralus.Core.SIMD;
 
 namespace Lateralus::Core
 {
@@ -14,24 +13,24 @@ namespace Lateralus::Core
         constexpr Vector2() = default;
         constexpr Vector2(float x, float y) : x(x), y(y) {}
         constexpr Vector2(Vector2 const& o) = default;
-        Vector2& operator=(Vector2 const& o) = default;
+        constexpr Vector2& operator=(Vector2 const& o) = default;
 
-        Vector2 operator + (Vector2 const& o) const { return Vector2(x + o.x, y + o.y); }
-        Vector2 operator - (Vector2 const& o) const { return Vector2(x - o.x, y - o.y); }
-        Vector2 operator * (Vector2 const& o) const { return Vector2(x * o.x, y * o.y); }
-        Vector2 operator / (Vector2 const& o) const { return Vector2(x / o.x, y / o.y); }
+        constexpr Vector2 operator + (Vector2 const& o) const { return Vector2(x + o.x, y + o.y); }
+        constexpr Vector2 operator - (Vector2 const& o) const { return Vector2(x - o.x, y - o.y); }
+        constexpr Vector2 operator * (Vector2 const& o) const { return Vector2(x * o.x, y * o.y); }
+        constexpr Vector2 operator / (Vector2 const& o) const { return Vector2(x / o.x, y / o.y); }
 
-        Vector2& operator += (Vector2 const& o) { x += o.x; y += o.y; return *this; }
-        Vector2& operator -= (Vector2 const& o) { x -= o.x; y -= o.y; return *this; }
-        Vector2& operator *= (Vector2 const& o) { x *= o.x; y *= o.y; return *this; }
-        Vector2& operator /= (Vector2 const& o) { x /= o.x; y /= o.y; return *this; }
+        constexpr Vector2& operator += (Vector2 const& o) { x += o.x; y += o.y; return *this; }
+        constexpr Vector2& operator -= (Vector2 const& o) { x -= o.x; y -= o.y; return *this; }
+        constexpr Vector2& operator *= (Vector2 const& o) { x *= o.x; y *= o.y; return *this; }
+        constexpr Vector2& operator /= (Vector2 const& o) { x /= o.x; y /= o.y; return *this; }
 
-        bool ExactlyEquals(Vector2 const& o) const { return (x==o.x)&&(y==o.y); }
-        bool RoughlyEquals(Vector2 const& o) const { return CloseEnough(x, o.x) && CloseEnough(y, o.y); }
+        constexpr bool ExactlyEquals(Vector2 const& o) const { return (x==o.x)&&(y==o.y); }
+        constexpr bool RoughlyEquals(Vector2 const& o) const { return CloseEnough(x, o.x) && CloseEnough(y, o.y); }
 
-        float LengthSq() const { return (x * x) + (y * y); }
-        float Length() const { return sqrt((x * x) + (y * y)); }
-        void Normalize() {
+        constexpr float LengthSq() const { return (x * x) + (y * y); }
+        constexpr float Length() const { return Sqrt((x * x) + (y * y)); }
+        constexpr void Normalize() {
             float l = Length();
             if(l != 0.0f)
             {
@@ -39,7 +38,7 @@ namespace Lateralus::Core
                 y /= l;
             }
         }
-        Vector2 Normalized() const {
+        constexpr Vector2 Normalized() const {
             float l = Length();
             if(l != 0.0f)
             {
@@ -58,27 +57,27 @@ namespace Lateralus::Core
         constexpr Vector3() = default;
         constexpr Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
         constexpr Vector3(Vector3 const& o) = default;
-        Vector3& operator=(Vector3 const& o) = default;
+        constexpr Vector3& operator=(Vector3 const& o) = default;
 
-        Vector3 operator + (Vector3 const& o) const { return Vector3(x + o.x, y + o.y, z + o.z); }
-        Vector3 operator - (Vector3 const& o) const { return Vector3(x - o.x, y - o.y, z - o.z); }
-        Vector3 operator * (Vector3 const& o) const { return Vector3(x * o.x, y * o.y, z * o.z); }
-        Vector3 operator / (Vector3 const& o) const { return Vector3(x / o.x, y / o.y, z / o.z); }
+        constexpr Vector3 operator + (Vector3 const& o) const { return Vector3(x + o.x, y + o.y, z + o.z); }
+        constexpr Vector3 operator - (Vector3 const& o) const { return Vector3(x - o.x, y - o.y, z - o.z); }
+        constexpr Vector3 operator * (Vector3 const& o) const { return Vector3(x * o.x, y * o.y, z * o.z); }
+        constexpr Vector3 operator / (Vector3 const& o) const { return Vector3(x / o.x, y / o.y, z / o.z); }
 
-        Vector3& operator += (Vector3 const& o) { x += o.x; y += o.y; z += o.z; return *this; }
-        Vector3& operator -= (Vector3 const& o) { x -= o.x; y -= o.y; z -= o.z; return *this; }
-        Vector3& operator *= (Vector3 const& o) { x *= o.x; y *= o.y; z *= o.z; return *this; }
-        Vector3& operator /= (Vector3 const& o) { x /= o.x; y /= o.y; z /= o.z; return *this; }
+        constexpr Vector3& operator += (Vector3 const& o) { x += o.x; y += o.y; z += o.z; return *this; }
+        constexpr Vector3& operator -= (Vector3 const& o) { x -= o.x; y -= o.y; z -= o.z; return *this; }
+        constexpr Vector3& operator *= (Vector3 const& o) { x *= o.x; y *= o.y; z *= o.z; return *this; }
+        constexpr Vector3& operator /= (Vector3 const& o) { x /= o.x; y /= o.y; z /= o.z; return *this; }
 
-        bool ExactlyEquals(Vector3 const& o) const { return (x==o.x)&&(y==o.y)&&(z==o.z); }
-        bool RoughlyEquals(Vector3 const& o) const
+        constexpr bool ExactlyEquals(Vector3 const& o) const { return (x==o.x)&&(y==o.y)&&(z==o.z); }
+        constexpr bool RoughlyEquals(Vector3 const& o) const
         {
             return CloseEnough(x, o.x) && CloseEnough(y, o.y) && CloseEnough(z, o.z);
         }
 
-        float LengthSq() const { return (x * x) + (y * y) + (z * z); }
-        float Length() const { return sqrt((x * x) + (y * y) + (z * z)); }
-        void Normalize() {
+        constexpr float LengthSq() const { return (x * x) + (y * y) + (z * z); }
+        constexpr float Length() const { return Sqrt((x * x) + (y * y) + (z * z)); }
+        constexpr void Normalize() {
             float l = Length();
             if(l != 0.0f)
             {
@@ -87,7 +86,7 @@ namespace Lateralus::Core
                 z /= l;
             }
         }
-        Vector3 Normalized() const {
+        constexpr Vector3 Normalized() const {
             float l = Length();
             if(l != 0.0f)
             {
@@ -95,13 +94,13 @@ namespace Lateralus::Core
             }
             return Vector3();
         }
-        float Sum() const {
+        constexpr float Sum() const {
             return x + y + z;
         }
-        float Dot(Vector3 const& o) const {
+        constexpr float Dot(Vector3 const& o) const {
             return ((*this) * o).Sum();
         }
-        Vector3 Cross(Vector3 const &o) const {
+        constexpr Vector3 Cross(Vector3 const &o) const {
             return Vector3(
             y * o.z - z * o.y,
             z * o.x - x * o.z,
@@ -113,62 +112,106 @@ namespace Lateralus::Core
         float z = 0.0f;
     };
 
-    export struct Vector4
+    // Aligned so the four components can be loaded straight into a SIMD register.
+    // See: Lateralus.Core.SIMD
+    // Constant evaluation can't use SIMD registers, so each operation has a scalar path for it.
+    export struct alignas(16) Vector4
     {
         ~Vector4() = default;
         constexpr Vector4() = default;
         constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
         constexpr Vector4(Vector4 const& o) = default;
-        Vector4& operator=(Vector4 const& o) = default;
+        constexpr Vector4& operator=(Vector4 const& o) = default;
 
-        Vector4 operator + (Vector4 const& o) const { return Vector4(x + o.x, y + o.y, z + o.z, w + o.w); }
-        Vector4 operator - (Vector4 const& o) const { return Vector4(x - o.x, y - o.y, z - o.z, w - o.w); }
-        Vector4 operator * (Vector4 const& o) const { return Vector4(x * o.x, y * o.y, z * o.z, w * o.w); }
-        Vector4 operator / (Vector4 const& o) const { return Vector4(x / o.x, y / o.y, z / o.z, w / o.w); }
+        constexpr Vector4 operator + (Vector4 const& o) const
+        {
+            if (std::is_constant_evaluated())
+            {
+                return Vector4(x + o.x, y + o.y, z + o.z, w + o.w);
+            }
+            return FromSIMD(SIMD::Add(ToSIMD(), o.ToSIMD()));
+        }
+        constexpr Vector4 operator - (Vector4 const& o) const
+        {
+            if (std::is_constant_evaluated())
+            {
+                return Vector4(x - o.x, y - o.y, z - o.z, w - o.w);
+            }
+            return FromSIMD(SIMD::Sub(ToSIMD(), o.ToSIMD()));
+        }
+        constexpr Vector4 operator * (Vector4 const& o) const
+        {
+            if (std::is_constant_evaluated())
+            {
+                return Vector4(x * o.x, y * o.y, z * o.z, w * o.w);
+            }
+            return FromSIMD(SIMD::Mul(ToSIMD(), o.ToSIMD()));
+        }
+        constexpr Vector4 operator / (Vector4 const& o) const
+        {
+            if (std::is_constant_evaluated())
+            {
+                return Vector4(x / o.x, y / o.y, z / o.z, w / o.w);
+            }
+            return FromSIMD(SIMD::Div(ToSIMD(), o.ToSIMD()));
+        }
 
-        Vector4& operator += (Vector4 const& o) { x += o.x; y += o.y; z += o.z; w += o.w; return *this; }
-        Vector4& operator -= (Vector4 const& o) { x -= o.x; y -= o.y; z -= o.z; w -= o.w; return *this; }
-        Vector4& operator *= (Vector4 const& o) { x *= o.x; y *= o.y; z *= o.z; w *= o.w; return *this; }
-        Vector4& operator /= (Vector4 const& o) { x /= o.x; y /= o.y; z /= o.z; w /= o.w; return *this; }
+        constexpr Vector4& operator += (Vector4 const& o) { return *this = *this + o; }
+        constexpr Vector4& operator -= (Vector4 const& o) { return *this = *this - o; }
+        constexpr Vector4& operator *= (Vector4 const& o) { return *this = *this * o; }
+        constexpr Vector4& operator /= (Vector4 const& o) { return *this = *this / o; }
 
-        bool ExactlyEquals(Vector4 const &o) const
+        constexpr bool ExactlyEquals(Vector4 const &o) const
         {
             return (x == o.x) && (y == o.y) && (z == o.z) && (w == o.w);
         }
-        bool RoughlyEquals(Vector4 const &o) const
+        constexpr bool RoughlyEquals(Vector4 const &o) const
         {
             return CloseEnough(x, o.x) && CloseEnough(y, o.y) && CloseEnough(z, o.z) &&
                    CloseEnough(w, o.w);
         }
 
-        float LengthSq() const { return (x * x) + (y * y) + (z * z) + (w * w); }
-        float Length() const { return sqrt((x * x) + (y * y) + (z * z) + (w * w)); }
-        void Normalize() {
+        constexpr float LengthSq() const { return Dot(*this); }
+        constexpr float Length() const { return Sqrt(Dot(*this)); }
+        constexpr void Normalize() { *this = Normalized(); }
+        constexpr Vector4 Normalized() const {
             float l = Length();
             if(l != 0.0f)
             {
-                x /= l;
-                y /= l;
-                z /= l;
-                w /= l;
+                return *this / Vector4(l, l, l, l);
             }
+            return Vector4();
         }
-        Vector4 Normalized() const {
-            float l = Length();
-            if(l != 0.0f)
+        constexpr float Sum() const
+        {
+            if (std::is_constant_evaluated())
             {
-                return Vector4(x/l, y/l, z/l, w/l);
+                return (x + z) + (y + w);
             }
-            return Vector4();
+            return SIMD::HorizontalSum(ToSIMD());
+        }
+        constexpr float Dot(Vector4 const &o) const
+        {
+            if (std::is_constant_evaluated())
+            {
+                return (*this * o).Sum();
+            }
+            return SIMD::Dot(ToSIMD(), o.ToSIMD());
+        }
+
+        SIMD::Float4 ToSIMD() const { return SIMD::Load(&x); }
+        static Vector4 FromSIMD(SIMD::Float4 v)
+        {
+            Vector4 result;
+            SIMD::Store(&result.x, v);
+            return result;
         }
-        float Sum() const { return x + y + z + w; }
-        float Dot(Vector4 const &o) const { return ((*this) * o).Sum(); }
 
         float x = 0.0f;
         float y = 0.0f;
         float z = 0.0f;
         float w = 0.0f;
     };
-
+    static_assert(sizeof(Vector4) == 4 * sizeof(float), "Vector4 must map onto one SIMD register");
 
 }
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Core.BVH;
+import Lateralus.Core.Frustum;
+import Lateralus.Core.Math;
+import Lateralus.Core.Matrix;
+import Lateralus.Core.Vector;
+
+import <algorithm>;
+import <optional>;
+import <vector>;
+
+namespace Lateralus::Core::Tests
+{
+namespace
+{
+// Deterministic values in [low, high).
+struct TestRandom
+{
+    uint32 state = 12345;
+    float Next(float low, float high)
+    {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * static_cast<float>(state >> 8) / 16777216.0f;
+    }
+};
+
+std::vector<AABB> RandomBoxes(usz count, TestRandom &random)
+{
+    std::vector<AABB> boxes;
+    for (usz i = 0; i < count; ++i)
+    {
+        boxes.push_back(AABB{Vector3(random.Next(-100.0f, 100.0f), random.Next(-20.0f, 20.0f),
+                                     random.Next(-100.0f, 100.0f)),
+                             Vector3(random.Next(0.1f, 3.0f), random.Next(0.1f, 3.0f),
+                                     random.Next(0.1f, 3.0f))});
+    }
+    return boxes;
+}
+
+std::optional<float> RayBox(Ray const &ray, AABB const &box)
+{
+    float entry = 0.0f;
+    float exit = ray.MaxDistance;
+    float const origin[3] = {ray.Origin.x, ray.Origin.y, ray.Origin.z};
+    float const direction[3] = {ray.Direction.x, ray.Direction.y, ray.Direction.z};
+    float const min[3] = {box.Min().x, box.Min().y, box.Min().z};
+    float const max[3] = {box.Max().x, box.Max().y, box.Max().z};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        float const t0 = (min[axis] - origin[axis]) / direction[axis];
+        float const t1 = (max[axis] - origin[axis]) / direction[axis];
+        entry = Max(entry, Min(t0, t1));
+        exit = Min(exit, Max(t0, t1));
+    }
+    return entry <= exit ? std::optional<float>(entry) : std::nullopt;
+}
+
+bool SphereBox(BoundingSphere const &sphere, AABB const &box)
+{
+    Vector3 const d = sphere.Center - box.Center;
+    Vector3 const outside(Max(Abs(d.x) - box.Extents.x, 0.0f), Max(Abs(d.y) - box.Extents.y, 0.0f),
+                          Max(Abs(d.z) - box.Extents.z, 0.0f));
+    return outside.LengthSq() <= sphere.Radius * sphere.Radius;
+}
+
+Ray RandomRay(TestRandom &random)
+{
+    Vector3 const origin(random.Next(-120.0f, 120.0f), random.Next(-30.0f, 30.0f),
+                         random.Next(-120.0f, 120.0f));
+    Vector3 const target(random.Next(-100.0f, 100.0f), random.Next(-20.0f, 20.0f),
+                         random.Next(-100.0f, 100.0f));
+    return Ray{origin, (target - origin).Normalized()};
+}
+
+std::vector<uint32> Sorted(std::vector<uint32> values)
+{
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+// Every query against bvh agrees with testing each box directly.
+void ExpectMatchesBruteForce(BVH const &bvh, std::vector<AABB> const &boxes, TestRandom &random)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        Ray const ray = RandomRay(random);
+        std::optional<RayHit> expected;
+        for (usz n = 0; n < boxes.size(); ++n)
+        {
+            std::optional<float> const t = RayBox(ray, boxes[n]);
+            if (t && (!expected || *t < expected->Distance))
+            {
+                expected = RayHit{static_cast<uint32>(n), *t};
+            }
+        }
+        std::optional<RayHit> const hit = bvh.Raycast(ray);
+        ASSERT_EQ(hit.has_value(), expected.has_value());
+        if (hit)
+        {
+            EXPECT_NEAR(hit->Distance, expected->Distance, 1e-3f);
+        }
+    }
+
+    for (int i = 0; i < 50; ++i)
+    {
+        BoundingSphere const sphere{Vector3(random.Next(-100.0f, 100.0f),
+                                            random.Next(-20.0f, 20.0f),
+                                            random.Next(-100.0f, 100.0f)),
+                                    random.Next(1.0f, 15.0f)};
+        std::vector<uint32> expected, found;
+        for (usz n = 0; n < boxes.size(); ++n)
+        {
+            if (SphereBox(sphere, boxes[n]))
+            {
+                expected.push_back(static_cast<uint32>(n));
+            }
+        }
+        bvh.OverlapSphere(sphere, [&](uint32 primitive) { found.push_back(primitive); });
+        EXPECT_EQ(Sorted(found), expected);
+    }
+
+    Matrix4x4 const camera = Matrix4x4::CreateTranslation(Vector3(0.0f, 5.0f, 80.0f)) *
+                             Matrix4x4::CreateRotation(Vector3(0.0f, 20.0f, 0.0f));
+    Frustum const frustum = Frustum::FromViewProjection(
+        Matrix4x4::CreatePerspectiveProjection(60.0f, 16.0f / 9.0f, 0.5f, 120.0f) *
+        camera.Inverse());
+    std::vector<uint32> expected, found;
+    for (usz n = 0; n < boxes.size(); ++n)
+    {
+        if (frustum.Intersects(boxes[n]))
+        {
+            expected.push_back(static_cast<uint32>(n));
+        }
+    }
+    bvh.QueryFrustum(frustum, [&](uint32 primitive) { found.push_back(primitive); });
+    EXPECT_GT(expected.size(), boxes.size() / 10);
+    EXPECT_EQ(Sorted(found), expected);
+}
+
+constexpr usz k_BoxCount = 2000;
+} // namespace
+
+TEST(Core_BVH, StructureCoversEveryPrimitive)
+{
+    static_assert(sizeof(BVHNode) == 32);
+
+    TestRandom random;
+    std::vector<AABB> const boxes = RandomBoxes(k_BoxCount, random);
+    BVH bvh;
+    bvh.Build(boxes);
+
+    std::vector<BVHNode> const nodes(bvh.GetNodes().begin(), bvh.GetNodes().end());
+    std::vector<uint32> const indices(bvh.GetPrimitiveIndices().begin(),
+                                      bvh.GetPrimitiveIndices().end());
+    ASSERT_FALSE(nodes.empty());
+    std::vector<int> seen(boxes.size());
+    for (usz i = 0; i < nodes.size(); ++i)
+    {
+        BVHNode const &node = nodes[i];
+        auto contains = [&](Vector3 const &min, Vector3 const &max) {
+            return node.Min.x <= min.x && node.Min.y <= min.y && node.Min.z <= min.z &&
+                   node.Max.x >= max.x && node.Max.y >= max.y && node.Max.z >= max.z;
+        };
+        if (node.IsLeaf())
+        {
+            EXPECT_LE(node.Count, 4u);
+            for (usz slot = node.Offset; slot < node.Offset + node.Count; ++slot)
+            {
+                ++seen[indices[slot]];
+                EXPECT_TRUE(contains(boxes[indices[slot]].Min(), boxes[indices[slot]].Max()));
+            }
+        }
+        else
+        {
+            ASSERT_GT(node.Offset, i + 1);
+            ASSERT_LT(node.Offset, nodes.size());
+            EXPECT_TRUE(contains(nodes[i + 1].Min, nodes[i + 1].Max));
+            EXPECT_TRUE(contains(nodes[node.Offset].Min, nodes[node.Offset].Max));
+        }
+    }
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }));
+}
+
+TEST(Core_BVH, QueriesMatchBruteForce)
+{
+    TestRandom random;
+    std::vector<AABB> const boxes = RandomBoxes(k_BoxCount, random);
+    BVH bvh;
+    bvh.Build(boxes);
+    ExpectMatchesBruteForce(bvh, boxes, random);
+}
+
+TEST(Core_BVH, RaycastUsesHitTest)
+{
+    TestRandom random;
+    std::vector<AABB> const boxes = RandomBoxes(k_BoxCount, random);
+    BVH bvh;
+    bvh.Build(boxes);
+
+    // Only odd primitives count, hit a little way into their box.
+    for (int i = 0; i < 50; ++i)
+    {
+        Ray const ray = RandomRay(random);
+        auto hitTest = [&](uint32 primitive, float) -> std::optional<float> {
+            std::optional<float> const entry = RayBox(ray, boxes[primitive]);
+            if (primitive % 2 == 0 || !entry)
+            {
+                return std::nullopt;
+            }
+            return *entry + 0.5f;
+        };
+        std::optional<RayHit> expected;
+        for (uint32 n = 0; n < boxes.size(); ++n)
+        {
+            std::optional<float> const t = hitTest(n, ray.MaxDistance);
+            if (t && (!expected || *t < expected->Distance))
+            {
+                expected = RayHit{n, *t};
+            }
+        }
+        std::optional<RayHit> const hit = bvh.Raycast(ray, hitTest);
+        ASSERT_EQ(hit.has_value(), expected.has_value());
+        if (hit)
+        {
+            EXPECT_EQ(hit->Primitive, expected->Primitive);
+            EXPECT_FLOAT_EQ(hit->Distance, expected->Distance);
+        }
+    }
+}
+
+TEST(Core_BVH, RaycastAlongFaces)
+{
+    std::vector<AABB> const boxes = {AABB{Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)},
+                                     AABB{Vector3(10.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)}};
+    BVH bvh;
+    bvh.Build(boxes);
+
+    // Parallel to the planes the rays start on, where the slab test would compute 0 * inf.
+    std::optional<RayHit> hit =
+        bvh.Raycast(Ray{Vector3(-5.0f, 1.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f)});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->Primitive, 0u);
+    EXPECT_FLOAT_EQ(hit->Distance, 4.0f);
+
+    hit = bvh.Raycast(Ray{Vector3(11.0f, -5.0f, -1.0f), Vector3(0.0f, 1.0f, 0.0f)});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->Primitive, 1u);
+    EXPECT_FLOAT_EQ(hit->Distance, 4.0f);
+
+    hit = bvh.Raycast(Ray{Vector3(15.0f, -1.0f, 0.0f), Vector3(-1.0f, 0.0f, 0.0f)});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->Primitive, 1u);
+    EXPECT_FLOAT_EQ(hit->Distance, 4.0f);
+
+    EXPECT_FALSE(
+        bvh.Raycast(Ray{Vector3(-5.0f, 1.5f, 0.0f), Vector3(1.0f, 0.0f, 0.0f)}).has_value());
+}
+
+TEST(Core_BVH, RefitFollowsMovingBoxes)
+{
+    TestRandom random;
+    std::vector<AABB> boxes = RandomBoxes(k_BoxCount, random);
+    BVH full, incremental;
+    full.Build(boxes);
+    incremental.Build(boxes);
+
+    // Move a tenth of the boxes a long way.
+    std::vector<uint32> moved;
+    for (uint32 n = 0; n < boxes.size(); n += 10)
+    {
+        boxes[n].Center += Vector3(random.Next(-50.0f, 50.0f), random.Next(-10.0f, 10.0f),
+                                   random.Next(-50.0f, 50.0f));
+        moved.push_back(n);
+    }
+    full.Refit(boxes);
+    incremental.Refit(boxes, moved);
+
+    ASSERT_EQ(full.GetNodes().size(), incremental.GetNodes().size());
+    for (usz i = 0; i < full.GetNodes().size(); ++i)
+    {
+        EXPECT_TRUE(full.GetNodes()[i].Min.ExactlyEquals(incremental.GetNodes()[i].Min));
+        EXPECT_TRUE(full.GetNodes()[i].Max.ExactlyEquals(incremental.GetNodes()[i].Max));
+    }
+    ExpectMatchesBruteForce(incremental, boxes, random);
+}
+
+TEST(Core_BVH, ParallelBuildMatchesSerial)
+{
+    TestRandom random;
+    std::vector<AABB> const boxes = RandomBoxes(20000, random);
+    BVH serial, parallel;
+    serial.Build(boxes);
+    parallel.Build(boxes, BVHBuildSettings{.ThreadCount = 4});
+
+    ASSERT_EQ(serial.GetNodes().size(), parallel.GetNodes().size());
+    for (usz i = 0; i < serial.GetNodes().size(); ++i)
+    {
+        BVHNode const &a = serial.GetNodes()[i];
+        BVHNode const &b = parallel.GetNodes()[i];
+        EXPECT_TRUE(a.Min.ExactlyEquals(b.Min) && a.Max.ExactlyEquals(b.Max));
+        EXPECT_EQ(a.Offset, b.Offset);
+        EXPECT_EQ(a.Count, b.Count);
+    }
+    EXPECT_TRUE(std::equal(serial.GetPrimitiveIndices().begin(),
+                           serial.GetPrimitiveIndices().end(),
+                           parallel.GetPrimitiveIndices().begin()));
+}
+
+TEST(Core_BVH, CoincidentBoxes)
+{
+    std::vector<AABB> const boxes(100, AABB{Vector3(1.0f, 2.0f, 3.0f), Vector3(1.0f, 1.0f, 1.0f)});
+    BVH bvh;
+    bvh.Build(boxes);
+
+    std::vector<uint32> found;
+    bvh.OverlapSphere(BoundingSphere{Vector3(1.0f, 2.0f, 3.0f), 0.5f},
+                      [&](uint32 primitive) { found.push_back(primitive); });
+    EXPECT_EQ(found.size(), boxes.size());
+
+    BVH empty;
+    empty.Build({});
+    EXPECT_FALSE(empty.Raycast(Ray{Vector3(), Vector3(1.0f, 0.0f, 0.0f)}).has_value());
+}
+} // namespace Lateralus::Core::Tests
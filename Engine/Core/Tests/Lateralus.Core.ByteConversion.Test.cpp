@@ -48,4 +48,12 @@ TEST(Core_ByteConversion, ByteLimitIs64Bit)
 {
     EXPECT_GT(6_TiB, 5_TiB);
 }
+
+TEST(Core_ByteConversion, BytesToString)
+{
+    EXPECT_EQ(Bytes_to_String(0), "0 B");
+    EXPECT_EQ(Bytes_to_String(12), "12 B");
+    EXPECT_EQ(Bytes_to_String(1_MiB), "1 MiB");
+    EXPECT_EQ(Bytes_to_String(1_KiB + 512), "1.50 KiB");
+}
 } // namespace Lateralus::Core::Tests
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Delegate;
+
+import <memory>;
+import <string>;
+import <utility>;
+import <vector>;
+
+using namespace std;
+
+namespace Lateralus::Core::Tests
+{
+namespace
+{
+int Twice(int value) { return 2 * value; }
+
+struct Counter
+{
+    int Add(int value) { return m_Total += value; }
+    int Get(int) const { return m_Total; }
+
+    int m_Total = 0;
+};
+} // namespace
+
+TEST(Core_Delegate, EmptyAndFunctionPointer)
+{
+    Delegate<int(int)> empty;
+    EXPECT_FALSE(empty);
+    Delegate<int(int)> fromNull = static_cast<int (*)(int)>(nullptr);
+    EXPECT_FALSE(fromNull);
+
+    Delegate<int(int)> twice = &Twice;
+    EXPECT_TRUE(twice);
+    EXPECT_TRUE(twice.IsInline());
+    EXPECT_EQ(twice(21), 42);
+
+    twice.Reset();
+    EXPECT_FALSE(twice);
+}
+
+TEST(Core_Delegate, SmallLambdasAreInline)
+{
+    int calls = 0;
+    int *callsPtr = &calls;
+    Delegate<void()> byReference = [&calls]() { calls++; };
+    Delegate<void()> byValue = [callsPtr, a = 1.0, b = 2.0]() { *callsPtr += 10; };
+    EXPECT_TRUE(byReference.IsInline());
+    EXPECT_TRUE(byValue.IsInline());
+    byReference();
+    byValue();
+    EXPECT_EQ(calls, 11);
+}
+
+TEST(Core_Delegate, LargeOrNonTrivialCallablesAreAllocated)
+{
+    auto shared = make_shared<int>(5);
+    Delegate<int()> holdsShared = [shared]() { return *shared; };
+    EXPECT_FALSE(holdsShared.IsInline());
+    EXPECT_EQ(shared.use_count(), 2);
+
+    {
+        // Copies own their own callable; moves take it over.
+        Delegate<int()> copy = holdsShared;
+        EXPECT_EQ(shared.use_count(), 3);
+        Delegate<int()> moved = move(copy);
+        EXPECT_FALSE(copy);
+        EXPECT_EQ(shared.use_count(), 3);
+        EXPECT_EQ(moved(), 5);
+    }
+    EXPECT_EQ(shared.use_count(), 2);
+
+    holdsShared = nullptr;
+    EXPECT_EQ(shared.use_count(), 1);
+
+    string const text(100, 'x');
+    Delegate<usz()> large = [text]() { return text.size(); };
+    EXPECT_EQ(large(), 100u);
+}
+
+TEST(Core_Delegate, BindsMemberFunctions)
+{
+    Counter counter;
+    auto add = Delegate<int(int)>::Bind<&Counter::Add>(&counter);
+    auto get = Delegate<int(int)>::Bind<&Counter::Get>(static_cast<Counter const *>(&counter));
+    EXPECT_TRUE(add.IsInline());
+    EXPECT_EQ(add(3), 3);
+    EXPECT_EQ(add(4), 7);
+    EXPECT_EQ(get(0), 7);
+
+    // The result can be dropped by a delegate returning void.
+    auto addIgnoringResult = Delegate<void(int)>::Bind<&Counter::Add>(&counter);
+    addIgnoringResult(1);
+    EXPECT_EQ(counter.m_Total, 8);
+}
+
+TEST(Core_Delegate, SurvivesVectorGrowth)
+{
+    auto shared = make_shared<int>(0);
+    vector<Delegate<int(int)>> delegates;
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            delegates.push_back([i](int value) { return value + i; });
+        }
+        else
+        {
+            delegates.push_back([i, shared](int value) { return value + i + *shared; });
+        }
+    }
+    EXPECT_EQ(shared.use_count(), 51);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(delegates[i](1000), 1000 + i);
+    }
+    delegates.erase(delegates.begin(), delegates.begin() + 50);
+    EXPECT_EQ(shared.use_count(), 26);
+    EXPECT_EQ(delegates.front()(0), 50);
+}
+} // namespace Lateralus::Core::Tests
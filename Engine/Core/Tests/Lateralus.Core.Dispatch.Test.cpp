@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Dispatch;
+import Lateralus.Core.Matrix;
+import Lateralus.Core.SIMDSupport;
+import Lateralus.Core.StringUtils;
+import Lateralus.Core.Vector;
+
+import <string>;
+import <vector>;
+
+using namespace std;
+
+namespace Lateralus::Core::Tests
+{
+namespace
+{
+int ReturnNone() { return 0; }
+int ReturnSSE41() { return 1; }
+int ReturnAVX2() { return 2; }
+
+constexpr SSEVersion k_DispatchVersions[] = {SSEVersion::None, SSEVersion::SSE4_1,
+                                             SSEVersion::AVX2, SSEVersion::AVX512};
+
+// Restores the detected ceiling when a test finishes.
+struct ScopedDispatchCeiling
+{
+    explicit ScopedDispatchCeiling(SSEVersion version) { Set(version); }
+    ~ScopedDispatchCeiling() { Set(SSEVersion::AVX512); }
+    void Set(SSEVersion version) { DispatchedFunctionBase::SetCeiling(version); }
+};
+} // namespace
+
+TEST(Core_Dispatch, BindsBestVariantUnderCeiling)
+{
+    DispatchedFunction<int()> function{{SSEVersion::AVX2, &ReturnAVX2},
+                                       {SSEVersion::None, &ReturnNone},
+                                       {SSEVersion::SSE4_1, &ReturnSSE41}};
+
+    SSEVersion const detected = GetDispatchVersion();
+    EXPECT_LE(function.GetBoundVersion(), detected);
+    if (detected >= SSEVersion::AVX2)
+    {
+        EXPECT_EQ(function(), 2);
+    }
+
+    ScopedDispatchCeiling ceiling(SSEVersion::None);
+    EXPECT_EQ(GetDispatchVersion(), SSEVersion::None);
+    EXPECT_EQ(function.GetBoundVersion(), SSEVersion::None);
+    EXPECT_EQ(function(), 0);
+
+    if (detected >= SSEVersion::SSE4_1)
+    {
+        ceiling.Set(SSEVersion::AVX);
+        EXPECT_EQ(function.GetBoundVersion(), SSEVersion::SSE4_1);
+        EXPECT_EQ(function(), 1);
+    }
+}
+
+TEST(Core_Dispatch, CeilingNeverExceedsCPU)
+{
+    SSEVersion const detected = GetDispatchVersion();
+    ScopedDispatchCeiling ceiling(SSEVersion::AVX512);
+    EXPECT_EQ(GetDispatchVersion(), detected);
+}
+
+// Every variant of the engine's dispatched kernels has to agree with the baseline. Running at each
+// ceiling reaches every variant this CPU supports.
+TEST(Core_Dispatch, KernelsMatchAtEveryVersion)
+{
+    string text;
+    for (int i = 0; i < 50; ++i)
+    {
+        text += "word" + to_string(i) + ((i % 3 == 0) ? ",, " : " ");
+    }
+    vector<string_view> expectedSplit;
+    vector<float> x, y, z;
+    for (int i = 0; i < 37; ++i)
+    {
+        x.push_back(static_cast<float>(i));
+        y.push_back(static_cast<float>(i) * -0.5f);
+        z.push_back(static_cast<float>(i * i) * 0.25f);
+    }
+    Matrix4x4 const m = Matrix4x4::CreateTranslation(Vector3(1.0f, 2.0f, 3.0f)) *
+                        Matrix4x4::CreateRotation(Vector3(10.0f, 20.0f, 30.0f));
+
+    for (SSEVersion version : k_DispatchVersions)
+    {
+        ScopedDispatchCeiling ceiling(version);
+
+        vector<string_view> const split = StringUtils::SplitStringView<string_view>(text, ", ");
+        if (expectedSplit.empty())
+        {
+            expectedSplit = split;
+            ASSERT_EQ(expectedSplit.size(), 50u);
+            EXPECT_EQ(expectedSplit.back(), "word49");
+        }
+        EXPECT_EQ(split, expectedSplit) << SSEGetName(version);
+
+        vector<float> outX(x.size()), outY(y.size()), outZ(z.size());
+        TransformPoints(m, ConstVector3Streams{x, y, z}, Vector3Streams{outX, outY, outZ});
+        for (usz i = 0; i < x.size(); ++i)
+        {
+            Vector4 const expected = m * Vector4(x[i], y[i], z[i], 1.0f);
+            EXPECT_NEAR(outX[i], expected.x, 1e-4f) << SSEGetName(version);
+            EXPECT_NEAR(outY[i], expected.y, 1e-4f) << SSEGetName(version);
+            EXPECT_NEAR(outZ[i], expected.z, 1e-4f) << SSEGetName(version);
+        }
+    }
+}
+} // namespace Lateralus::Core::Tests
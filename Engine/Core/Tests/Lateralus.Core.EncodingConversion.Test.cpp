@@ -90,6 +90,24 @@ TEST(Core_EncodingConversionTest, Utf8ToUtf16)
 
     EXPECT_EQ(string_cast<std::u16string>(u8"(\u982d)").compare(u"(\u982d)"),
               0); // \u982d == 頭
+
+    // ASCII runs long enough to be converted a register at a time, broken up by multibyte
+    // characters at varying offsets.
+    {
+        std::u8string utf8;
+        std::u16string expected;
+        for (int i = 0; i < 40; ++i)
+        {
+            for (int j = 0; j < i * 3; ++j)
+            {
+                utf8 += static_cast<char8_t>(u8'a' + j % 26);
+                expected += static_cast<char16_t>(u'a' + j % 26);
+            }
+            utf8 += u8"\u982d";
+            expected += u"\u982d";
+        }
+        EXPECT_EQ(string_cast<std::u16string>(utf8), expected);
+    }
 }
 
 TEST(Core_EncodingConversionTest, Utf8ToUtf32)
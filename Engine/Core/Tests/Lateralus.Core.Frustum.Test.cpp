@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Frustum;
+import Lateralus.Core.Matrix;
+import Lateralus.Core.Vector;
+
+import <bit>;
+import <vector>;
+
+namespace Lateralus::Core::Tests
+{
+namespace
+{
+// A camera at (0, 2, 10) turned 30 degrees about y, looking down its -z.
+Matrix4x4 TestViewProjection()
+{
+    Matrix4x4 const camera = Matrix4x4::CreateTranslation(Vector3(0.0f, 2.0f, 10.0f)) *
+                             Matrix4x4::CreateRotation(Vector3(0.0f, 30.0f, 0.0f));
+    return Matrix4x4::CreatePerspectiveProjection(60.0f, 16.0f / 9.0f, 0.5f, 50.0f) *
+           camera.Inverse();
+}
+
+// Deterministic values in [low, high).
+struct TestRandom
+{
+    uint32 state = 12345;
+    float Next(float low, float high)
+    {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * static_cast<float>(state >> 8) / 16777216.0f;
+    }
+};
+
+// Spans one partial group at the end.
+constexpr usz k_BoundCount = 1003;
+} // namespace
+
+TEST(Core_Frustum, PlanesFromPerspective)
+{
+    Frustum const frustum = Frustum::FromViewProjection(
+        Matrix4x4::CreatePerspectiveProjection(90.0f, 1.0f, 1.0f, 100.0f));
+
+    for (Plane const &plane : frustum.Planes)
+    {
+        EXPECT_NEAR(plane.Normal.Length(), 1.0f, 1e-5f);
+    }
+    EXPECT_NEAR(frustum.Planes[Frustum::Near].SignedDistance(Vector3(0.0f, 0.0f, -1.0f)), 0.0f,
+                1e-4f);
+    EXPECT_NEAR(frustum.Planes[Frustum::Far].SignedDistance(Vector3(0.0f, 0.0f, -100.0f)), 0.0f,
+                1e-3f);
+    // A 90 degree field of view puts the side planes at 45 degrees.
+    EXPECT_NEAR(frustum.Planes[Frustum::Left].SignedDistance(Vector3(-5.0f, 0.0f, -5.0f)), 0.0f,
+                1e-4f);
+    EXPECT_NEAR(frustum.Planes[Frustum::Top].SignedDistance(Vector3(0.0f, 5.0f, -5.0f)), 0.0f,
+                1e-4f);
+
+    EXPECT_TRUE(frustum.Intersects(BoundingSphere{Vector3(0.0f, 0.0f, -10.0f), 0.1f}));
+    EXPECT_FALSE(frustum.Intersects(BoundingSphere{Vector3(0.0f, 0.0f, 10.0f), 1.0f}));
+    EXPECT_FALSE(frustum.Intersects(BoundingSphere{Vector3(0.0f, 0.0f, -0.5f), 0.25f}));
+    EXPECT_TRUE(frustum.Intersects(BoundingSphere{Vector3(0.0f, 0.0f, -0.5f), 0.75f}));
+    EXPECT_FALSE(frustum.Intersects(BoundingSphere{Vector3(0.0f, 0.0f, -102.0f), 1.0f}));
+    EXPECT_FALSE(frustum.Intersects(BoundingSphere{Vector3(20.0f, 0.0f, -10.0f), 5.0f}));
+
+    EXPECT_TRUE(frustum.Intersects(AABB{Vector3(0.0f, 0.0f, -10.0f), Vector3(1.0f, 1.0f, 1.0f)}));
+    EXPECT_FALSE(frustum.Intersects(AABB{Vector3(25.0f, 0.0f, -10.0f), Vector3(5.0f, 5.0f, 5.0f)}));
+    // Reaches across the right plane.
+    EXPECT_TRUE(frustum.Intersects(AABB{Vector3(20.0f, 0.0f, -10.0f), Vector3(11.0f, 1.0f, 1.0f)}));
+    EXPECT_TRUE(frustum.Intersects(
+        AABB::FromMinMax(Vector3(-1.0f, -1.0f, -200.0f), Vector3(1.0f, 1.0f, -50.0f))));
+
+    EXPECT_EQ(frustum.Classify(AABB{Vector3(0.0f, 0.0f, -10.0f), Vector3(1.0f, 1.0f, 1.0f)}),
+              Frustum::Containment::Inside);
+    EXPECT_EQ(frustum.Classify(AABB{Vector3(20.0f, 0.0f, -10.0f), Vector3(11.0f, 1.0f, 1.0f)}),
+              Frustum::Containment::Intersecting);
+    EXPECT_EQ(frustum.Classify(AABB{Vector3(25.0f, 0.0f, -10.0f), Vector3(5.0f, 5.0f, 5.0f)}),
+              Frustum::Containment::Outside);
+}
+
+TEST(Core_Frustum, CullSpheresMatchesScalar)
+{
+    Frustum const frustum = Frustum::FromViewProjection(TestViewProjection());
+
+    TestRandom random;
+    std::vector<float> x, y, z, radius;
+    std::vector<uint32> expected;
+    for (usz n = 0; n < k_BoundCount; ++n)
+    {
+        BoundingSphere const sphere{
+            Vector3(random.Next(-60.0f, 60.0f), random.Next(-20.0f, 20.0f),
+                    random.Next(-60.0f, 30.0f)),
+            random.Next(0.0f, 4.0f)};
+        x.push_back(sphere.Center.x);
+        y.push_back(sphere.Center.y);
+        z.push_back(sphere.Center.z);
+        radius.push_back(sphere.Radius);
+        if (frustum.Intersects(sphere))
+        {
+            expected.push_back(static_cast<uint32>(n));
+        }
+    }
+    // Some of each, so both outcomes are exercised.
+    EXPECT_GT(expected.size(), k_BoundCount / 10);
+    EXPECT_LT(expected.size(), k_BoundCount / 2);
+
+    ConstSphereStreams const spheres{{x, y, z}, radius};
+    std::vector<uint32> indices(k_BoundCount);
+    indices.resize(frustum.CullSpheres(spheres, indices));
+    EXPECT_EQ(indices, expected);
+
+    std::vector<uint64> mask((k_BoundCount + 63) / 64, ~0ull);
+    frustum.CullSpheres(spheres, mask);
+    std::vector<uint32> fromMask;
+    for (usz n = 0; n < mask.size() * 64; ++n)
+    {
+        if ((mask[n / 64] >> (n % 64)) & 1)
+        {
+            fromMask.push_back(static_cast<uint32>(n));
+        }
+    }
+    EXPECT_EQ(fromMask, expected);
+}
+
+TEST(Core_Frustum, CullAABBsMatchesScalar)
+{
+    Frustum const frustum = Frustum::FromViewProjection(TestViewProjection());
+
+    TestRandom random;
+    std::vector<float> x, y, z, ex, ey, ez;
+    std::vector<uint32> expected;
+    for (usz n = 0; n < k_BoundCount; ++n)
+    {
+        AABB const box{Vector3(random.Next(-60.0f, 60.0f), random.Next(-20.0f, 20.0f),
+                               random.Next(-60.0f, 30.0f)),
+                       Vector3(random.Next(0.0f, 4.0f), random.Next(0.0f, 1.0f),
+                               random.Next(0.0f, 2.0f))};
+        x.push_back(box.Center.x);
+        y.push_back(box.Center.y);
+        z.push_back(box.Center.z);
+        ex.push_back(box.Extents.x);
+        ey.push_back(box.Extents.y);
+        ez.push_back(box.Extents.z);
+        if (frustum.Intersects(box))
+        {
+            expected.push_back(static_cast<uint32>(n));
+        }
+    }
+    EXPECT_GT(expected.size(), k_BoundCount / 10);
+    EXPECT_LT(expected.size(), k_BoundCount / 2);
+
+    ConstAABBStreams const boxes{{x, y, z}, {ex, ey, ez}};
+    std::vector<uint32> indices(k_BoundCount);
+    indices.resize(frustum.CullAABBs(boxes, indices));
+    EXPECT_EQ(indices, expected);
+
+    std::vector<uint64> mask((k_BoundCount + 63) / 64);
+    frustum.CullAABBs(boxes, mask);
+    usz visibleCount = 0;
+    for (uint64 word : mask)
+    {
+        visibleCount += static_cast<usz>(std::popcount(word));
+    }
+    EXPECT_EQ(visibleCount, expected.size());
+    for (uint32 index : expected)
+    {
+        EXPECT_TRUE((mask[index / 64] >> (index % 64)) & 1);
+    }
+}
+} // namespace Lateralus::Core::Tests
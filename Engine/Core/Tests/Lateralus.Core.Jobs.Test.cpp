@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Jobs;
+import Lateralus.Core.Transform;
+import Lateralus.Core.Vector;
+
+import <atomic>;
+import <chrono>;
+import <thread>;
+import <vector>;
+
+using namespace std;
+
+namespace Lateralus::Core::Tests
+{
+namespace
+{
+// Waits without running jobs on this thread, leaving them all to the workers.
+void WaitWithoutHelping(JobCounter const &counter)
+{
+    while (!counter.IsDone())
+    {
+        this_thread::yield();
+    }
+}
+} // namespace
+
+TEST(Core_Jobs, DetectsCores)
+{
+    CoreCounts const counts = DetectCoreCounts();
+    EXPECT_GE(counts.Logical, 1u);
+    EXPECT_GE(counts.Physical, 1u);
+    EXPECT_LE(counts.Physical, counts.Logical);
+}
+
+TEST(Core_Jobs, RunsEveryJob)
+{
+    for (usz workerCount : {0, 1, 3})
+    {
+        JobSystem jobs({.WorkerCount = workerCount});
+        EXPECT_EQ(jobs.GetThreadCount(), workerCount + 1);
+        atomic<int> sum = 0;
+        JobCounter counter;
+        for (int i = 1; i <= 1000; ++i)
+        {
+            jobs.Run([&sum, i] { sum += i; }, &counter);
+        }
+        jobs.Wait(counter);
+        EXPECT_EQ(sum, 1000 * 1001 / 2);
+    }
+}
+
+TEST(Core_Jobs, JobsSpawnJobs)
+{
+    JobSystem jobs({.WorkerCount = 3, .QueueCapacity = 64});
+    atomic<int> leaves = 0;
+    JobCounter counter;
+    // A tree 4 wide and 5 deep, which also overflows the small queues.
+    auto spawn = [&](auto &self, int depth) -> void {
+        if (depth == 5)
+        {
+            leaves++;
+            return;
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            jobs.Run([&self, depth] { self(self, depth + 1); }, &counter);
+        }
+    };
+    jobs.Run([&] { spawn(spawn, 0); }, &counter);
+    jobs.Wait(counter);
+    EXPECT_EQ(leaves, 4 * 4 * 4 * 4 * 4);
+}
+
+TEST(Core_Jobs, DependentJobsRunAfter)
+{
+    JobSystem jobs({.WorkerCount = 3});
+    for (int round = 0; round < 100; ++round)
+    {
+        atomic<int> produced = 0;
+        atomic<int> seenByConsumers = 0;
+        JobCounter producers, consumers;
+        for (int i = 0; i < 8; ++i)
+        {
+            jobs.Run([&produced] { produced++; }, &producers);
+        }
+        for (int i = 0; i < 8; ++i)
+        {
+            jobs.Run([&] { seenByConsumers += produced; }, &consumers, producers);
+        }
+        jobs.Wait(consumers);
+        EXPECT_TRUE(producers.IsDone());
+        EXPECT_EQ(seenByConsumers, 8 * 8);
+    }
+
+    // Depending on a counter that's already done runs right away.
+    JobCounter done, counter;
+    bool ran = false;
+    jobs.Run([&ran] { ran = true; }, &counter, done);
+    jobs.Wait(counter);
+    EXPECT_TRUE(ran);
+}
+
+TEST(Core_Jobs, RunFromOtherThreads)
+{
+    JobSystem jobs({.WorkerCount = 2});
+    atomic<int> sum = 0;
+    vector<thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&] {
+            JobCounter counter;
+            for (int i = 0; i < 250; ++i)
+            {
+                jobs.Run([&sum] { sum++; }, &counter);
+            }
+            jobs.Wait(counter);
+        });
+    }
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+    EXPECT_EQ(sum, 1000);
+}
+
+TEST(Core_Jobs, ParallelForCoversRangeOnce)
+{
+    JobSystem jobs({.WorkerCount = 3});
+    for (usz count : {0, 1, 7, 16, 1000, 12345})
+    {
+        vector<atomic<int>> visits(count);
+        atomic<usz> calls = 0;
+        jobs.ParallelFor(count, [&](usz begin, usz end) {
+            EXPECT_LT(begin, end);
+            calls++;
+            for (usz i = begin; i < end; ++i)
+            {
+                visits[i]++;
+            }
+        });
+        for (usz i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(visits[i], 1);
+        }
+        EXPECT_LE(calls, 4 * jobs.GetThreadCount());
+    }
+
+    // The minimum grain bounds the number of ranges.
+    atomic<usz> calls = 0;
+    jobs.ParallelFor(1000, [&](usz, usz) { calls++; }, 400);
+    EXPECT_EQ(calls, 3u);
+}
+
+TEST(Core_Jobs, DrivesTransformUpdate)
+{
+    JobSystem jobs({.WorkerCount = 3});
+    TransformHierarchy hierarchy;
+    vector<TransformId> ids;
+    for (usz n = 0; n < 5000; ++n)
+    {
+        TransformId const parent = n < 10 ? TransformId{} : ids[n / 2];
+        ids.push_back(hierarchy.Create(parent));
+        hierarchy.SetLocalPosition(ids.back(), Vector3(1.0f, 0.0f, 0.0f));
+    }
+    auto parallelFor = [&jobs](usz count, auto &&function) { jobs.ParallelFor(count, function); };
+    EXPECT_EQ(hierarchy.Update(parallelFor), ids.size());
+
+    // Each node sits one unit further along x than its parent.
+    for (usz n = 10; n < ids.size(); n += 37)
+    {
+        float const parentX = hierarchy.GetWorldMatrix(ids[n / 2]).r0.w;
+        EXPECT_FLOAT_EQ(hierarchy.GetWorldMatrix(ids[n]).r0.w, parentX + 1.0f);
+    }
+}
+
+TEST(Core_Jobs, FibersParkWaitingJobs)
+{
+    // Chains of jobs each waiting on the next; every wait in flight parks a fiber.
+    for (usz fiberCount : {2, 64})
+    {
+        JobSystem jobs({.WorkerCount = 3, .FiberCount = fiberCount, .FiberStackSize = 64 * 1024});
+        atomic<int> finished = 0;
+        auto chain = [&](auto &self, int depth) -> void {
+            if (depth < 40)
+            {
+                JobCounter next;
+                jobs.Run([&self, depth] { self(self, depth + 1); }, &next);
+                jobs.Wait(next);
+            }
+            finished++;
+        };
+        JobCounter counter;
+        for (int i = 0; i < 4; ++i)
+        {
+            jobs.Run([&] { chain(chain, 0); }, &counter);
+        }
+        WaitWithoutHelping(counter);
+        EXPECT_EQ(finished, 4 * 41);
+    }
+}
+
+TEST(Core_Jobs, FibersWaitOnSharedCounter)
+{
+    JobSystem jobs({.WorkerCount = 3, .FiberCount = 32});
+    JobCounter gate, waiters;
+    atomic<int> passed = 0;
+    atomic<bool> open = false;
+    jobs.Run(
+        [&open] {
+            this_thread::sleep_for(chrono::milliseconds(10));
+            open = true;
+        },
+        &gate);
+    // More waiters than workers, all parked on the same counter at once.
+    for (int i = 0; i < 12; ++i)
+    {
+        jobs.Run(
+            [&] {
+                jobs.Wait(gate);
+                EXPECT_TRUE(open);
+                passed++;
+            },
+            &waiters);
+    }
+    WaitWithoutHelping(waiters);
+    EXPECT_EQ(passed, 12);
+}
+} // namespace Lateralus::Core::Tests
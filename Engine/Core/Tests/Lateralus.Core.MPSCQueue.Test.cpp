@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Core.MPSCQueue;
+
+import <atomic>;
+import <thread>;
+import <vector>;
+
+using namespace std;
+
+namespace Lateralus::Core::Tests
+{
+TEST(Core_MPSCQueue, FifoAndFull)
+{
+    MPSCQueue<int> queue(4);
+    EXPECT_EQ(queue.GetCapacity(), 4u);
+    int out = 0;
+    EXPECT_FALSE(queue.TryPop(out));
+
+    for (int lap = 0; lap < 3; ++lap)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            EXPECT_TRUE(queue.TryPush(lap * 10 + i));
+        }
+        EXPECT_FALSE(queue.TryPush(99));
+        EXPECT_EQ(queue.GetSizeApprox(), 4u);
+        for (int i = 0; i < 4; ++i)
+        {
+            ASSERT_TRUE(queue.TryPop(out));
+            EXPECT_EQ(out, lap * 10 + i);
+        }
+        EXPECT_FALSE(queue.TryPop(out));
+    }
+}
+
+TEST(Core_MPSCQueue, ManyProducers)
+{
+    constexpr int producerCount = 4;
+    constexpr int perProducer = 20000;
+    MPSCQueue<int> queue(1024);
+
+    atomic_bool start = false;
+    vector<thread> producers;
+    for (int p = 0; p < producerCount; ++p)
+    {
+        producers.emplace_back([&queue, &start, p]() {
+            while (!start) {}
+            for (int i = 0; i < perProducer; ++i)
+            {
+                while (!queue.TryPush(p * perProducer + i)) {}
+            }
+        });
+    }
+    start = true;
+
+    // Every value arrives once, and each producer's values arrive in the order it pushed them.
+    vector<int> next(producerCount, 0);
+    int received = 0;
+    while (received < producerCount * perProducer)
+    {
+        int value;
+        if (queue.TryPop(value))
+        {
+            int const producer = value / perProducer;
+            EXPECT_EQ(value % perProducer, next[producer]);
+            next[producer] = value % perProducer + 1;
+            ++received;
+        }
+    }
+    for (thread &producer : producers)
+    {
+        producer.join();
+    }
+    int out;
+    EXPECT_FALSE(queue.TryPop(out));
+}
+} // namespace Lateralus::Core::Tests
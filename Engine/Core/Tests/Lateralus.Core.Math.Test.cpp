@@ -3,10 +3,62 @@
 import Lateralus.Core;
 import Lateralus.Core.Math;
 
+import <algorithm>;
+import <array>;
+import <cmath>;
+import <limits>;
+import <vector>;
+
 using namespace Lateralus;
 
 namespace Lateralus::Core::Tests
 {
+namespace
+{
+// Evenly spaced samples over [low, high], with a count that leaves a partial SIMD group.
+std::vector<float> Samples(float low, float high, usz count = 4099)
+{
+    std::vector<float> result(count);
+    for (usz n = 0; n < count; ++n)
+    {
+        result[n] = low + (high - low) * static_cast<float>(n) / static_cast<float>(count - 1);
+    }
+    return result;
+}
+
+// Largest |approx - exact| relative to max(|exact|, floor).
+template <typename Approx, typename Exact>
+double MaxError(std::vector<float> const &in, Approx approx, Exact exact, double floor = 1.0)
+{
+    double maxError = 0.0;
+    for (float x : in)
+    {
+        double const expected = exact(static_cast<double>(x));
+        double const error = std::abs(static_cast<double>(approx(x)) - expected) /
+                             std::max(std::abs(expected), floor);
+        maxError = std::max(maxError, error);
+    }
+    return maxError;
+}
+
+template <Precision P> void ExpectSinCosWithin(double tolerance)
+{
+    std::vector<float> const angles = Samples(-100.0f, 100.0f);
+    auto sin = [](float x) {
+        float s, c;
+        SinCos<P>(x, s, c);
+        return s;
+    };
+    auto cos = [](float x) {
+        float s, c;
+        SinCos<P>(x, s, c);
+        return c;
+    };
+    EXPECT_LT(MaxError(angles, sin, [](double x) { return std::sin(x); }), tolerance);
+    EXPECT_LT(MaxError(angles, cos, [](double x) { return std::cos(x); }), tolerance);
+}
+} // namespace
+
 TEST(Core_Math, FloatAlmostEqual)
 {
     EXPECT_TRUE(CloseEnough(0.00000001f, 0.00000009f));
@@ -30,4 +82,159 @@ TEST(Core_Math, MathFuncSantiyCheck)
     EXPECT_EQ(1.0f, Min(1.0f, 2.0f));
     EXPECT_EQ(1.0f, Min(1.0f, 2.0f, 3.0f));
 }
+
+// Tolerances are a little looser than the table in Lateralus.Core.Math so the tests hold on every
+// SIMD backend.
+TEST(Core_Math, ApproximateSinCos)
+{
+    ExpectSinCosWithin<Precision::Fast>(4e-4);
+    ExpectSinCosWithin<Precision::Medium>(2e-6);
+    ExpectSinCosWithin<Precision::Precise>(3e-7);
+}
+
+TEST(Core_Math, ApproximateATan2)
+{
+    std::vector<float> const angles = Samples(-3.14f, 3.14f);
+    auto exact = [](double angle) { return angle; };
+    auto fast = [](float angle) {
+        return ATan2<Precision::Fast>(Sin(angle) * 3.0f, Cos(angle) * 3.0f);
+    };
+    auto medium = [](float angle) {
+        return ATan2<Precision::Medium>(Sin(angle) * 0.5f, Cos(angle) * 0.5f);
+    };
+    auto precise = [](float angle) { return ATan2<Precision::Precise>(Sin(angle), Cos(angle)); };
+    EXPECT_LT(MaxError(angles, fast, exact), 2e-3);
+    EXPECT_LT(MaxError(angles, medium, exact), 5e-6);
+    EXPECT_LT(MaxError(angles, precise, exact), 1e-6);
+
+    EXPECT_EQ(ATan2<Precision::Precise>(0.0f, 1.0f), 0.0f);
+    EXPECT_NEAR(ATan2<Precision::Precise>(1.0f, 0.0f), HalfPi, 1e-6f);
+    EXPECT_NEAR(ATan2<Precision::Precise>(0.0f, -1.0f), Pi, 1e-6f);
+}
+
+TEST(Core_Math, ApproximateExpAndLog)
+{
+    std::vector<float> const exponents = Samples(-80.0f, 80.0f);
+    auto exactExp = [](double x) { return std::exp(x); };
+    EXPECT_LT(MaxError(exponents, [](float x) { return Exp<Precision::Fast>(x); }, exactExp, 0.0),
+              1e-4);
+    EXPECT_LT(MaxError(exponents, [](float x) { return Exp<Precision::Medium>(x); }, exactExp, 0.0),
+              4e-6);
+    EXPECT_LT(
+        MaxError(exponents, [](float x) { return Exp<Precision::Precise>(x); }, exactExp, 0.0),
+        3e-7);
+
+    std::vector<float> const values = Samples(1e-3f, 1e4f);
+    auto exactLog = [](double x) { return std::log(x); };
+    EXPECT_LT(MaxError(values, [](float x) { return Log<Precision::Fast>(x); }, exactLog), 2e-5);
+    EXPECT_LT(MaxError(values, [](float x) { return Log<Precision::Medium>(x); }, exactLog), 1e-6);
+    EXPECT_LT(MaxError(values, [](float x) { return Log<Precision::Precise>(x); }, exactLog), 1e-6);
+
+    EXPECT_NEAR(Exp<Precision::Fast>(0.0f), 1.0f, 1e-4f);
+    EXPECT_EQ(Exp<Precision::Precise>(-200.0f), 0.0f);
+    EXPECT_EQ(Exp<Precision::Precise>(200.0f), std::numeric_limits<float>::infinity());
+    EXPECT_EQ(Log<Precision::Precise>(0.0f), -std::numeric_limits<float>::infinity());
+    EXPECT_TRUE(std::isnan(Log<Precision::Precise>(-1.0f)));
+}
+
+TEST(Core_Math, ApproximateRSqrtAndPow)
+{
+    std::vector<float> const values = Samples(1e-4f, 1e6f);
+    auto exactRSqrt = [](double x) { return 1.0 / std::sqrt(x); };
+    EXPECT_LT(MaxError(values, [](float x) { return RSqrt<Precision::Fast>(x); }, exactRSqrt, 0.0),
+              4e-4);
+    EXPECT_LT(
+        MaxError(values, [](float x) { return RSqrt<Precision::Medium>(x); }, exactRSqrt, 0.0),
+        1e-6);
+    EXPECT_LT(
+        MaxError(values, [](float x) { return RSqrt<Precision::Precise>(x); }, exactRSqrt, 0.0),
+        3e-7);
+    EXPECT_EQ(RSqrt<Precision::Precise>(0.0f), std::numeric_limits<float>::infinity());
+
+    EXPECT_NEAR(Pow<Precision::Precise>(2.0f, 10.0f), 1024.0f, 1024.0f * 1e-6f);
+    EXPECT_NEAR(Pow<Precision::Precise>(9.0f, 0.5f), 3.0f, 3.0f * 1e-6f);
+    EXPECT_NEAR(Pow<Precision::Fast>(5.0f, 0.0f), 1.0f, 1e-4f);
+}
+
+// The span overloads run the same kernels, including on the partial group at the end.
+TEST(Core_Math, ApproximateSpansMatchScalar)
+{
+    std::vector<float> const in = Samples(0.01f, 20.0f, 23);
+    std::vector<float> sines(in.size()), cosines(in.size()), angles(in.size()), exps(in.size()),
+        logs(in.size()), rsqrts(in.size()), pows(in.size());
+
+    SinCos<Precision::Medium>(in, sines, cosines);
+    ATan2<Precision::Medium>(sines, cosines, angles);
+    Exp<Precision::Medium>(in, exps);
+    Log<Precision::Medium>(in, logs);
+    RSqrt<Precision::Medium>(in, rsqrts);
+    Pow<Precision::Medium>(in, in, pows);
+
+    for (usz n = 0; n < in.size(); ++n)
+    {
+        float s, c;
+        SinCos<Precision::Medium>(in[n], s, c);
+        EXPECT_EQ(sines[n], s);
+        EXPECT_EQ(cosines[n], c);
+        EXPECT_EQ(angles[n], ATan2<Precision::Medium>(s, c));
+        EXPECT_EQ(exps[n], Exp<Precision::Medium>(in[n]));
+        EXPECT_EQ(logs[n], Log<Precision::Medium>(in[n]));
+        EXPECT_EQ(rsqrts[n], RSqrt<Precision::Medium>(in[n]));
+        EXPECT_EQ(pows[n], Pow<Precision::Medium>(in[n], in[n]));
+    }
+}
+
+// The compile time fallbacks agree with the C runtime to within a couple of ulp.
+TEST(Core_Math, ConstexprMatchesRuntime)
+{
+    static_assert(Sqrt(4.0f) == 2.0f);
+    static_assert(Pow(2.0f, 10) == 1024.0f);
+    static_assert(Pow(2.0f, -2) == 0.25f);
+    static_assert(Exp(0.0f) == 1.0f);
+    static_assert(Log(1.0f) == 0.0f);
+    static_assert(Sin(0.0f) == 0.0f && Cos(0.0f) == 1.0f);
+
+    // Inputs come from a constant table too, so the runtime side can't fuse their arithmetic.
+    constexpr usz k_Count = 64;
+    static constexpr auto k_Inputs = [] {
+        std::array<float, k_Count * 2> inputs{};
+        for (usz n = 0; n < k_Count; ++n)
+        {
+            inputs[n * 2 + 0] = static_cast<float>(n) * 0.37f - 11.0f;
+            inputs[n * 2 + 1] = static_cast<float>(n) * 1.7f + 0.01f;
+        }
+        return inputs;
+    }();
+    constexpr auto k_Table = [] {
+        std::array<float, k_Count * 8> table{};
+        for (usz n = 0; n < k_Count; ++n)
+        {
+            float const x = k_Inputs[n * 2 + 0];
+            float const positive = k_Inputs[n * 2 + 1];
+            table[n * 8 + 0] = Sin(x);
+            table[n * 8 + 1] = Cos(x);
+            table[n * 8 + 2] = Tan(x * 0.1f);
+            table[n * 8 + 3] = ATan2(x, 3.0f - x);
+            table[n * 8 + 4] = ACos(x / 13.0f);
+            table[n * 8 + 5] = Exp(x);
+            table[n * 8 + 6] = Log(positive);
+            table[n * 8 + 7] = Pow(positive, 0.75f);
+        }
+        return table;
+    }();
+
+    for (usz n = 0; n < k_Count; ++n)
+    {
+        float const x = k_Inputs[n * 2 + 0];
+        float const positive = k_Inputs[n * 2 + 1];
+        float const runtime[8] = {Sin(x),          Cos(x), Tan(x * 0.1f), ATan2(x, 3.0f - x),
+                                  ACos(x / 13.0f), Exp(x), Log(positive), Pow(positive, 0.75f)};
+        for (usz f = 0; f < 8; ++f)
+        {
+            float const expected = runtime[f];
+            EXPECT_NEAR(k_Table[n * 8 + f], expected, 4e-7f * std::max(1.0f, std::abs(expected)))
+                << "function " << f << " at " << n;
+        }
+    }
+}
 } // namespace Lateralus::Core::Tests
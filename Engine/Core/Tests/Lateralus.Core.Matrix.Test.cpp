@@ -2,6 +2,7 @@
 
 import Lateralus.Core.Matrix;
 import Lateralus.Core.Math;
+import <vector>;
 
 using namespace Lateralus;
 
@@ -101,6 +102,24 @@ TEST(Matrix4x4Test, MatrixVectorMultiplicationOperator)
     ASSERT_FLOAT_EQ(result.w, expected.w);
 }
 
+TEST(Matrix4x4Test, MatrixMultiplicationIsRowByColumn)
+{
+    // Neither operand is diagonal so every lane of every row contributes to the result.
+    Lateralus::Core::Matrix4x4 matrix1(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f,
+                                       11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f);
+
+    Lateralus::Core::Matrix4x4 matrix2(17.0f, 18.0f, 19.0f, 20.0f, 21.0f, 22.0f, 23.0f, 24.0f,
+                                       25.0f, 26.0f, 27.0f, 28.0f, 29.0f, 30.0f, 31.0f, 32.0f);
+
+    Lateralus::Core::Matrix4x4 expected(250.0f, 260.0f, 270.0f, 280.0f, 618.0f, 644.0f, 670.0f,
+                                        696.0f, 986.0f, 1028.0f, 1070.0f, 1112.0f, 1354.0f,
+                                        1412.0f, 1470.0f, 1528.0f);
+
+    Lateralus::Core::Matrix4x4 result = matrix1 * matrix2;
+
+    ASSERT_TRUE(result.ExactlyEquals(expected));
+}
+
 TEST(Matrix4x4Test, Transpose)
 {
     Lateralus::Core::Matrix4x4 matrix(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f,
@@ -471,5 +490,299 @@ TEST(Matrix4x4Test, CreateLookAt)
     ASSERT_NEAR(lookAtMatrix.r3.w, expectedLookAtMatrix.r3.w, 1e-5);
 }
 
+namespace
+{
+// A transform touching every element, so a swapped lane shows up in every output.
+Lateralus::Core::Matrix4x4 BatchTestMatrix()
+{
+    return Lateralus::Core::Matrix4x4(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f,
+                                      11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f);
+}
+
+// 19 covers two full batches of 8 plus a scalar tail.
+constexpr size_t k_BatchTestCount = 19;
+} // namespace
+
+TEST(Matrix4x4Test, TransformPointsAndNormals)
+{
+    Lateralus::Core::Matrix4x4 const matrix = BatchTestMatrix();
+
+    std::vector<Lateralus::Core::Vector3> input;
+    for (size_t i = 0; i < k_BatchTestCount; ++i)
+    {
+        float const f = static_cast<float>(i);
+        input.emplace_back(f, f * 2.0f - 7.0f, 0.5f - f);
+    }
+
+    std::vector<Lateralus::Core::Vector3> points(input.size());
+    std::vector<Lateralus::Core::Vector3> normals(input.size());
+    Lateralus::Core::TransformPoints(matrix, input, points);
+    Lateralus::Core::TransformNormals(matrix, input, normals);
+
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        Lateralus::Core::Vector3 const &v = input[i];
+        Lateralus::Core::Vector4 const point =
+            matrix * Lateralus::Core::Vector4(v.x, v.y, v.z, 1.0f);
+        Lateralus::Core::Vector4 const normal =
+            matrix * Lateralus::Core::Vector4(v.x, v.y, v.z, 0.0f);
+        EXPECT_FLOAT_EQ(points[i].x, point.x);
+        EXPECT_FLOAT_EQ(points[i].y, point.y);
+        EXPECT_FLOAT_EQ(points[i].z, point.z);
+        EXPECT_FLOAT_EQ(normals[i].x, normal.x);
+        EXPECT_FLOAT_EQ(normals[i].y, normal.y);
+        EXPECT_FLOAT_EQ(normals[i].z, normal.z);
+    }
+
+    // In-place is supported.
+    Lateralus::Core::TransformPoints(matrix, input, input);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        EXPECT_TRUE(input[i].ExactlyEquals(points[i]));
+    }
+}
+
+TEST(Matrix4x4Test, TransformPointsStreams)
+{
+    Lateralus::Core::Matrix4x4 const matrix = BatchTestMatrix();
+
+    std::vector<float> x, y, z;
+    for (size_t i = 0; i < k_BatchTestCount; ++i)
+    {
+        float const f = static_cast<float>(i);
+        x.push_back(f);
+        y.push_back(f * 2.0f - 7.0f);
+        z.push_back(0.5f - f);
+    }
+
+    std::vector<float> outX(x.size()), outY(x.size()), outZ(x.size());
+    Lateralus::Core::TransformPoints(matrix, {x, y, z}, {outX, outY, outZ});
+
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        Lateralus::Core::Vector4 const expected =
+            matrix * Lateralus::Core::Vector4(x[i], y[i], z[i], 1.0f);
+        EXPECT_FLOAT_EQ(outX[i], expected.x);
+        EXPECT_FLOAT_EQ(outY[i], expected.y);
+        EXPECT_FLOAT_EQ(outZ[i], expected.z);
+    }
+}
+
+TEST(Matrix4x4Test, TransformVectors)
+{
+    Lateralus::Core::Matrix4x4 const matrix = BatchTestMatrix();
+
+    std::vector<Lateralus::Core::Vector4> input;
+    std::vector<float> x, y, z, w;
+    for (size_t i = 0; i < k_BatchTestCount; ++i)
+    {
+        float const f = static_cast<float>(i);
+        input.emplace_back(f, f * 2.0f - 7.0f, 0.5f - f, f * 0.25f);
+        x.push_back(input.back().x);
+        y.push_back(input.back().y);
+        z.push_back(input.back().z);
+        w.push_back(input.back().w);
+    }
+
+    std::vector<Lateralus::Core::Vector4> output(input.size());
+    Lateralus::Core::TransformVectors(matrix, input, output);
+
+    std::vector<float> outX(x.size()), outY(x.size()), outZ(x.size()), outW(x.size());
+    Lateralus::Core::TransformVectors(matrix, {x, y, z, w}, {outX, outY, outZ, outW});
+
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        Lateralus::Core::Vector4 const expected = matrix * input[i];
+        EXPECT_FLOAT_EQ(output[i].x, expected.x);
+        EXPECT_FLOAT_EQ(output[i].y, expected.y);
+        EXPECT_FLOAT_EQ(output[i].z, expected.z);
+        EXPECT_FLOAT_EQ(output[i].w, expected.w);
+        EXPECT_FLOAT_EQ(outX[i], expected.x);
+        EXPECT_FLOAT_EQ(outY[i], expected.y);
+        EXPECT_FLOAT_EQ(outZ[i], expected.z);
+        EXPECT_FLOAT_EQ(outW[i], expected.w);
+    }
+}
+
+TEST(Matrix4x4Test, CreateRotations)
+{
+    std::vector<Lateralus::Core::Vector3> rotations;
+    for (int i = 0; i < 11; ++i)
+    {
+        float const f = static_cast<float>(i);
+        rotations.emplace_back(f * 37.0f - 180.0f, f * -23.0f, f * 61.0f + 5.0f);
+    }
+
+    std::vector<Lateralus::Core::Matrix4x4> output(rotations.size());
+    Lateralus::Core::CreateRotations(rotations, output);
+
+    for (size_t i = 0; i < rotations.size(); ++i)
+    {
+        Lateralus::Core::Matrix4x4 const expected =
+            Lateralus::Core::Matrix4x4::CreateRotation(rotations[i]);
+        Lateralus::Core::Vector4 const *actualRows = &output[i].r0;
+        Lateralus::Core::Vector4 const *expectedRows = &expected.r0;
+        for (int row = 0; row < 4; ++row)
+        {
+            EXPECT_NEAR(actualRows[row].x, expectedRows[row].x, 1e-6f);
+            EXPECT_NEAR(actualRows[row].y, expectedRows[row].y, 1e-6f);
+            EXPECT_NEAR(actualRows[row].z, expectedRows[row].z, 1e-6f);
+            EXPECT_NEAR(actualRows[row].w, expectedRows[row].w, 1e-6f);
+        }
+    }
+}
+
+namespace
+{
+void ExpectNear(Lateralus::Core::Matrix4x4 const &expected,
+                Lateralus::Core::Matrix3x4 const &actual)
+{
+    Lateralus::Core::Matrix4x4 const actual4x4 = actual.ToMatrix4x4();
+    Lateralus::Core::Vector4 const *expectedRows = &expected.r0;
+    Lateralus::Core::Vector4 const *actualRows = &actual4x4.r0;
+    for (int row = 0; row < 4; ++row)
+    {
+        EXPECT_NEAR(actualRows[row].x, expectedRows[row].x, 1e-5f);
+        EXPECT_NEAR(actualRows[row].y, expectedRows[row].y, 1e-5f);
+        EXPECT_NEAR(actualRows[row].z, expectedRows[row].z, 1e-5f);
+        EXPECT_NEAR(actualRows[row].w, expectedRows[row].w, 1e-5f);
+    }
+}
+
+Lateralus::Core::Matrix4x4 AffineTestMatrix()
+{
+    Lateralus::Core::Vector3 const translation(3.0f, -2.0f, 7.0f);
+    Lateralus::Core::Vector3 const rotation(25.0f, -40.0f, 115.0f);
+    Lateralus::Core::Vector3 const scale(2.0f, 0.5f, 1.5f);
+    return Lateralus::Core::Matrix4x4::CreateTranslation(translation) *
+           Lateralus::Core::Matrix4x4::CreateRotation(rotation) *
+           Lateralus::Core::Matrix4x4::CreateScale(scale);
+}
+} // namespace
+
+TEST(Matrix3x4Test, ConvertsToAndFromMatrix4x4)
+{
+    Lateralus::Core::Matrix4x4 const affine = AffineTestMatrix();
+    Lateralus::Core::Matrix3x4 const m(affine);
+    EXPECT_TRUE(m.ToMatrix4x4().ExactlyEquals(affine));
+    EXPECT_TRUE(Lateralus::Core::Matrix3x4().ToMatrix4x4().ExactlyEquals(
+        Lateralus::Core::Matrix4x4::Identity()));
+    EXPECT_EQ(sizeof(Lateralus::Core::Matrix3x4), 12 * sizeof(float));
+}
+
+TEST(Matrix3x4Test, CreateMatchesMatrix4x4)
+{
+    Lateralus::Core::Vector3 const v(1.5f, -2.0f, 4.0f);
+    Lateralus::Core::Vector3 const axis = Lateralus::Core::Vector3(1.0f, 1.0f, 0.0f).Normalized();
+    ExpectNear(Lateralus::Core::Matrix4x4::CreateTranslation(v),
+               Lateralus::Core::Matrix3x4::CreateTranslation(v));
+    ExpectNear(Lateralus::Core::Matrix4x4::CreateRotation(v + v),
+               Lateralus::Core::Matrix3x4::CreateRotation(v + v));
+    ExpectNear(Lateralus::Core::Matrix4x4::CreateRotation(axis, 33.0f),
+               Lateralus::Core::Matrix3x4::CreateRotation(axis, 33.0f));
+    ExpectNear(Lateralus::Core::Matrix4x4::CreateScale(v),
+               Lateralus::Core::Matrix3x4::CreateScale(v));
+
+    Lateralus::Core::Vector3 const eye(0.0f, 2.0f, -5.0f);
+    Lateralus::Core::Vector3 const target(1.0f, 0.0f, 0.0f);
+    Lateralus::Core::Vector3 const up(0.0f, 1.0f, 0.0f);
+    ExpectNear(Lateralus::Core::Matrix4x4::CreateLookAt(eye, target, up),
+               Lateralus::Core::Matrix3x4::CreateLookAt(eye, target, up));
+}
+
+TEST(Matrix3x4Test, ComposeAndTransformMatchMatrix4x4)
+{
+    Lateralus::Core::Matrix4x4 const a = AffineTestMatrix();
+    Lateralus::Core::Matrix4x4 const b =
+        Lateralus::Core::Matrix4x4::CreateRotation(Lateralus::Core::Vector3(0.0f, 1.0f, 0.0f),
+                                                   70.0f) *
+        Lateralus::Core::Matrix4x4::CreateTranslation(Lateralus::Core::Vector3(-1.0f, 4.0f, 0.5f));
+    ExpectNear(a * b, Lateralus::Core::Matrix3x4(a) * Lateralus::Core::Matrix3x4(b));
+
+    Lateralus::Core::Matrix3x4 const m(a);
+    Lateralus::Core::Vector3 const p(0.25f, -3.0f, 2.0f);
+    Lateralus::Core::Vector4 const point = a * Lateralus::Core::Vector4(p.x, p.y, p.z, 1.0f);
+    Lateralus::Core::Vector4 const direction = a * Lateralus::Core::Vector4(p.x, p.y, p.z, 0.0f);
+    EXPECT_TRUE(
+        m.TransformPoint(p).RoughlyEquals(Lateralus::Core::Vector3(point.x, point.y, point.z)));
+    EXPECT_TRUE(m.TransformVector(p).RoughlyEquals(
+        Lateralus::Core::Vector3(direction.x, direction.y, direction.z)));
+}
+
+TEST(Matrix3x4Test, InverseAffine)
+{
+    Lateralus::Core::Matrix4x4 const a = AffineTestMatrix();
+    Lateralus::Core::Matrix3x4 const m(a);
+    EXPECT_NEAR(m.Determinant(), a.Determinant(), 1e-5f);
+
+    Lateralus::Core::Matrix3x4 const inverse = m.InverseAffine();
+    ExpectNear(a.Inverse(), inverse);
+    ExpectNear(Lateralus::Core::Matrix4x4::Identity(), m * inverse);
+    ExpectNear(Lateralus::Core::Matrix4x4::Identity(), inverse * m);
+
+    // Singular matrices come back unchanged, like Matrix4x4::Inverse.
+    Lateralus::Core::Matrix3x4 const flat =
+        Lateralus::Core::Matrix3x4::CreateScale(Lateralus::Core::Vector3(1.0f, 0.0f, 1.0f));
+    EXPECT_TRUE(flat.InverseAffine().ExactlyEquals(flat));
+}
 
-} // namespace Lateralus::Core::Tests
\ No newline at end of file
+TEST(Matrix3x4Test, InverseRigid)
+{
+    Lateralus::Core::Vector3 const translation(3.0f, -2.0f, 7.0f);
+    Lateralus::Core::Vector3 const rotation(25.0f, -40.0f, 115.0f);
+    Lateralus::Core::Matrix4x4 const rigid =
+        Lateralus::Core::Matrix4x4::CreateTranslation(translation) *
+        Lateralus::Core::Matrix4x4::CreateRotation(rotation);
+    Lateralus::Core::Matrix3x4 const m(rigid);
+    ExpectNear(rigid.Inverse(), m.InverseRigid());
+    ExpectNear(rigid.Inverse(), m.InverseAffine());
+}
+
+TEST(Matrix4x4Test, ConstexprMatchesRuntime)
+{
+    using Lateralus::Core::Matrix3x4;
+    using Lateralus::Core::Matrix4x4;
+    using Lateralus::Core::Vector3;
+    using Lateralus::Core::Vector4;
+
+    constexpr Vector3 k_Translation(3.0f, -2.0f, 7.0f);
+    constexpr Vector3 k_Rotation(25.0f, -40.0f, 115.0f);
+    constexpr Vector3 k_Scale(2.0f, 0.5f, 1.5f);
+    constexpr Matrix4x4 k_Model = Matrix4x4::CreateTranslation(k_Translation) *
+                                  Matrix4x4::CreateRotation(k_Rotation) *
+                                  Matrix4x4::CreateScale(k_Scale);
+    constexpr Matrix4x4 k_Inverse = k_Model.Inverse();
+    constexpr Matrix4x4 k_Projection =
+        Matrix4x4::CreatePerspectiveProjection(60.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    constexpr Matrix3x4 k_Affine = Matrix3x4(k_Model).InverseAffine();
+    constexpr Vector4 k_Point = k_Projection * (k_Model * Vector4(1.0f, 2.0f, 3.0f, 1.0f));
+    static_assert(Matrix4x4::Identity().ExactlyEquals(Matrix4x4().Transpose()));
+
+    Matrix4x4 const model = Matrix4x4::CreateTranslation(k_Translation) *
+                            Matrix4x4::CreateRotation(k_Rotation) * Matrix4x4::CreateScale(k_Scale);
+    Matrix4x4 const projection =
+        Matrix4x4::CreatePerspectiveProjection(60.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    Vector4 const point = projection * (model * Vector4(1.0f, 2.0f, 3.0f, 1.0f));
+
+    Matrix4x4 const pairs[][2] = {{k_Model, model},
+                                  {k_Inverse, model.Inverse()},
+                                  {k_Projection, projection},
+                                  {k_Affine.ToMatrix4x4(), model.Inverse()}};
+    for (auto const &pair : pairs)
+    {
+        Vector4 const *constantRows = &pair[0].r0;
+        Vector4 const *runtimeRows = &pair[1].r0;
+        for (int row = 0; row < 4; ++row)
+        {
+            EXPECT_NEAR(constantRows[row].x, runtimeRows[row].x, 1e-5f);
+            EXPECT_NEAR(constantRows[row].y, runtimeRows[row].y, 1e-5f);
+            EXPECT_NEAR(constantRows[row].z, runtimeRows[row].z, 1e-5f);
+            EXPECT_NEAR(constantRows[row].w, runtimeRows[row].w, 1e-5f);
+        }
+    }
+    EXPECT_NEAR(k_Point.x, point.x, 1e-5f);
+    EXPECT_NEAR(k_Point.y, point.y, 1e-5f);
+    EXPECT_NEAR(k_Point.z, point.z, 1e-5f);
+    EXPECT_NEAR(k_Point.w, point.w, 1e-5f);
+}
+} // namespace Lateralus::Core::Tests
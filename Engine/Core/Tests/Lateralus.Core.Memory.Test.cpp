@@ -0,0 +1,281 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Memory;
+import Lateralus.Core.StringUtils;
+
+import <cstring>;
+import <memory>;
+import <memory_resource>;
+import <string>;
+import <string_view>;
+import <thread>;
+import <vector>;
+
+using namespace std;
+
+namespace Lateralus::Core::Tests
+{
+TEST(Core_Memory, LinearArenaBumpsAndResets)
+{
+    LinearArena arena(1024);
+    void *a = arena.allocate(3, 1);
+    void *b = arena.allocate(16, 16);
+    void *c = arena.allocate(8, 8);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 16, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 8, 0u);
+    EXPECT_LT(a, b);
+    EXPECT_LT(b, c);
+    EXPECT_EQ(arena.GetUsed(), 16u + 16u + 8u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetUsed(), 0u);
+    EXPECT_EQ(arena.GetPeak(), 40u);
+    // Same block, so the same first address.
+    EXPECT_EQ(arena.allocate(3, 1), a);
+}
+
+TEST(Core_Memory, LinearArenaGrowsAfterOverflow)
+{
+    LinearArena arena(256);
+    EXPECT_EQ(arena.GetCapacity(), 256u);
+    vector<void *> pointers;
+    for (int i = 0; i < 10; ++i)
+    {
+        pointers.push_back(arena.allocate(100, 4));
+    }
+    // Overflowing allocations are still distinct and usable.
+    for (void *pointer : pointers)
+    {
+        memset(pointer, 0xAB, 100);
+    }
+    EXPECT_EQ(arena.GetUsed(), 1000u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetCapacity(), 1024u);
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_NE(arena.allocate(100, 4), nullptr);
+    }
+    EXPECT_EQ(arena.GetCapacity(), 1024u);
+    EXPECT_EQ(arena.GetUsed(), 1000u);
+}
+
+TEST(Core_Memory, LinearArenaFromManyThreads)
+{
+    LinearArena arena(64 * 1024);
+    constexpr usz threadCount = 4;
+    constexpr usz perThread = 2000;
+    vector<vector<uint32 *>> allocations(threadCount);
+    vector<thread> threads;
+    for (usz t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&arena, &allocations, t] {
+            for (usz i = 0; i < perThread; ++i)
+            {
+                auto *value = static_cast<uint32 *>(arena.allocate(sizeof(uint32), 4));
+                *value = static_cast<uint32>(t * perThread + i);
+                allocations[t].push_back(value);
+            }
+        });
+    }
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+    // Nothing was handed out twice, including the part that spilled past the block.
+    for (usz t = 0; t < threadCount; ++t)
+    {
+        for (usz i = 0; i < perThread; ++i)
+        {
+            EXPECT_EQ(*allocations[t][i], t * perThread + i);
+        }
+    }
+    EXPECT_EQ(arena.GetUsed(), threadCount * perThread * sizeof(uint32));
+}
+
+TEST(Core_Memory, FrameArenaKeepsPreviousFrame)
+{
+    FrameArena frames(4096);
+    pmr::vector<int> *first = nullptr;
+    {
+        pmr::polymorphic_allocator<int> allocator(&frames.GetCurrent());
+        first = allocator.new_object<pmr::vector<int>>();
+        first->assign({1, 2, 3});
+    }
+    usz const used = frames.GetCurrent().GetUsed();
+    EXPECT_GT(used, 0u);
+
+    // One frame on, the data is still there in the previous arena.
+    frames.NewFrame();
+    EXPECT_EQ(frames.GetFrameIndex(), 1u);
+    EXPECT_EQ(frames.GetPrevious().GetUsed(), used);
+    EXPECT_EQ(frames.GetCurrent().GetUsed(), 0u);
+    EXPECT_EQ(*first, (pmr::vector<int>{1, 2, 3}));
+
+    // Two frames on, its arena is reset and current again.
+    frames.NewFrame();
+    EXPECT_EQ(frames.GetCurrent().GetUsed(), 0u);
+    EXPECT_EQ(frames.GetCurrent().GetPeak(), used);
+}
+
+TEST(Core_Memory, SplitIntoFrameMemory)
+{
+    LinearArena &arena = GetFrameArena().GetCurrent();
+    usz const before = arena.GetUsed();
+    auto const split = StringUtils::SplitStringView(string_view("a/b/c"), string_view("/"),
+                                                    GetFrameAllocator<string_view>());
+    EXPECT_EQ(split, (pmr::vector<string_view>{"a", "b", "c"}));
+    EXPECT_EQ(split.get_allocator().resource(), &arena);
+    EXPECT_GE(arena.GetUsed(), before + 3 * sizeof(string_view));
+}
+TEST(Core_Memory, PoolReusesBlocks)
+{
+    for (usz bytes : {1, 16, 17, 48, 100, 200, 1000, 1024})
+    {
+        void *first = PoolAllocate(bytes);
+        memset(first, 0xCD, bytes);
+        PoolFree(first, bytes);
+        // The last block freed on a thread is the next one handed out for its size.
+        void *second = PoolAllocate(bytes);
+        EXPECT_EQ(first, second);
+        PoolFree(second, bytes);
+    }
+}
+
+TEST(Core_Memory, PoolAlignsBlocks)
+{
+    for (usz alignment : {1, 2, 4, 8, 16, 32, 64, 128})
+    {
+        for (usz bytes : {1, 24, 40, 72, 100, 300, 700, 2000})
+        {
+            void *pointer = PoolAllocate(bytes, alignment);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(pointer) % alignment, 0u);
+            memset(pointer, 0, bytes);
+            PoolFree(pointer, bytes, alignment);
+        }
+    }
+}
+
+TEST(Core_Memory, PoolNewAndShared)
+{
+    string *text = PoolNew<string>(100, 'x');
+    EXPECT_EQ(text->size(), 100u);
+    PoolDelete(text);
+
+    weak_ptr<string> weak;
+    {
+        shared_ptr<string const> shared = MakePoolShared<string const>("pooled");
+        EXPECT_EQ(*shared, "pooled");
+        weak = const_pointer_cast<string>(shared);
+    }
+    EXPECT_TRUE(weak.expired());
+}
+
+TEST(Core_Memory, PoolFreesOnOtherThreads)
+{
+    // Producers allocate, one consumer frees, so blocks keep moving between threads.
+    constexpr usz producerCount = 3;
+    constexpr usz perProducer = 20000;
+    vector<vector<uint64 *>> made(producerCount);
+    vector<thread> threads;
+    for (usz p = 0; p < producerCount; ++p)
+    {
+        threads.emplace_back([&made, p] {
+            for (usz i = 0; i < perProducer; ++i)
+            {
+                made[p].push_back(PoolNew<uint64>(p * perProducer + i));
+            }
+        });
+    }
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+    thread consumer([&made] {
+        for (usz p = 0; p < producerCount; ++p)
+        {
+            for (usz i = 0; i < perProducer; ++i)
+            {
+                EXPECT_EQ(*made[p][i], p * perProducer + i);
+                PoolDelete(made[p][i]);
+            }
+        }
+    });
+    consumer.join();
+
+    // Exited threads hand their blocks back, so running the same again takes no new slabs.
+    usz const reserved = GetPoolReservedBytes();
+    for (int round = 0; round < 4; ++round)
+    {
+        thread churn([] {
+            vector<uint64 *> values;
+            for (usz i = 0; i < producerCount * perProducer; ++i)
+            {
+                values.push_back(PoolNew<uint64>(i));
+            }
+            for (uint64 *value : values)
+            {
+                PoolDelete(value);
+            }
+        });
+        churn.join();
+    }
+    EXPECT_EQ(GetPoolReservedBytes(), reserved);
+}
+TEST(Core_Memory, TagsCountAllocations)
+{
+    // Nothing else in the tests uses the assets tag, so the numbers are exact.
+    MemoryTagStats const before = GetMemoryTagStats(MemoryTag::Assets);
+
+    void *block = TaggedMalloc(MemoryTag::Assets, 1000);
+    memset(block, 0, 1000);
+    TrackAlloc(MemoryTag::Assets, 24);
+    MemoryTagStats stats = GetMemoryTagStats(MemoryTag::Assets);
+    EXPECT_EQ(stats.CurrentBytes, before.CurrentBytes + 1024);
+    EXPECT_EQ(stats.LiveCount, before.LiveCount + 2);
+    EXPECT_EQ(stats.AllocationCount, before.AllocationCount + 2);
+    EXPECT_GE(stats.PeakBytes, stats.CurrentBytes);
+
+    TaggedMallocFree(MemoryTag::Assets, block);
+    TrackFree(MemoryTag::Assets, 24);
+    stats = GetMemoryTagStats(MemoryTag::Assets);
+    EXPECT_EQ(stats.CurrentBytes, before.CurrentBytes);
+    EXPECT_EQ(stats.LiveCount, before.LiveCount);
+    EXPECT_GE(stats.PeakBytes, before.CurrentBytes + 1024);
+
+    {
+        pmr::vector<int> values(GetTaggedResource(MemoryTag::Assets));
+        values.resize(100);
+        shared_ptr<string> shared = MakeTaggedShared<string>(MemoryTag::Assets, "tagged");
+        vector<int, TaggedAllocator<int>> more(50, 0, TaggedAllocator<int>(MemoryTag::Assets));
+        EXPECT_GE(GetMemoryTagStats(MemoryTag::Assets).CurrentBytes,
+                  before.CurrentBytes + 150 * sizeof(int) + sizeof(string));
+    }
+    EXPECT_EQ(GetMemoryTagStats(MemoryTag::Assets).CurrentBytes, before.CurrentBytes);
+}
+
+TEST(Core_Memory, TagPeakFromManyThreads)
+{
+    MemoryTagStats const before = GetMemoryTagStats(MemoryTag::Assets);
+    vector<thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([] {
+            for (int i = 0; i < 10000; ++i)
+            {
+                TrackAlloc(MemoryTag::Assets, 8);
+                TrackFree(MemoryTag::Assets, 8);
+            }
+        });
+    }
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+    MemoryTagStats const after = GetMemoryTagStats(MemoryTag::Assets);
+    EXPECT_EQ(after.CurrentBytes, before.CurrentBytes);
+    EXPECT_EQ(after.AllocationCount, before.AllocationCount + 40000);
+    EXPECT_LE(after.PeakBytes, max<uint64>(before.PeakBytes, before.CurrentBytes + 4 * 8));
+}
+} // namespace Lateralus::Core::Tests
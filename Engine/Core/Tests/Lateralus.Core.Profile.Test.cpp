@@ -0,0 +1,347 @@
+#include <gtest/gtest.h>
+#include <Core.Profile.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Profile;
+
+import <algorithm>;
+import <chrono>;
+import <sstream>;
+import <string>;
+import <string_view>;
+import <thread>;
+import <vector>;
+
+using namespace std;
+
+namespace Lateralus::Core::Profile::Tests
+{
+namespace
+{
+// This thread's capture, found by name.
+ThreadCapture FindThread(string_view name, uint64 sinceTicks = 0)
+{
+    for (ThreadCapture &capture : CaptureZones(sinceTicks))
+    {
+        if (capture.Name == name)
+        {
+            return capture;
+        }
+    }
+    return {};
+}
+
+void Inner()
+{
+    LAT_PROFILE_FUNCTION();
+    this_thread::sleep_for(chrono::milliseconds(1));
+}
+
+void Outer()
+{
+    LAT_PROFILE_ZONE("Outer");
+    Inner();
+    Inner();
+}
+
+// Counts up by one more for each counter on every read.
+bool ReadFakeCounters(HardwareCounters &countersOut)
+{
+    static thread_local uint64 reads = 0;
+    reads++;
+    for (usz i = 0; i < k_HardwareCounterCount; ++i)
+    {
+        countersOut[i] = reads * (i + 1);
+    }
+    return true;
+}
+} // namespace
+
+TEST(Core_Profile, TicksAdvance)
+{
+    uint64 const before = GetTicks();
+    this_thread::sleep_for(chrono::milliseconds(10));
+    uint64 const elapsed = GetTicks() - before;
+    EXPECT_GT(GetTicksPerSecond(), 0u);
+    double const milliseconds = TicksToMilliseconds(elapsed);
+    EXPECT_GE(milliseconds, 9.0);
+    EXPECT_LT(milliseconds, 1000.0);
+}
+
+TEST(Core_Profile, RecordsNestedZones)
+{
+    thread([] {
+        SetThreadName("Nested");
+        Outer();
+    }).join();
+
+    ThreadCapture const capture = FindThread("Nested");
+    ASSERT_EQ(capture.Zones.size(), 3u);
+    // Zones are recorded as they end, so the nested ones come first.
+    ZoneRecord const &first = capture.Zones[0];
+    ZoneRecord const &second = capture.Zones[1];
+    ZoneRecord const &outer = capture.Zones[2];
+    EXPECT_STREQ(first.Site->Name, "Inner");
+    EXPECT_STREQ(outer.Site->Name, "Outer");
+    EXPECT_EQ(first.Depth, 1u);
+    EXPECT_EQ(second.Depth, 1u);
+    EXPECT_EQ(outer.Depth, 0u);
+    EXPECT_LE(outer.Begin, first.Begin);
+    EXPECT_LE(first.End, second.Begin);
+    EXPECT_LE(second.End, outer.End);
+    EXPECT_GE(TicksToMilliseconds(outer.End - outer.Begin), 2.0);
+}
+
+TEST(Core_Profile, KeepsLatestZones)
+{
+    constexpr usz zoneCount = 40000;
+    thread([] {
+        SetThreadName("Overflow");
+        for (usz i = 0; i < zoneCount; ++i)
+        {
+            LAT_PROFILE_ZONE("Many");
+        }
+    }).join();
+
+    ThreadCapture const capture = FindThread("Overflow");
+    ASSERT_FALSE(capture.Zones.empty());
+    EXPECT_LT(capture.Zones.size(), zoneCount);
+    EXPECT_TRUE(is_sorted(capture.Zones.begin(), capture.Zones.end(),
+                          [](ZoneRecord const &a, ZoneRecord const &b) { return a.End < b.End; }));
+}
+
+TEST(Core_Profile, CapturesZonesSince)
+{
+    uint64 since = 0;
+    thread([&since] {
+        SetThreadName("Since");
+        LAT_PROFILE_ZONE("Spanning");
+        for (usz i = 0; i < 100; ++i)
+        {
+            LAT_PROFILE_ZONE("Before");
+        }
+        since = GetTicks();
+        LAT_PROFILE_ZONE("After");
+    }).join();
+
+    // Zones that ended since, including any that started before.
+    ThreadCapture const capture = FindThread("Since", since);
+    ASSERT_EQ(capture.Zones.size(), 2u);
+    EXPECT_STREQ(capture.Zones[0].Site->Name, "After");
+    EXPECT_STREQ(capture.Zones[1].Site->Name, "Spanning");
+    EXPECT_EQ(FindThread("Since").Zones.size(), 102u);
+}
+
+TEST(Core_Profile, CapturesWhileThreadsRecord)
+{
+    atomic<bool> stop = false;
+    vector<thread> threads;
+    for (int t = 0; t < 3; ++t)
+    {
+        threads.emplace_back([&stop] {
+            while (!stop)
+            {
+                LAT_PROFILE_ZONE("Busy");
+                LAT_PROFILE_ZONE("Nested");
+            }
+        });
+    }
+    for (int i = 0; i < 20; ++i)
+    {
+        for (ThreadCapture const &capture : CaptureZones())
+        {
+            for (ZoneRecord const &zone : capture.Zones)
+            {
+                // Torn records would show up as garbage sites or inverted times.
+                ASSERT_NE(zone.Site, nullptr);
+                ASSERT_LE(zone.Begin, zone.End);
+            }
+        }
+    }
+    stop = true;
+    for (thread &t : threads)
+    {
+        t.join();
+    }
+}
+
+TEST(Core_Profile, ReusesExitedThreads)
+{
+    auto const shortLived = [] {
+        for (int i = 0; i < 64; ++i)
+        {
+            thread([] { LAT_PROFILE_ZONE("ShortLived"); }).join();
+        }
+    };
+    shortLived();
+    usz const threadCount = CaptureZones().size();
+    shortLived();
+    EXPECT_EQ(CaptureZones().size(), threadCount);
+
+    // A thread given an exited one's rings only shows its own zones.
+    thread([] {
+        SetThreadName("Reused");
+        LAT_PROFILE_ZONE("Own");
+    }).join();
+    ThreadCapture const capture = FindThread("Reused");
+    ASSERT_EQ(capture.Zones.size(), 1u);
+    EXPECT_STREQ(capture.Zones[0].Site->Name, "Own");
+}
+
+TEST(Core_Profile, MarksFrames)
+{
+    usz const before = CaptureFrames().size();
+    MarkFrame();
+    MarkFrame();
+    vector<uint64> const frames = CaptureFrames();
+    ASSERT_EQ(frames.size(), min<usz>(before + 2, 1024));
+    EXPECT_LE(frames[frames.size() - 2], frames.back());
+}
+
+TEST(Core_Profile, HistogramsFrameTimes)
+{
+    auto const ticks = [](double milliseconds) {
+        return static_cast<uint64>(milliseconds / 1000.0 *
+                                   static_cast<double>(GetTicksPerSecond()));
+    };
+    // Frames of 0.5, 1.5, 1.8, 4.5 and 100 milliseconds.
+    vector<uint64> const frames = {1000,
+                                   1000 + ticks(0.5),
+                                   1000 + ticks(2.0),
+                                   1000 + ticks(3.8),
+                                   1000 + ticks(8.3),
+                                   1000 + ticks(108.3)};
+    vector<uint32> const buckets = HistogramFrameTimes(frames, 1.0, 5);
+    EXPECT_EQ(buckets, (vector<uint32>{1, 2, 0, 0, 2}));
+    EXPECT_EQ(HistogramFrameTimes({}, 1.0, 3), (vector<uint32>{0, 0, 0}));
+}
+
+TEST(Core_Profile, RecordsHardwareCounters)
+{
+    SetHardwareCounterReader(ReadFakeCounters);
+    thread([] {
+        SetThreadName("Counted");
+        LAT_PROFILE_ZONE_COUNTERS("Counted outer");
+        {
+            LAT_PROFILE_ZONE("Plain inner");
+        }
+        LAT_PROFILE_ZONE_COUNTERS("Counted inner");
+    }).join();
+    SetHardwareCounterReader(nullptr);
+    thread([] {
+        SetThreadName("Uncounted");
+        LAT_PROFILE_ZONE_COUNTERS("Uncounted");
+    }).join();
+
+    ThreadCapture const counted = FindThread("Counted");
+    ASSERT_EQ(counted.Zones.size(), 3u);
+    // Both kinds of zone come back in the order they ended.
+    EXPECT_STREQ(counted.Zones[0].Site->Name, "Plain inner");
+    EXPECT_FALSE(counted.Zones[0].HasCounters);
+    EXPECT_STREQ(counted.Zones[1].Site->Name, "Counted inner");
+    EXPECT_STREQ(counted.Zones[2].Site->Name, "Counted outer");
+    EXPECT_EQ(counted.Zones[1].Depth, 1u);
+    EXPECT_EQ(counted.Zones[2].Depth, 0u);
+    // Outer read first and fourth, inner second and third.
+    ASSERT_TRUE(counted.Zones[1].HasCounters);
+    ASSERT_TRUE(counted.Zones[2].HasCounters);
+    for (usz i = 0; i < k_HardwareCounterCount; ++i)
+    {
+        EXPECT_EQ(counted.Zones[1].Counters[i], 1 * (i + 1));
+        EXPECT_EQ(counted.Zones[2].Counters[i], 3 * (i + 1));
+    }
+
+    ThreadCapture const uncounted = FindThread("Uncounted");
+    ASSERT_EQ(uncounted.Zones.size(), 1u);
+    EXPECT_FALSE(uncounted.Zones[0].HasCounters);
+}
+
+TEST(Core_Profile, WritesChromeTrace)
+{
+    thread([] { LAT_PROFILE_ZONE("Before"); }).join();
+
+    ostringstream out;
+    TraceWriter writer(out);
+    thread([] {
+        SetThreadName("Trace \"quoted\"");
+        Outer();
+        LAT_PROFILE_COUNTER("Queue depth", 3);
+    }).join();
+    SetHardwareCounterReader(ReadFakeCounters);
+    thread([] {
+        SetThreadName("Trace counted");
+        LAT_PROFILE_ZONE_COUNTERS("Counted");
+    }).join();
+    SetHardwareCounterReader(nullptr);
+    MarkFrame();
+    writer.Drain();
+    usz const firstDrain = writer.GetWrittenCount();
+    // Zones, a counter, a frame and the threads' names.
+    EXPECT_EQ(firstDrain, 8u);
+
+    // Only what's new since the last drain is written again.
+    thread([] {
+        SetThreadName("Second");
+        LAT_PROFILE_ZONE("Later");
+    }).join();
+    writer.Finish();
+    EXPECT_EQ(writer.GetWrittenCount(), firstDrain + 2);
+    EXPECT_EQ(writer.GetLostCount(), 0u);
+
+    string const json = out.str();
+    EXPECT_TRUE(json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_TRUE(json.ends_with("]}\n"));
+    EXPECT_EQ(json.find("\"Before\""), string::npos);
+    EXPECT_NE(json.find("\"name\":\"Outer\",\"ph\":\"X\""), string::npos);
+    EXPECT_NE(json.find("\"name\":\"Later\",\"ph\":\"X\""), string::npos);
+    EXPECT_NE(json.find("\"name\":\"Queue depth\",\"ph\":\"C\""), string::npos);
+    EXPECT_NE(json.find("\"args\":{\"value\":3.000}"), string::npos);
+    EXPECT_NE(json.find("\"name\":\"Frame\",\"ph\":\"i\""), string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"Trace \\\"quoted\\\"\"}"), string::npos);
+    EXPECT_NE(json.find("\"args\":{\"Cycles\":1,\"Instructions\":2,\"L1D misses\":3,"
+                        "\"LLC misses\":4,\"Branch misses\":5,\"IPC\":2.000}"),
+              string::npos);
+    EXPECT_EQ(count(json.begin(), json.end(), '{'), count(json.begin(), json.end(), '}'));
+}
+
+TEST(Core_Profile, WritesTraceFromEarlier)
+{
+    thread([] { LAT_PROFILE_ZONE("TooEarly"); }).join();
+    uint64 const since = GetTicks();
+    thread([] {
+        SetThreadName("Earlier");
+        LAT_PROFILE_ZONE("Kept");
+        LAT_PROFILE_COUNTER("Kept counter", 1.5);
+    }).join();
+    MarkFrame();
+
+    // Made after everything above happened, but still writes what came after since.
+    ostringstream out;
+    TraceWriter writer(out, since);
+    writer.Finish();
+
+    string const json = out.str();
+    EXPECT_EQ(json.find("\"TooEarly\""), string::npos);
+    EXPECT_NE(json.find("\"name\":\"Kept\",\"ph\":\"X\""), string::npos);
+    EXPECT_NE(json.find("\"name\":\"Kept counter\",\"ph\":\"C\""), string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"Earlier\"}"), string::npos);
+    EXPECT_NE(json.find("\"name\":\"Frame\",\"ph\":\"i\""), string::npos);
+}
+
+TEST(Core_Profile, TraceCountsLostEvents)
+{
+    ostringstream out;
+    TraceWriter writer(out);
+    // More than a thread keeps between two drains.
+    thread([] {
+        for (usz i = 0; i < 20000; ++i)
+        {
+            LAT_PROFILE_ZONE("Flood");
+        }
+    }).join();
+    writer.Finish();
+    EXPECT_GT(writer.GetLostCount(), 0u);
+    // Every zone is either written or lost, and the thread is named.
+    EXPECT_EQ(writer.GetWrittenCount() + writer.GetLostCount(), 20000u + 1);
+}
+} // namespace Lateralus::Core::Profile::Tests
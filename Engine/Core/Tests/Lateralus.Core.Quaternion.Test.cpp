@@ -1,3 +1,206 @@
 #include <gtest/gtest.h>
 
-import Lateralus.Core.Vector;
\ No newline at end of file
+import Lateralus.Core.Math;
+import Lateralus.Core.Matrix;
+import Lateralus.Core.Quaternion;
+import Lateralus.Core.Vector;
+import <vector>;
+
+using namespace Lateralus::Core;
+
+namespace Lateralus::Core::Tests
+{
+namespace
+{
+constexpr float k_Tolerance = 1e-5f;
+
+void ExpectNear(Quaternion const &expected, Quaternion const &actual)
+{
+    EXPECT_NEAR(expected.i, actual.i, k_Tolerance);
+    EXPECT_NEAR(expected.j, actual.j, k_Tolerance);
+    EXPECT_NEAR(expected.k, actual.k, k_Tolerance);
+    EXPECT_NEAR(expected.r, actual.r, k_Tolerance);
+}
+
+void ExpectNear(Vector4 const &expected, Vector4 const &actual)
+{
+    EXPECT_NEAR(expected.x, actual.x, k_Tolerance);
+    EXPECT_NEAR(expected.y, actual.y, k_Tolerance);
+    EXPECT_NEAR(expected.z, actual.z, k_Tolerance);
+    EXPECT_NEAR(expected.w, actual.w, k_Tolerance);
+}
+
+void ExpectNear(Matrix4x4 const &expected, Matrix4x4 const &actual)
+{
+    ExpectNear(expected.r0, actual.r0);
+    ExpectNear(expected.r1, actual.r1);
+    ExpectNear(expected.r2, actual.r2);
+    ExpectNear(expected.r3, actual.r3);
+}
+
+// A spread of rotations covering both hemispheres so batch code has to flip some of them.
+std::vector<Quaternion> BatchTestRotations(usz count, float seed)
+{
+    std::vector<Quaternion> result;
+    for (usz n = 0; n < count; ++n)
+    {
+        float const f = static_cast<float>(n) + seed;
+        Quaternion q = Quaternion::FromEuler(Vector3(f * 37.0f, f * -53.0f, f * 71.0f));
+        result.push_back((n % 3 == 0) ? -q : q);
+    }
+    return result;
+}
+
+constexpr usz k_BatchRotationCount = 19;
+} // namespace
+
+TEST(Core_Quaternion, DefaultIsIdentity)
+{
+    Quaternion q;
+    EXPECT_TRUE(q.ExactlyEqual(Quaternion(0.0f, 0.0f, 0.0f, 1.0f)));
+    EXPECT_TRUE(q.ToMatrix().ExactlyEquals(Matrix4x4()));
+}
+
+TEST(Core_Quaternion, FromAxisAngleMatchesMatrix)
+{
+    Vector3 const axis(1.0f, 2.0f, -0.5f);
+    for (float angle : {0.0f, 30.0f, 90.0f, 135.0f, -270.0f})
+    {
+        ExpectNear(Matrix4x4::CreateRotation(axis.Normalized(), angle),
+                   Quaternion::FromAxisAngle(axis, angle).ToMatrix());
+    }
+}
+
+TEST(Core_Quaternion, FromEulerMatchesMatrix)
+{
+    Vector3 const angles(20.0f, -45.0f, 110.0f);
+    ExpectNear(Matrix4x4::CreateRotation(angles), Quaternion::FromEuler(angles).ToMatrix());
+}
+
+TEST(Core_Quaternion, MultiplicationComposesLikeMatrices)
+{
+    Quaternion const a = Quaternion::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), 40.0f);
+    Quaternion const b = Quaternion::FromAxisAngle(Vector3(1.0f, 0.0f, 1.0f), -75.0f);
+    ExpectNear(a.ToMatrix() * b.ToMatrix(), (a * b).ToMatrix());
+}
+
+TEST(Core_Quaternion, RotateMatchesMatrix)
+{
+    Quaternion const q = Quaternion::FromEuler(Vector3(10.0f, 20.0f, 30.0f));
+    Vector3 const v(3.0f, -1.0f, 2.0f);
+    Vector3 const rotated = q.Rotate(v);
+    Vector4 const expected = q.ToMatrix() * Vector4(v.x, v.y, v.z, 0.0f);
+    ExpectNear(expected, Vector4(rotated.x, rotated.y, rotated.z, 0.0f));
+}
+
+TEST(Core_Quaternion, NormalizeAndInvert)
+{
+    Quaternion q(1.0f, 2.0f, 3.0f, 4.0f);
+    EXPECT_FLOAT_EQ(q.LengthSquared(), 30.0f);
+    EXPECT_NEAR(q.Normalized().Length(), 1.0f, k_Tolerance);
+
+    ExpectNear(Quaternion(), q * Quaternion::Invert(q));
+    ExpectNear(Quaternion(), Quaternion::Invert(q) * q);
+}
+
+TEST(Core_Quaternion, SlerpEndpointsAndMidpoint)
+{
+    Vector3 const axis(0.0f, 0.0f, 1.0f);
+    Quaternion const start = Quaternion::FromAxisAngle(axis, 10.0f);
+    Quaternion const end = Quaternion::FromAxisAngle(axis, 130.0f);
+
+    ExpectNear(start, Quaternion::Slerp(start, end, 0.0f));
+    ExpectNear(end, Quaternion::Slerp(start, end, 1.0f));
+    ExpectNear(Quaternion::FromAxisAngle(axis, 70.0f), Quaternion::Slerp(start, end, 0.5f));
+    ExpectNear(Quaternion::FromAxisAngle(axis, 40.0f), Quaternion::Slerp(start, end, 0.25f));
+
+    // The same rotation expressed with the opposite sign still takes the short way around.
+    ExpectNear(Quaternion::FromAxisAngle(axis, 70.0f), Quaternion::Slerp(start, -end, 0.5f));
+}
+
+TEST(Core_Quaternion, NLerpIsNormalizedAndShortestPath)
+{
+    Vector3 const axis(0.0f, 1.0f, 0.0f);
+    Quaternion const start = Quaternion::FromAxisAngle(axis, -30.0f);
+    Quaternion const end = Quaternion::FromAxisAngle(axis, 30.0f);
+
+    ExpectNear(Quaternion(), Quaternion::NLerp(start, end, 0.5f));
+    ExpectNear(Quaternion(), Quaternion::NLerp(start, -end, 0.5f));
+    EXPECT_NEAR(Quaternion::NLerp(start, end, 0.3f).Length(), 1.0f, k_Tolerance);
+}
+
+TEST(Core_Quaternion, BatchInterpolationMatchesScalar)
+{
+    std::vector<Quaternion> const start = BatchTestRotations(k_BatchRotationCount, 0.25f);
+    std::vector<Quaternion> const end = BatchTestRotations(k_BatchRotationCount, 0.5f);
+    std::vector<float> ts;
+    for (usz n = 0; n < k_BatchRotationCount; ++n)
+    {
+        ts.push_back(static_cast<float>(n) / static_cast<float>(k_BatchRotationCount - 1));
+    }
+
+    std::vector<Quaternion> out(k_BatchRotationCount);
+
+    Quaternion::Lerp(start, end, ts, out);
+    for (usz n = 0; n < k_BatchRotationCount; ++n)
+    {
+        ExpectNear(Quaternion::Lerp(start[n], end[n], ts[n]), out[n]);
+    }
+
+    Quaternion::NLerp(start, end, ts, out);
+    for (usz n = 0; n < k_BatchRotationCount; ++n)
+    {
+        ExpectNear(Quaternion::NLerp(start[n], end[n], ts[n]), out[n]);
+    }
+
+    Quaternion::Slerp(start, end, ts, out);
+    for (usz n = 0; n < k_BatchRotationCount; ++n)
+    {
+        ExpectNear(Quaternion::Slerp(start[n], end[n], ts[n]), out[n]);
+    }
+
+    Quaternion::Slerp(start, end, 0.3f, out);
+    for (usz n = 0; n < k_BatchRotationCount; ++n)
+    {
+        ExpectNear(Quaternion::Slerp(start[n], end[n], 0.3f), out[n]);
+    }
+
+    // In place.
+    std::vector<Quaternion> inPlace = start;
+    Quaternion::NLerp(inPlace, end, 0.7f, inPlace);
+    for (usz n = 0; n < k_BatchRotationCount; ++n)
+    {
+        ExpectNear(Quaternion::NLerp(start[n], end[n], 0.7f), inPlace[n]);
+    }
+}
+
+TEST(Core_Quaternion, BatchToMatrixMatchesScalar)
+{
+    std::vector<Quaternion> const rotations = BatchTestRotations(k_BatchRotationCount, 0.0f);
+    std::vector<Matrix4x4> out(k_BatchRotationCount);
+    Quaternion::ToMatrix(rotations, out);
+    for (usz n = 0; n < k_BatchRotationCount; ++n)
+    {
+        ExpectNear(rotations[n].ToMatrix(), out[n]);
+    }
+}
+
+TEST(Core_Quaternion, ConstexprMatchesRuntime)
+{
+    constexpr Vector3 k_Angles(20.0f, -45.0f, 110.0f);
+    constexpr Vector3 k_Axis(1.0f, 2.0f, -0.5f);
+    constexpr Quaternion k_Euler = Quaternion::FromEuler(k_Angles);
+    constexpr Quaternion k_AxisAngle = Quaternion::FromAxisAngle(k_Axis, 135.0f);
+    constexpr Quaternion k_Composed = k_Euler * k_AxisAngle;
+    constexpr Quaternion k_Slerped = Quaternion::Slerp(k_Euler, k_AxisAngle, 0.3f);
+    constexpr Matrix4x4 k_Matrix = k_Composed.ToMatrix();
+
+    Quaternion const euler = Quaternion::FromEuler(k_Angles);
+    Quaternion const axisAngle = Quaternion::FromAxisAngle(k_Axis, 135.0f);
+    ExpectNear(euler, k_Euler);
+    ExpectNear(axisAngle, k_AxisAngle);
+    ExpectNear(euler * axisAngle, k_Composed);
+    ExpectNear(Quaternion::Slerp(euler, axisAngle, 0.3f), k_Slerped);
+    ExpectNear((euler * axisAngle).ToMatrix(), k_Matrix);
+}
+} // namespace Lateralus::Core::Tests
@@ -2,6 +2,8 @@
 
 import Lateralus.Core.Signal;
 
+import <vector>;
+
 using namespace std;
 
 namespace Lateralus::Core::Tests
@@ -66,6 +68,33 @@ TEST(Core_Signal, DoubleUnsubscribe)
     sig -= token;
 }
 
+TEST(Core_Signal, StaleTokenKeepsNewSubscription)
+{
+    Signal<void()> sig;
+    int calls = 0;
+    auto token = sig += [&calls]() { calls++; };
+    auto stale = token;
+    EXPECT_TRUE(sig -= token);
+    // Reuses the freed slot.
+    sig += [&calls]() { calls += 10; };
+    EXPECT_FALSE(sig -= stale);
+    sig();
+    EXPECT_EQ(calls, 10);
+}
+
+TEST(Core_Signal, InvokesInSubscriptionOrder)
+{
+    Signal<void(), SignalLockNull> sig;
+    vector<int> order;
+    auto first = sig += [&order]() { order.push_back(1); };
+    sig += [&order]() { order.push_back(2); };
+    sig += [&order]() { order.push_back(3); };
+    sig -= first;
+    sig += [&order]() { order.push_back(4); };
+    sig();
+    EXPECT_EQ(order, (vector<int>{2, 3, 4}));
+}
+
 TEST(Core_Signal, PassByCopyIsOncePerCall)
 {
     struct CopyTracker
@@ -170,4 +199,131 @@ TEST(Core_Signal, AsyncUnsubscribeWaitsForInvoke)
         t.join();
     }
 }
+
+TEST(Core_Signal, CopyOnWriteFiresAndUnsubscribes)
+{
+    Signal<void(int), SignalLockCopyOnWrite> sig;
+    int total = 0;
+    auto token = sig += [&total](int value) { total += value; };
+    sig += [&total](int value) { total += 10 * value; };
+    sig(1);
+    EXPECT_EQ(total, 11);
+    EXPECT_TRUE(sig -= token);
+    sig(1);
+    EXPECT_EQ(total, 21);
+    // Removing again is a safe no-op.
+    EXPECT_FALSE(sig -= token);
+}
+
+TEST(Core_Signal, CopyOnWriteSubscribeDuringInvoke)
+{
+    Signal<void(), SignalLockCopyOnWrite> sig;
+    int selfCalls = 0;
+    int addedCalls = 0;
+    Signal<void(), SignalLockCopyOnWrite>::Token selfToken;
+    // Removes itself and adds another function. With a mutex signal this would deadlock.
+    selfToken = sig += [&]() {
+        selfCalls++;
+        sig -= selfToken;
+        sig += [&addedCalls]() { addedCalls++; };
+    };
+
+    sig();
+    // Changes made while invoking apply from the next invoke.
+    EXPECT_EQ(selfCalls, 1);
+    EXPECT_EQ(addedCalls, 0);
+    sig();
+    EXPECT_EQ(selfCalls, 1);
+    EXPECT_EQ(addedCalls, 1);
+}
+
+TEST(Core_Signal, CopyOnWriteSubscribeDoesNotWaitForInvoke)
+{
+    Signal<void(), SignalLockCopyOnWrite> sig;
+
+    atomic_bool invoking = false;
+    atomic_bool release = false;
+    auto token = sig += [&]() {
+        invoking = true;
+        while (!release) {}
+    };
+
+    thread t([&sig]() { sig(); });
+    while (!invoking) {}
+    // Neither of these may wait for the invoke that is still running.
+    sig += []() {};
+    sig -= token;
+    release = true;
+    t.join();
+}
+
+TEST(Core_Signal, QueuedRunsOnDispatch)
+{
+    QueuedSignal<void(int, double)> sig(4);
+    vector<int> received;
+    sig += [&received](int value, double scale) { received.push_back(value * int(scale)); };
+
+    EXPECT_TRUE(sig.Enqueue(1, 1.0));
+    sig(2, 10.0);
+    // Nothing runs until dispatched.
+    EXPECT_TRUE(received.empty());
+    EXPECT_EQ(sig.Dispatch(), 2u);
+    EXPECT_EQ(received, (vector<int>{1, 20}));
+
+    // Beyond capacity events are dropped and counted.
+    for (int i = 0; i < 6; ++i)
+    {
+        sig(i, 1.0);
+    }
+    EXPECT_EQ(sig.GetDroppedCount(), 2u);
+    EXPECT_EQ(sig.Dispatch(), 4u);
+    EXPECT_EQ(received, (vector<int>{1, 20, 0, 1, 2, 3}));
+    EXPECT_EQ(sig.Dispatch(), 0u);
+}
+
+TEST(Core_Signal, QueuedEventsRaisedByHandlersWait)
+{
+    QueuedSignal<void(int)> sig;
+    int calls = 0;
+    sig += [&](int depth) {
+        calls++;
+        if (depth < 3)
+        {
+            sig(depth + 1);
+        }
+    };
+    sig(0);
+    EXPECT_EQ(sig.Dispatch(), 1u);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(sig.Dispatch(), 1u);
+    EXPECT_EQ(sig.Dispatch(), 1u);
+    EXPECT_EQ(sig.Dispatch(), 1u);
+    EXPECT_EQ(sig.Dispatch(), 0u);
+    EXPECT_EQ(calls, 4);
+}
+
+TEST(Core_Signal, QueuedFromManyThreads)
+{
+    QueuedSignal<void(int)> sig(4096);
+    int sum = 0;
+    sig += [&sum](int value) { sum += value; };
+
+    vector<thread> producers;
+    for (int p = 0; p < 4; ++p)
+    {
+        producers.emplace_back([&sig]() {
+            for (int i = 1; i <= 500; ++i)
+            {
+                sig(i);
+            }
+        });
+    }
+    for (thread &producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_EQ(sig.Dispatch(), 2000u);
+    EXPECT_EQ(sum, 4 * 500 * 501 / 2);
+    EXPECT_EQ(sig.GetDroppedCount(), 0u);
+}
 } // namespace Lateralus::Core::Tests
@@ -28,4 +28,26 @@ TEST(Core, StringUtils_CaseInsensitiveCompare)
     EXPECT_FALSE(CaseInsensitiveCompare(u8"ab\U0001F968\U0001F968c", u8"AB\U0001F968\U0001F968K"));
 }
 
+TEST(Core, StringUtils_SplitStringView)
+{
+    using Views = vector<string_view>;
+    EXPECT_EQ(SplitStringView("a,b,c"sv, ","sv), (Views{"a", "b", "c"}));
+    EXPECT_EQ(SplitStringView(",a,b,c"sv, ","sv), (Views{"a", "b", "c"}));
+    EXPECT_EQ(SplitStringView("a,b,c,"sv, ","sv), (Views{"a", "b", "c"}));
+    EXPECT_EQ(SplitStringView("a,,b,,c"sv, ","sv), (Views{"a", "b", "c"}));
+    EXPECT_EQ(SplitStringView(""sv, ","sv), Views{});
+    EXPECT_EQ(SplitStringView(","sv, ","sv), Views{});
+    EXPECT_EQ(SplitStringView("a b;c"sv, " ;"sv), (Views{"a", "b", "c"}));
+
+    // Long enough to cover whole vector blocks as well as the tail.
+    EXPECT_EQ(SplitStringViewNewlines("the quick brown fox\njumps over\r\n\nthe lazy dog and keeps on "
+                                      "running until the line is well past sixty four bytes\n"sv),
+              (Views{"the quick brown fox", "jumps over",
+                     "the lazy dog and keeps on running until the line is well past sixty four "
+                     "bytes"}));
+
+    EXPECT_EQ(SplitStringViewNewlines(u8"a\U0001F968\nb"sv),
+              (vector<u8string_view>{u8"a\U0001F968", u8"b"}));
+}
+
 } // namespace Lateralus::Core::Tests
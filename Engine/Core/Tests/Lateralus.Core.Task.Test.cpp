@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Jobs;
+import Lateralus.Core.Task;
+
+import <atomic>;
+import <memory>;
+import <span>;
+import <stdexcept>;
+import <string>;
+import <thread>;
+import <vector>;
+
+using namespace std;
+
+namespace Lateralus::Core::Tests
+{
+namespace
+{
+Task<int> Add(int a, int b) { co_return a + b; }
+
+Task<string> Describe(int a, int b)
+{
+    int const sum = co_await Add(a, b);
+    co_return to_string(a) + "+" + to_string(b) + "=" + to_string(sum);
+}
+
+Task<int> Fail()
+{
+    throw runtime_error("failed");
+    co_return 0;
+}
+
+// Polls a task started on this thread until it has finished, continuing anything queued for
+// this thread meanwhile.
+template <typename T> void RunUntilDone(Task<T> &task, ResumeQueue &thisThread)
+{
+    task.Start();
+    while (!task.IsDone())
+    {
+        thisThread.ResumeAll();
+        this_thread::yield();
+    }
+}
+} // namespace
+
+TEST(Core_Task, AwaitsNestedTasks)
+{
+    Task<string> task = Describe(2, 3);
+    EXPECT_FALSE(task.IsDone());
+    task.Start();
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ(task.Get(), "2+3=5");
+}
+
+TEST(Core_Task, AwaitingTemporaryGivesValue)
+{
+    auto lengths = []() -> Task<usz> {
+        // Outlives the task, whose frame is gone by the next line.
+        auto &&temporary = co_await Describe(1, 2);
+        Task<string> kept = Describe(30, 40);
+        string &fromKept = co_await kept;
+        // Move only values can be taken out of a temporary.
+        unique_ptr<string> owned = co_await []() -> Task<unique_ptr<string>> {
+            co_return make_unique<string>("owned");
+        }();
+        co_return temporary.size() + fromKept.size() + owned->size();
+    };
+    Task<usz> task = lengths();
+    task.Start();
+    ASSERT_TRUE(task.IsDone());
+    EXPECT_EQ(task.Get(), 5u + 8u + 5u);
+}
+
+TEST(Core_Task, RethrowsExceptions)
+{
+    auto catches = []() -> Task<bool> {
+        try
+        {
+            co_await Fail();
+        }
+        catch (runtime_error const &)
+        {
+            co_return true;
+        }
+        co_return false;
+    };
+    Task<bool> task = catches();
+    task.Start();
+    EXPECT_TRUE(task.Get());
+
+    Task<int> failed = Fail();
+    failed.Start();
+    EXPECT_THROW(failed.Get(), runtime_error);
+}
+
+TEST(Core_Task, MovesBetweenThreads)
+{
+    JobSystem jobs({.WorkerCount = 2});
+    ResumeQueue mainThread;
+    thread::id const mainId = this_thread::get_id();
+
+    auto hop = [&]() -> Task<int> {
+        co_await ResumeOn(jobs);
+        EXPECT_NE(this_thread::get_id(), mainId);
+        int const value = co_await Add(20, 1);
+        co_await mainThread;
+        EXPECT_EQ(this_thread::get_id(), mainId);
+        co_return value * 2;
+    };
+    Task<int> task = hop();
+    RunUntilDone(task, mainThread);
+    EXPECT_EQ(task.Get(), 42);
+}
+
+TEST(Core_Task, ResumeQueueDefersRequeued)
+{
+    ResumeQueue queue;
+    int steps = 0;
+    auto stepper = [&]() -> Task<> {
+        for (int i = 0; i < 3; ++i)
+        {
+            co_await queue;
+            steps++;
+        }
+    };
+    Task<> task = stepper();
+    task.Start();
+    EXPECT_EQ(steps, 0);
+    EXPECT_EQ(queue.ResumeAll(), 1u);
+    EXPECT_EQ(steps, 1);
+    EXPECT_EQ(queue.ResumeAll(), 1u);
+    EXPECT_EQ(queue.ResumeAll(), 1u);
+    EXPECT_TRUE(task.IsDone());
+    EXPECT_EQ(queue.ResumeAll(), 0u);
+    EXPECT_EQ(steps, 3);
+}
+
+TEST(Core_Task, WhenAllWaitsForEveryTask)
+{
+    JobSystem jobs({.WorkerCount = 3});
+    ResumeQueue mainThread;
+    atomic<int> running = 0;
+
+    auto square = [&](int value) -> Task<int> {
+        co_await ResumeOn(jobs);
+        running++;
+        this_thread::sleep_for(chrono::milliseconds(1));
+        co_return value * value;
+    };
+    auto sumOfSquares = [&]() -> Task<int> {
+        Task<int> a = square(3);
+        Task<int> b = square(4);
+        Task<int> failed = Fail();
+        co_await WhenAll(a, b, failed);
+        EXPECT_THROW(failed.Get(), runtime_error);
+
+        vector<Task<int>> more;
+        for (int i = 1; i <= 10; ++i)
+        {
+            more.push_back(square(i));
+        }
+        co_await WhenAll(span<Task<int>>(more));
+        int total = a.Get() + b.Get();
+        for (Task<int> &task : more)
+        {
+            total += task.Get();
+        }
+        co_await mainThread;
+        co_return total;
+    };
+    Task<int> task = sumOfSquares();
+    RunUntilDone(task, mainThread);
+    EXPECT_EQ(task.Get(), 9 + 16 + 385);
+    EXPECT_EQ(running, 12);
+
+    // Nothing to wait for continues right away.
+    auto none = [&]() -> Task<int> {
+        co_await WhenAll(span<Task<int>>());
+        co_return 1;
+    };
+    Task<int> empty = none();
+    empty.Start();
+    EXPECT_TRUE(empty.IsDone());
+}
+} // namespace Lateralus::Core::Tests
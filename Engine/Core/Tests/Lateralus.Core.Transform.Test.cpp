@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Matrix;
+import Lateralus.Core.Quaternion;
+import Lateralus.Core.Transform;
+import Lateralus.Core.Vector;
+
+import <thread>;
+import <vector>;
+
+namespace Lateralus::Core::Tests
+{
+namespace
+{
+// Deterministic values in [low, high).
+struct TestRandom
+{
+    uint32 state = 12345;
+    float Next(float low, float high)
+    {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * static_cast<float>(state >> 8) / 16777216.0f;
+    }
+};
+
+Matrix4x4 LocalMatrix(TransformHierarchy const &hierarchy, TransformId id)
+{
+    return Matrix4x4::CreateTranslation(hierarchy.GetLocalPosition(id)) *
+           hierarchy.GetLocalRotation(id).ToMatrix() *
+           Matrix4x4::CreateScale(hierarchy.GetLocalScale(id));
+}
+
+// The world matrix rebuilt by hand by walking up the parents.
+Matrix4x4 ExpectedWorld(TransformHierarchy const &hierarchy, TransformId id)
+{
+    Matrix4x4 world = LocalMatrix(hierarchy, id);
+    for (TransformId it = hierarchy.GetParent(id); it.IsValid(); it = hierarchy.GetParent(it))
+    {
+        world = LocalMatrix(hierarchy, it) * world;
+    }
+    return world;
+}
+
+// Products of long parent chains associate differently, so compare with an absolute tolerance.
+void ExpectNear(Matrix4x4 const &actual, Matrix4x4 const &expected)
+{
+    float const *a = &actual.r0.x;
+    float const *e = &expected.r0.x;
+    for (usz n = 0; n < 16; ++n)
+    {
+        EXPECT_NEAR(a[n], e[n], 1e-4f);
+    }
+}
+
+// Splits every level over a few threads.
+struct ThreadedParallelFor
+{
+    template <typename Function> void operator()(usz count, Function &&function) const
+    {
+        constexpr usz threadCount = 4;
+        std::vector<std::thread> threads;
+        for (usz t = 0; t < threadCount; ++t)
+        {
+            usz const begin = count * t / threadCount;
+            usz const end = count * (t + 1) / threadCount;
+            threads.emplace_back([&function, begin, end] { function(begin, end); });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+};
+} // namespace
+
+TEST(Core_Transform, CreateTRSMatchesProducts)
+{
+    Vector3 const translation(1.0f, -2.0f, 3.0f);
+    Quaternion const rotation = Quaternion::FromEuler(Vector3(10.0f, 20.0f, 30.0f));
+    Vector3 const scale(2.0f, 0.5f, 3.0f);
+    EXPECT_TRUE(CreateTRS(translation, rotation, scale)
+                    .RoughlyEquals(Matrix4x4::CreateTranslation(translation) *
+                                   rotation.ToMatrix() * Matrix4x4::CreateScale(scale)));
+}
+
+TEST(Core_Transform, WorldMatricesFollowParents)
+{
+    TransformHierarchy hierarchy;
+    TransformId const root = hierarchy.Create();
+    TransformId const child = hierarchy.Create(root);
+    TransformId const grandchild = hierarchy.Create(child);
+    hierarchy.SetLocal(root, Vector3(10.0f, 0.0f, 0.0f),
+                       Quaternion::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), 90.0f),
+                       Vector3(2.0f, 2.0f, 2.0f));
+    hierarchy.SetLocalPosition(child, Vector3(1.0f, 0.0f, 0.0f));
+    hierarchy.SetLocalPosition(grandchild, Vector3(0.0f, 1.0f, 0.0f));
+
+    EXPECT_EQ(hierarchy.Update(), 3u);
+    EXPECT_EQ(hierarchy.GetLevelCount(), 3u);
+    EXPECT_EQ(hierarchy.GetParent(grandchild), child);
+
+    // Turning +x onto -z and doubling: the child ends up 2 along -z from the root.
+    Vector4 const origin(0.0f, 0.0f, 0.0f, 1.0f);
+    EXPECT_TRUE((hierarchy.GetWorldMatrix(child) * origin)
+                    .RoughlyEquals(Vector4(10.0f, 0.0f, -2.0f, 1.0f)));
+    EXPECT_TRUE((hierarchy.GetWorldMatrix(grandchild) * origin)
+                    .RoughlyEquals(Vector4(10.0f, 2.0f, -2.0f, 1.0f)));
+}
+
+TEST(Core_Transform, OnlyDirtySubtreesUpdate)
+{
+    TransformHierarchy hierarchy;
+    TransformId const a = hierarchy.Create();
+    TransformId const b = hierarchy.Create();
+    TransformId const a1 = hierarchy.Create(a);
+    TransformId const a2 = hierarchy.Create(a1);
+    TransformId const b1 = hierarchy.Create(b);
+    EXPECT_EQ(hierarchy.Update(), 5u);
+    EXPECT_EQ(hierarchy.Update(), 0u);
+
+    hierarchy.SetLocalPosition(a1, Vector3(0.0f, 5.0f, 0.0f));
+    EXPECT_EQ(hierarchy.Update(), 2u);
+    EXPECT_TRUE(hierarchy.GetWorldMatrix(a2).RoughlyEquals(ExpectedWorld(hierarchy, a2)));
+
+    hierarchy.SetLocalScale(b, Vector3(3.0f, 3.0f, 3.0f));
+    hierarchy.SetLocalRotation(a2, Quaternion::FromEuler(Vector3(0.0f, 0.0f, 45.0f)));
+    EXPECT_EQ(hierarchy.Update(), 3u);
+    EXPECT_TRUE(hierarchy.GetWorldMatrix(b1).RoughlyEquals(ExpectedWorld(hierarchy, b1)));
+}
+
+TEST(Core_Transform, ReparentAndDestroy)
+{
+    TransformHierarchy hierarchy;
+    TransformId const a = hierarchy.Create();
+    TransformId const b = hierarchy.Create();
+    TransformId const c = hierarchy.Create(b);
+    hierarchy.SetLocalPosition(a, Vector3(1.0f, 0.0f, 0.0f));
+    hierarchy.SetLocalPosition(b, Vector3(0.0f, 1.0f, 0.0f));
+    hierarchy.SetLocalPosition(c, Vector3(0.0f, 0.0f, 1.0f));
+    hierarchy.Update();
+
+    // Moving b under a makes c depth 2, so both have to move back in the arrays.
+    hierarchy.SetParent(b, a);
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetLevelCount(), 3u);
+    EXPECT_TRUE((hierarchy.GetWorldMatrix(c) * Vector4(0.0f, 0.0f, 0.0f, 1.0f))
+                    .RoughlyEquals(Vector4(1.0f, 1.0f, 1.0f, 1.0f)));
+
+    hierarchy.Destroy(b);
+    EXPECT_FALSE(hierarchy.Contains(b));
+    EXPECT_FALSE(hierarchy.Contains(c));
+    EXPECT_TRUE(hierarchy.Contains(a));
+    EXPECT_EQ(hierarchy.GetCount(), 1u);
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.GetLevelCount(), 1u);
+
+    // Freed ids are reused.
+    TransformId const d = hierarchy.Create(a);
+    EXPECT_TRUE(d == b || d == c);
+    hierarchy.Update();
+    EXPECT_TRUE(hierarchy.GetWorldMatrix(d).RoughlyEquals(ExpectedWorld(hierarchy, d)));
+}
+
+TEST(Core_Transform, ParallelUpdateMatchesSerial)
+{
+    // A random forest: each node picks a parent among the earlier ones, or none.
+    constexpr usz nodeCount = 20000;
+    TestRandom random;
+    TransformHierarchy serial, parallel;
+    std::vector<TransformId> ids;
+    for (usz n = 0; n < nodeCount; ++n)
+    {
+        usz const pick = static_cast<usz>(random.Next(0.0f, static_cast<float>(n) + 16.0f));
+        TransformId const parent = pick < n ? ids[pick] : TransformId{};
+        TransformId const id = serial.Create(parent);
+        EXPECT_EQ(parallel.Create(parent), id);
+        ids.push_back(id);
+
+        Vector3 const position(random.Next(-1.0f, 1.0f), random.Next(-1.0f, 1.0f),
+                               random.Next(-1.0f, 1.0f));
+        Quaternion const rotation = Quaternion::FromEuler(
+            Vector3(random.Next(-20.0f, 20.0f), random.Next(-20.0f, 20.0f), 0.0f));
+        Vector3 const scale(1.0f, 1.0f, 1.0f);
+        serial.SetLocal(id, position, rotation, scale);
+        parallel.SetLocal(id, position, rotation, scale);
+    }
+    EXPECT_EQ(serial.Update(), nodeCount);
+    EXPECT_EQ(parallel.Update(ThreadedParallelFor{}), nodeCount);
+    EXPECT_GT(serial.GetLevelCount(), 4u);
+
+    for (usz n = 0; n < nodeCount; n += 97)
+    {
+        serial.SetLocalPosition(ids[n], Vector3(0.0f, 1.0f, 0.0f));
+        parallel.SetLocalPosition(ids[n], Vector3(0.0f, 1.0f, 0.0f));
+    }
+    EXPECT_EQ(parallel.Update(ThreadedParallelFor{}), serial.Update());
+
+    for (TransformId id : ids)
+    {
+        Matrix4x4 const &expected = serial.GetWorldMatrix(id);
+        Matrix4x4 const &actual = parallel.GetWorldMatrix(id);
+        EXPECT_TRUE(expected.r0.ExactlyEquals(actual.r0) && expected.r1.ExactlyEquals(actual.r1) &&
+                    expected.r2.ExactlyEquals(actual.r2) && expected.r3.ExactlyEquals(actual.r3));
+    }
+    for (usz n = 0; n < nodeCount; n += 501)
+    {
+        ExpectNear(serial.GetWorldMatrix(ids[n]), ExpectedWorld(serial, ids[n]));
+    }
+}
+} // namespace Lateralus::Core::Tests
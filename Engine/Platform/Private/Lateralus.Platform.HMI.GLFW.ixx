@@ -69,8 +69,8 @@ private:
             KeyAction const keyAction = static_cast<KeyAction>(action);
             KeyModifier const keyModifier = static_cast<KeyModifier>(mods);
 
-            auto self = reinterpret_cast<InputProvider const *>(glfwGetWindowUserPointer(window));
-            self->m_KeyActionCallback(keyCode, keyAction, keyModifier);
+            auto self = reinterpret_cast<InputProvider *>(glfwGetWindowUserPointer(window));
+            self->QueueEvent(KeyActionEvent{keyCode, keyAction, keyModifier});
         });
 
         glfwSetCharCallback(m_Window, [](GLFWwindow *window, unsigned int codepoint) {
@@ -83,8 +83,8 @@ private:
 
             ReEncode<Encoding::UTF32, Encoding::UTF8>(sourceBytes, destBytes, sourceSize);
 
-            auto self = reinterpret_cast<InputProvider const *>(glfwGetWindowUserPointer(window));
-            self->m_TextCallback(u8string_view(utf8Str, destSize));
+            auto self = reinterpret_cast<InputProvider *>(glfwGetWindowUserPointer(window));
+            self->QueueEvent(TextEvent(u8string_view(utf8Str, destSize)));
         });
 
         glfwSetMouseButtonCallback(m_Window, [](GLFWwindow *window, int button, int action,
@@ -93,13 +93,13 @@ private:
             MouseButtonAction const mouseAction = static_cast<MouseButtonAction>(action);
             KeyModifier const keyMods = static_cast<KeyModifier>(action);
 
-            auto self = reinterpret_cast<InputProvider const *>(glfwGetWindowUserPointer(window));
-            self->m_MouseButtonCallback(mouseButton, mouseAction, keyMods);
+            auto self = reinterpret_cast<InputProvider *>(glfwGetWindowUserPointer(window));
+            self->QueueEvent(MouseButtonEvent{mouseButton, mouseAction, keyMods});
         });
 
         glfwSetScrollCallback(m_Window, [](GLFWwindow *window, double x, double y) {
-            auto self = reinterpret_cast<InputProvider const *>(glfwGetWindowUserPointer(window));
-            self->m_ScrollWheelCallback(x, y);
+            auto self = reinterpret_cast<InputProvider *>(glfwGetWindowUserPointer(window));
+            self->QueueEvent(ScrollWheelEvent{x, y});
         });
         return Success;
     }
@@ -56,6 +56,7 @@ SOFTWARE.
 #endif
 
 #include "imgui.h"
+#include <Core.Profile.h>
 #include <GL/glew.h> // Needs to be initialized with glewInit() in user's code
 #include <stdint.h>  // intptr_t
 #include <stdio.h>
@@ -66,6 +67,7 @@ export module Lateralus.Platform.ImGui.OpenGL;
 
 #if ENABLE_IMGUI
 
+import Lateralus.Core.Profile;
 import Lateralus.Platform.ImGui.Impl;
 import Lateralus.Platform.Error;
 
@@ -305,6 +307,7 @@ private:
     // order to be able to run within any OpenGL engine that doesn't do so.
     void RenderDrawData(ImDrawData *draw_data)
     {
+        LAT_PROFILE_ZONE("ImGui::RenderDrawData");
         // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates
         // != framebuffer coordinates)
         int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
@@ -8,10 +8,66 @@ export module Lateralus.Platform.ImGuiWidget.Core;
 #if PLATFORM_IS_AMD64 || PLATFORM_IS_X86
 import Lateralus.Core.CPUID;
 #endif
+import Lateralus.Core;
+import Lateralus.Core.Dispatch;
+import Lateralus.Core.Profile;
 import Lateralus.Core.SIMDSupport;
+import Lateralus.Platform.PerfCounters;
 
 namespace Lateralus::Platform::ImGuiWidget
 {
+namespace
+{
+// The main thread's hardware counters over the last frame, with misses per thousand
+// instructions so frames doing different amounts of work compare.
+void DrawHardwareCounters()
+{
+    namespace Profile = ::Lateralus::Core::Profile;
+    if (!PerfCounters::IsEnabled())
+    {
+        ::ImGui::TextUnformatted("Hardware counters off");
+        return;
+    }
+    if (!PerfCounters::GetLastFrame().has_value())
+    {
+        return;
+    }
+    Profile::HardwareCounters const &frame = PerfCounters::GetLastFrame().value();
+    auto const instructions =
+        static_cast<double>(frame[static_cast<Core::usz>(Profile::HardwareCounter::Instructions)]);
+    auto const cycles =
+        static_cast<double>(frame[static_cast<Core::usz>(Profile::HardwareCounter::Cycles)]);
+
+    if (::ImGui::BeginTable("HardwareCounters", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ::ImGui::TableSetupColumn("Last frame");
+        ::ImGui::TableSetupColumn("Count");
+        ::ImGui::TableSetupColumn("Per 1K instructions");
+        ::ImGui::TableHeadersRow();
+        for (Core::usz i = 0; i < Profile::k_HardwareCounterCount; ++i)
+        {
+            auto const counter = static_cast<Profile::HardwareCounter>(i);
+            ::ImGui::TableNextRow();
+            ::ImGui::TableNextColumn();
+            ::ImGui::TextUnformatted(Profile::HardwareCounterName(counter));
+            ::ImGui::TableNextColumn();
+            if (!PerfCounters::IsOpen(counter))
+            {
+                ::ImGui::TextUnformatted("n/a");
+                continue;
+            }
+            ::ImGui::Text("%llu", static_cast<unsigned long long>(frame[i]));
+            ::ImGui::TableNextColumn();
+            if (instructions > 0.0)
+            {
+                ::ImGui::Text("%.2f", static_cast<double>(frame[i]) * 1000.0 / instructions);
+            }
+        }
+        ::ImGui::EndTable();
+    }
+    ::ImGui::LabelText("IPC", "%.2f", cycles > 0.0 ? instructions / cycles : 0.0);
+}
+} // namespace
 
 export void Core()
 {
@@ -22,8 +78,11 @@ export void Core()
     ::ImGui::LabelText("CPU", "%s", cpuid.ProcessorBrand.data());
     ::ImGui::LabelText("Code SSE", "%s", ::Lateralus::Core::SSEVersionName);
     ::ImGui::LabelText("CPU SSE", "%s", Core::SSEGetName(cpuid.GetSSEVersion()));
+    ::ImGui::LabelText("Dispatch", "%s", Core::SSEGetName(Core::GetDispatchVersion()));
 #endif;
 
+    DrawHardwareCounters();
+
     ::ImGui::End();
 }
 
@@ -0,0 +1,60 @@
+module;
+#if ENABLE_IMGUI
+#include <imgui.h>
+#endif
+export module Lateralus.Platform.ImGuiWidget.Memory;
+#if ENABLE_IMGUI
+
+import <string>;
+
+import Lateralus.Core;
+import Lateralus.Core.ByteConversion;
+import Lateralus.Core.Memory;
+
+namespace Lateralus::Platform::ImGuiWidget
+{
+
+export void Memory()
+{
+    ::ImGui::Begin("Lateralus Memory");
+
+    if (::ImGui::BeginTable("Tags", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ::ImGui::TableSetupColumn("Tag");
+        ::ImGui::TableSetupColumn("Current");
+        ::ImGui::TableSetupColumn("Peak");
+        ::ImGui::TableSetupColumn("Live");
+        ::ImGui::TableSetupColumn("Allocations");
+        ::ImGui::TableHeadersRow();
+
+        for (Core::usz index = 0; index < Core::k_MemoryTagCount; ++index)
+        {
+            auto const tag = static_cast<Core::MemoryTag>(index);
+            Core::MemoryTagStats const stats = Core::GetMemoryTagStats(tag);
+            ::ImGui::TableNextRow();
+            ::ImGui::TableNextColumn();
+            ::ImGui::TextUnformatted(Core::MemoryTagName(tag));
+            ::ImGui::TableNextColumn();
+            ::ImGui::TextUnformatted(Core::Bytes_to_String(stats.CurrentBytes).c_str());
+            ::ImGui::TableNextColumn();
+            ::ImGui::TextUnformatted(Core::Bytes_to_String(stats.PeakBytes).c_str());
+            ::ImGui::TableNextColumn();
+            ::ImGui::Text("%llu", static_cast<unsigned long long>(stats.LiveCount));
+            ::ImGui::TableNextColumn();
+            ::ImGui::Text("%llu", static_cast<unsigned long long>(stats.AllocationCount));
+        }
+        ::ImGui::EndTable();
+    }
+
+    ::ImGui::LabelText("Pool slabs", "%s",
+                       Core::Bytes_to_String(Core::GetPoolReservedBytes()).c_str());
+    Core::FrameArena &frameArena = Core::GetFrameArena();
+    ::ImGui::LabelText("Frame arena", "%s / %s",
+                       Core::Bytes_to_String(frameArena.GetPrevious().GetUsed()).c_str(),
+                       Core::Bytes_to_String(frameArena.GetPrevious().GetCapacity()).c_str());
+
+    ::ImGui::End();
+}
+
+} // namespace Lateralus::Platform::ImGuiWidget
+#endif
@@ -0,0 +1,348 @@
+module;
+#if ENABLE_IMGUI
+#include <imgui.h>
+#endif
+export module Lateralus.Platform.ImGuiWidget.Profiler;
+#if ENABLE_IMGUI
+
+import <algorithm>;
+import <string>;
+import <vector>;
+
+import Lateralus.Core;
+import Lateralus.Core.Profile;
+import Lateralus.Platform.ProfileCapture;
+
+namespace Lateralus::Platform::ImGuiWidget
+{
+namespace
+{
+namespace Profile = Core::Profile;
+
+struct ProfilerState
+{
+    // While paused the widget keeps showing the frames it had, so they can be looked through.
+    bool Paused = false;
+    // How many frames the timeline shows, ending at SelectedFrame.
+    int FramesShown = 3;
+    float BudgetMilliseconds = 1000.0f / 60.0f;
+    float Zoom = 1.0f;
+    // Index of the last frame in the timeline, or -1 for the newest finished one.
+    int SelectedFrame = -1;
+    std::vector<Core::uint64> Frames;
+    std::vector<Profile::ThreadCapture> Threads;
+    // Whether Threads has every zone kept rather than just the frames shown, as it does while
+    // paused so other frames can be chosen.
+    bool AllThreads = false;
+};
+
+ProfilerState &GetState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+constexpr float k_FrameGraphHeight = 80.0f;
+constexpr float k_HistogramHeight = 50.0f;
+constexpr Core::usz k_HistogramBuckets = 40;
+
+// Hashed from the site so a zone keeps its colour from frame to frame.
+ImU32 GetZoneColour(Profile::ZoneSite const *site)
+{
+    auto const hash = static_cast<Core::uint32>(reinterpret_cast<Core::usz>(site) >> 4) *
+                      2654435761u;
+    float const hue = static_cast<float>(hash >> 8) / static_cast<float>(1u << 24);
+    float r, g, b;
+    ::ImGui::ColorConvertHSVtoRGB(hue, 0.45f, 0.8f, r, g, b);
+    return ::ImGui::GetColorU32(ImVec4(r, g, b, 1.0f));
+}
+
+double GetFrameMilliseconds(ProfilerState const &state, Core::usz frame)
+{
+    return Profile::TicksToMilliseconds(state.Frames[frame + 1] - state.Frames[frame]);
+}
+
+// One bar per frame kept, red when over budget. Clicking a bar pauses on that frame.
+void DrawFrameGraph(ProfilerState &state, Core::usz frameCount, Core::usz firstShown,
+                    Core::usz lastShown)
+{
+    ImVec2 const origin = ::ImGui::GetCursorScreenPos();
+    ImVec2 const size(std::max(::ImGui::GetContentRegionAvail().x, 1.0f), k_FrameGraphHeight);
+    ::ImGui::InvisibleButton("##Frames", size);
+    bool const hovered = ::ImGui::IsItemHovered();
+
+    ImDrawList *draw = ::ImGui::GetWindowDrawList();
+    draw->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y),
+                        ::ImGui::GetColorU32(ImGuiCol_FrameBg));
+    if (frameCount == 0)
+    {
+        return;
+    }
+
+    double longest = 2.0 * state.BudgetMilliseconds;
+    for (Core::usz frame = 0; frame < frameCount; ++frame)
+    {
+        longest = std::max(longest, GetFrameMilliseconds(state, frame));
+    }
+
+    float const barWidth = size.x / static_cast<float>(frameCount);
+    ImU32 const overBudget = ::ImGui::GetColorU32(ImVec4(0.9f, 0.3f, 0.3f, 1.0f));
+    ImU32 const underBudget = ::ImGui::GetColorU32(ImVec4(0.4f, 0.75f, 0.4f, 1.0f));
+    draw->AddRectFilled(ImVec2(origin.x + firstShown * barWidth, origin.y),
+                        ImVec2(origin.x + (lastShown + 1) * barWidth, origin.y + size.y),
+                        ::ImGui::GetColorU32(ImGuiCol_FrameBgActive));
+    for (Core::usz frame = 0; frame < frameCount; ++frame)
+    {
+        double const milliseconds = GetFrameMilliseconds(state, frame);
+        float const height = static_cast<float>(milliseconds / longest) * size.y;
+        float const x = origin.x + frame * barWidth;
+        draw->AddRectFilled(ImVec2(x, origin.y + size.y - height),
+                            ImVec2(x + std::max(barWidth - 1.0f, 1.0f), origin.y + size.y),
+                            milliseconds > state.BudgetMilliseconds ? overBudget : underBudget);
+    }
+    float const budgetY =
+        origin.y + size.y - static_cast<float>(state.BudgetMilliseconds / longest) * size.y;
+    draw->AddLine(ImVec2(origin.x, budgetY), ImVec2(origin.x + size.x, budgetY),
+                  ::ImGui::GetColorU32(ImGuiCol_Text));
+
+    if (hovered)
+    {
+        auto const frame = std::min(
+            static_cast<Core::usz>(std::max(::ImGui::GetMousePos().x - origin.x, 0.0f) / barWidth),
+            frameCount - 1);
+        ::ImGui::SetTooltip("Frame %d: %.2f ms", static_cast<int>(frame),
+                            GetFrameMilliseconds(state, frame));
+        if (::ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+        {
+            state.SelectedFrame = static_cast<int>(frame);
+            state.Paused = true;
+        }
+    }
+}
+
+// How the frame times kept are spread, in buckets a tenth of the budget wide.
+void DrawHistogram(ProfilerState const &state)
+{
+    double const bucketMilliseconds = state.BudgetMilliseconds / 10.0;
+    std::vector<Core::uint32> const buckets =
+        Profile::HistogramFrameTimes(state.Frames, bucketMilliseconds, k_HistogramBuckets);
+    std::vector<float> values(buckets.begin(), buckets.end());
+    std::string const overlay =
+        "0 - " + std::to_string(static_cast<int>(bucketMilliseconds * k_HistogramBuckets)) +
+        "+ ms";
+    ::ImGui::PlotHistogram("##Histogram", values.data(), static_cast<int>(values.size()), 0,
+                           overlay.c_str(), 0.0f, FLT_MAX,
+                           ImVec2(::ImGui::GetContentRegionAvail().x, k_HistogramHeight));
+}
+
+void DrawZoneTooltip(Profile::ZoneRecord const &zone)
+{
+    ::ImGui::BeginTooltip();
+    ::ImGui::Text("%s\n%.3f ms\n%s:%u", zone.Site->Name,
+                  Profile::TicksToMilliseconds(zone.End - zone.Begin), zone.Site->File,
+                  zone.Site->Line);
+    if (zone.HasCounters)
+    {
+        for (Core::usz i = 0; i < Profile::k_HardwareCounterCount; ++i)
+        {
+            ::ImGui::Text("%s: %llu",
+                          Profile::HardwareCounterName(static_cast<Profile::HardwareCounter>(i)),
+                          static_cast<unsigned long long>(zone.Counters[i]));
+        }
+        auto const cycles = zone.Counters[static_cast<Core::usz>(Profile::HardwareCounter::Cycles)];
+        auto const instructions =
+            zone.Counters[static_cast<Core::usz>(Profile::HardwareCounter::Instructions)];
+        ::ImGui::Text("IPC: %.2f", cycles == 0 ? 0.0
+                                               : static_cast<double>(instructions) /
+                                                     static_cast<double>(cycles));
+    }
+    ::ImGui::EndTooltip();
+}
+
+// Each thread's zones from begin to end, nested zones drawn below the ones around them.
+void DrawTimeline(ProfilerState const &state, Core::usz firstShown, Core::usz lastShown)
+{
+    Core::uint64 const begin = state.Frames[firstShown];
+    Core::uint64 const end = state.Frames[lastShown + 1];
+    float const rowHeight = ::ImGui::GetTextLineHeightWithSpacing();
+    float const width = ::ImGui::GetContentRegionAvail().x * state.Zoom;
+    ImVec2 const origin = ::ImGui::GetCursorScreenPos();
+    ImDrawList *draw = ::ImGui::GetWindowDrawList();
+    ImVec2 const mouse = ::ImGui::GetMousePos();
+    bool const hovered = ::ImGui::IsWindowHovered();
+    double const ticksPerPixel = static_cast<double>(end - begin) / width;
+    auto const toX = [&](Core::uint64 ticks) {
+        ticks = std::clamp(ticks, begin, end);
+        return origin.x + static_cast<float>(static_cast<double>(ticks - begin) / ticksPerPixel);
+    };
+
+    float y = origin.y;
+    for (Profile::ThreadCapture const &thread : state.Threads)
+    {
+        Core::uint32 depth = 0;
+        bool any = false;
+        for (Profile::ZoneRecord const &zone : thread.Zones)
+        {
+            if (zone.End >= begin && zone.Begin <= end)
+            {
+                depth = std::max(depth, zone.Depth);
+                any = true;
+            }
+        }
+        if (!any)
+        {
+            continue;
+        }
+
+        std::string const name =
+            thread.Name.empty() ? "Thread " + std::to_string(thread.Index) : thread.Name;
+        draw->AddText(ImVec2(origin.x, y), ::ImGui::GetColorU32(ImGuiCol_Text), name.c_str());
+        y += rowHeight;
+
+        for (Profile::ZoneRecord const &zone : thread.Zones)
+        {
+            if (zone.End < begin || zone.Begin > end)
+            {
+                continue;
+            }
+            ImVec2 const topLeft(toX(zone.Begin), y + zone.Depth * rowHeight);
+            ImVec2 const bottomRight(std::max(toX(zone.End), topLeft.x + 1.0f),
+                                     topLeft.y + rowHeight - 1.0f);
+            draw->AddRectFilled(topLeft, bottomRight, GetZoneColour(zone.Site));
+            if (bottomRight.x - topLeft.x > ::ImGui::CalcTextSize(zone.Site->Name).x)
+            {
+                ImVec4 const clip(topLeft.x, topLeft.y, bottomRight.x, bottomRight.y);
+                draw->AddText(nullptr, 0.0f, ImVec2(topLeft.x + 2.0f, topLeft.y),
+                              ::ImGui::GetColorU32(ImVec4(0.0f, 0.0f, 0.0f, 1.0f)),
+                              zone.Site->Name, nullptr, 0.0f, &clip);
+            }
+            if (hovered && mouse.x >= topLeft.x && mouse.x < bottomRight.x &&
+                mouse.y >= topLeft.y && mouse.y < bottomRight.y)
+            {
+                DrawZoneTooltip(zone);
+            }
+        }
+        y += (depth + 1) * rowHeight;
+    }
+
+    ImU32 const frameLine = ::ImGui::GetColorU32(ImGuiCol_Separator);
+    for (Core::usz frame = firstShown; frame <= lastShown + 1; ++frame)
+    {
+        float const x = toX(state.Frames[frame]);
+        draw->AddLine(ImVec2(x, origin.y), ImVec2(x, y), frameLine);
+    }
+
+    // Gives the child window the timeline's size, so it scrolls when zoomed in.
+    ::ImGui::Dummy(ImVec2(width, y - origin.y));
+}
+} // namespace
+
+/// <summary>
+/// The profiler's last frames as a graph of frame times, a histogram of them, and a timeline of
+/// each thread's zones in the frames chosen. Click a frame in the graph, or tick Pause, to stop
+/// updating and look through what was captured.
+/// </summary>
+export void Profiler()
+{
+    ProfilerState &state = GetState();
+    ::ImGui::Begin("Lateralus Profiler");
+
+    if (::ImGui::Checkbox("Pause", &state.Paused) && !state.Paused)
+    {
+        state.SelectedFrame = -1;
+    }
+    ::ImGui::SameLine();
+    ::ImGui::SetNextItemWidth(100.0f);
+    ::ImGui::SliderInt("Frames", &state.FramesShown, 1, 16);
+    ::ImGui::SameLine();
+    ::ImGui::SetNextItemWidth(100.0f);
+    ::ImGui::SliderFloat("Budget (ms)", &state.BudgetMilliseconds, 1.0f, 100.0f, "%.1f");
+    ::ImGui::SameLine();
+    ::ImGui::SetNextItemWidth(100.0f);
+    ::ImGui::SliderFloat("Zoom", &state.Zoom, 1.0f, 100.0f, "%.0fx",
+                         ImGuiSliderFlags_Logarithmic);
+    ::ImGui::SameLine();
+    if (::ImGui::Button(ProfileCapture::IsCapturing() ? "Stop capture" : "Capture to file"))
+    {
+        ProfileCapture::Toggle();
+    }
+    ::ImGui::SameLine();
+    // Off until asked for, so ordinary stalls don't leave trace files in the temp directory.
+    if (bool saveHitches = ProfileCapture::IsHitchCaptureEnabled();
+        ::ImGui::Checkbox("Save hitches", &saveHitches))
+    {
+        if (saveHitches)
+        {
+            ProfileCapture::EnableHitchCapture({});
+        }
+        else
+        {
+            ProfileCapture::DisableHitchCapture();
+        }
+    }
+    if (ProfileCapture::IsHitchCaptureEnabled())
+    {
+        ::ImGui::SameLine();
+        ::ImGui::Text("%llu hitches",
+                      static_cast<unsigned long long>(ProfileCapture::GetHitchCount()));
+    }
+
+    bool const update = !state.Paused || state.Frames.empty();
+    if (update)
+    {
+        state.Frames = Profile::CaptureFrames();
+    }
+
+    // A frame lasts from its start to the next, so the newest start has no frame yet.
+    Core::usz const frameCount = state.Frames.size() < 2 ? 0 : state.Frames.size() - 1;
+    if (frameCount == 0)
+    {
+        ::ImGui::TextUnformatted("No frames yet.");
+        ::ImGui::End();
+        return;
+    }
+    Core::usz const lastShown = state.SelectedFrame < 0
+                                    ? frameCount - 1
+                                    : std::min<Core::usz>(state.SelectedFrame, frameCount - 1);
+    auto const framesShown = static_cast<Core::usz>(state.FramesShown);
+    Core::usz const firstShown = lastShown + 1 > framesShown ? lastShown + 1 - framesShown : 0;
+
+    // Each thread keeps far more zones than a few frames have, so only those shown are copied
+    // until pausing, which takes everything once.
+    if (update)
+    {
+        state.Threads = Profile::CaptureZones(state.Frames[firstShown]);
+        state.AllThreads = false;
+    }
+    else if (!state.AllThreads)
+    {
+        state.Threads = Profile::CaptureZones();
+        state.AllThreads = true;
+    }
+
+    double total = 0.0;
+    double worst = 0.0;
+    for (Core::usz frame = 0; frame < frameCount; ++frame)
+    {
+        double const milliseconds = GetFrameMilliseconds(state, frame);
+        total += milliseconds;
+        worst = std::max(worst, milliseconds);
+    }
+    ::ImGui::Text("%d frames: %.2f ms average, %.2f ms worst. Showing %.2f ms.",
+                  static_cast<int>(frameCount), total / frameCount, worst,
+                  Profile::TicksToMilliseconds(state.Frames[lastShown + 1] -
+                                               state.Frames[firstShown]));
+
+    DrawFrameGraph(state, frameCount, firstShown, lastShown);
+    DrawHistogram(state);
+
+    ::ImGui::BeginChild("Timeline", ImVec2(0.0f, 0.0f), true,
+                        ImGuiWindowFlags_HorizontalScrollbar);
+    DrawTimeline(state, firstShown, lastShown);
+    ::ImGui::EndChild();
+
+    ::ImGui::End();
+}
+
+} // namespace Lateralus::Platform::ImGuiWidget
+#endif
@@ -1,10 +1,12 @@
 module;
 
 #if ENABLE_IMGUI
+#include "freetype/imgui_freetype.h"
 #include <imgui.h>
 #endif
 
 #include <Core.Log.h>
+#include <Core.Profile.h>
 #include <Core.h>
 
 #if ENABLE_GLFW
@@ -25,9 +27,13 @@ import Lateralus.Platform.ImGui.GLFW;
 import Lateralus.Platform.ImGui.OpenGL;
 import Lateralus.Platform.ImGui.Theme;
 #endif
+import Lateralus.Platform.PerfCounters;
 import Lateralus.Platform.Platform;
+import Lateralus.Platform.ProfileCapture;
 import Lateralus.Platform.Window;
 import Lateralus.Core;
+import Lateralus.Core.Memory;
+import Lateralus.Core.Profile;
 
 import <atomic>;
 import <format>;
@@ -52,6 +58,14 @@ namespace
 {
 constexpr uint32 k_OpenGLVersionMajor = 3;
 constexpr uint32 k_OpenGLVersionMinor = 2;
+
+#if ENABLE_IMGUI
+// Dear ImGui and FreeType allocate through these, so their memory shows under their tags.
+void *ImGuiAlloc(size_t bytes, void *) { return TaggedMalloc(MemoryTag::ImGui, bytes); }
+void ImGuiFree(void *pointer, void *) { TaggedMallocFree(MemoryTag::ImGui, pointer); }
+void *FreeTypeAlloc(size_t bytes, void *) { return TaggedMalloc(MemoryTag::FreeType, bytes); }
+void FreeTypeFree(void *pointer, void *) { TaggedMallocFree(MemoryTag::FreeType, pointer); }
+#endif
 } // namespace
 
 export class Window : public iWindow
@@ -100,7 +114,8 @@ public:
         }
 
         {
-            shared_ptr<InputProvider> inputProvider = make_shared<InputProvider>();
+            shared_ptr<InputProvider> inputProvider =
+                MakeTaggedShared<InputProvider>(MemoryTag::Platform);
             if (auto err = inputProvider->Init(m_Window); err.has_value())
             {
                 return err;
@@ -108,6 +123,14 @@ public:
             m_Input = move(inputProvider);
         }
 
+        m_ProfileCaptureToken = m_Input->GetKeyActionCallback() +=
+            [](KeyCode code, KeyAction action, KeyModifier) {
+                if (code == ProfileCapture::k_ToggleKey && action == KeyAction::Press)
+                {
+                    ProfileCapture::Toggle();
+                }
+            };
+
 #if ENABLE_IMGUI
         // do/while to break after logging an error.
         // We log an error here instead of returning an error because imgui failing is recoverable.
@@ -120,6 +143,8 @@ public:
                 break;
             }
 
+            ImGui::SetAllocatorFunctions(ImGuiAlloc, ImGuiFree);
+            ImGuiFreeType::SetAllocatorFunctions(FreeTypeAlloc, FreeTypeFree);
             m_ImGuiContext = ImGui::CreateContext();
             if (m_ImGuiContext == nullptr)
             {
@@ -131,7 +156,7 @@ public:
 
             shared_ptr<ImplGLFW> implGlfw;
             {
-                implGlfw = make_shared<ImplGLFW>();
+                implGlfw = MakeTaggedShared<ImplGLFW>(MemoryTag::ImGui);
                 if (auto err = implGlfw->Init(m_Window, m_Input); err.has_value())
                 {
                     LOG_ERROR("Could not init imgui: implGlfw->Init() {}", err.value().GetErrorMessage());
@@ -141,7 +166,7 @@ public:
             }
 
             {
-                shared_ptr<ImplOpenGL> implOpenGL = make_shared<ImplOpenGL>();
+                shared_ptr<ImplOpenGL> implOpenGL = MakeTaggedShared<ImplOpenGL>(MemoryTag::ImGui);
                 constexpr auto k_GlslVersion = "#version 150";
                 if (auto err = implOpenGL->Init(k_GlslVersion); err.has_value())
                 {
@@ -165,7 +190,17 @@ public:
     bool ShouldClose() const override { return glfwWindowShouldClose(m_Window); }
 
     // iWindow
-    void PollEvents() override { glfwPollEvents(); }
+    void PollEvents() override
+    {
+        LAT_PROFILE_ZONE("Window::PollEvents");
+        glfwPollEvents();
+        // Input handlers run here, in one batch, rather than inside the glfw callbacks.
+        if (m_Input != nullptr)
+        {
+            m_Input->DispatchEvents();
+        }
+        m_AfterPollEvents.ResumeAll();
+    }
 
     // iWindow
     void Clear() override
@@ -177,6 +212,13 @@ public:
     // iWindow
     void NewFrame() override
     {
+#if !CONF_RETAIL
+        Core::Profile::MarkFrame();
+        PerfCounters::NewFrame();
+        ProfileCapture::Update();
+#endif
+        LAT_PROFILE_ZONE("Window::NewFrame");
+        Core::GetFrameArena().NewFrame();
 #if ENABLE_IMGUI
         // feed inputs to dear imgui, start new frame
         for (auto const &impl : m_Impls)
@@ -190,6 +232,7 @@ public:
     // iWindow
     void Render() override
     {
+        LAT_PROFILE_ZONE("Window::Render");
 #if ENABLE_IMGUI
         ::ImGui::EndFrame();
         ::ImGui::Render();
@@ -203,11 +246,15 @@ public:
     // iWindow
     void SwapBuffers() override
     {
+        LAT_PROFILE_ZONE("Window::SwapBuffers");
         int32 screenWidth, screenHeight;
         glfwGetFramebufferSize(m_Window, &screenWidth, &screenHeight);
         glViewport(0, 0, static_cast<int>(screenWidth), static_cast<int>(screenHeight));
 
         glfwSwapBuffers(m_Window);
+#if !CONF_RETAIL
+        ProfileCapture::EndFrame();
+#endif
     }
 
 private:
@@ -275,6 +322,12 @@ private:
 #endif
         if (m_Input != nullptr)
         {
+            m_Input->GetKeyActionCallback() -= m_ProfileCaptureToken;
+            // A capture still running when its window goes would never be finished.
+            if (ProfileCapture::IsCapturing())
+            {
+                ProfileCapture::Toggle();
+            }
             m_Input->Shutdown();
             m_Input.reset();
         }
@@ -284,6 +337,7 @@ private:
 
     GLFWwindow *m_Window = nullptr;
     shared_ptr<iInputProvider> m_Input;
+    KeyActionCallback::Token m_ProfileCaptureToken;
 
 #if ENABLE_IMGUI
     ImGuiContext *m_ImGuiContext = nullptr;
@@ -1,6 +1,10 @@
 export module Lateralus.Platform.Window.Null;
 
+import Lateralus.Core.Memory;
+import Lateralus.Core.Profile;
 import Lateralus.Platform.Error;
+import Lateralus.Platform.PerfCounters;
+import Lateralus.Platform.ProfileCapture;
 import Lateralus.Platform.Window;
 import <optional>;
 
@@ -17,14 +21,27 @@ export class Window : public iWindow
 
     bool ShouldClose() const override { return true; };
 
-    void PollEvents() override {}
+    void PollEvents() override { m_AfterPollEvents.ResumeAll(); }
 
     void Clear() override {}
 
-    void NewFrame() override {}
+    void NewFrame() override
+    {
+#if !CONF_RETAIL
+        Core::Profile::MarkFrame();
+        PerfCounters::NewFrame();
+        ProfileCapture::Update();
+#endif
+        Core::GetFrameArena().NewFrame();
+    }
 
     void Render() override {}
 
-    void SwapBuffers() override {}
+    void SwapBuffers() override
+    {
+#if !CONF_RETAIL
+        ProfileCapture::EndFrame();
+#endif
+    }
 };
 } // namespace Lateralus::Platform::Null
@@ -16,10 +16,15 @@ export module Lateralus.Platform.FS;
 import <filesystem>;
 import <format>;
 import <fstream>;
+import <coroutine>;
 import <istream>;
+import <memory_resource>;
 import <optional>;
+import <vector>;
 
 import Lateralus.Core;
+import Lateralus.Core.Jobs;
+import Lateralus.Core.Memory;
 import Lateralus.Core.StringUtils;
 import Lateralus.Core.EncodingConversion;
 import Lateralus.Platform.Error;
@@ -48,7 +53,7 @@ export enum class Location {
     Temp
 };
 
-optional<Error> GetLocationPath(Location location, fs::path &pathOut)
+export optional<Error> GetLocationPath(Location location, fs::path &pathOut)
 {
     switch (location)
     {
@@ -101,10 +106,11 @@ constexpr char8_t k_SpecialPathTag_Temp[] = u8"{temp}";
 
 optional<Error> ResolveSpecialPath(u8string_view specialPath, fs::path &pathOut)
 {
-    auto split = SplitStringView(specialPath, u8"/\\"sv);
+    // Both only live for the call, so they come from the frame arena rather than the heap.
+    auto split = SplitStringView(specialPath, u8"/\\"sv, GetFrameAllocator<u8string_view>());
     // a container to hold temp strings for the lifetime of the func
     // this allows us to simply replace the special string views inside of split
-    vector<u8string> specialPathParts;
+    pmr::vector<pmr::u8string> specialPathParts(GetFrameAllocator());
     specialPathParts.reserve(split.size());
 
     constexpr struct
@@ -133,14 +139,14 @@ optional<Error> ResolveSpecialPath(u8string_view specialPath, fs::path &pathOut)
                     {
                         return err;
                     }
-                    specialPathParts.push_back(locPath.u8string());
+                    specialPathParts.emplace_back(u8string_view(locPath.u8string()));
                     break;
                 }
             }
 
             if (!isStartingTag)
             {
-                specialPathParts.push_back(u8string(part));
+                specialPathParts.emplace_back(part);
             }
         }
         else
@@ -154,7 +160,7 @@ optional<Error> ResolveSpecialPath(u8string_view specialPath, fs::path &pathOut)
                                 string_cast<string>(k_SpecialPathTag_App)));
                 }
             }
-            specialPathParts.push_back(u8string(part));
+            specialPathParts.emplace_back(part);
         }
 
         // pathOut += fs::path(u8string_to_string(part));
@@ -185,6 +191,59 @@ optional<Error> ResolveSpecialPath(u8string_view specialPath, fs::path &pathOut)
     //   return fs::path(specialPath);
     return Success;
 }
+
+/// <summary>
+/// Reads the whole file at path into bytesOut, replacing what it held.
+/// </summary>
+export optional<Error> ReadFile(fs::path const &path, vector<uint8> &bytesOut)
+{
+    ifstream stream(path, ios_base::in | ios_base::binary | ios_base::ate);
+    if (!stream.is_open())
+    {
+        return Error(format("Couldn't open \"{}\" for reading.", path.string()));
+    }
+    streamoff const length = stream.tellg();
+    if (length < 0)
+    {
+        return Error(format("Couldn't get the size of \"{}\".", path.string()));
+    }
+    bytesOut.resize(static_cast<usz>(length));
+    stream.seekg(0, ios_base::beg);
+    if (!stream.read(reinterpret_cast<char *>(bytesOut.data()), length))
+    {
+        return Error(format("Couldn't read \"{}\".", path.string()));
+    }
+    return Success;
+}
+
+/// <summary>
+/// co_await ReadFileAsync(jobs, path, bytesOut) reads the file as a job, then continues the
+/// coroutine on the thread that read it and returns the result of ReadFile. path and bytesOut
+/// must stay alive until then.
+/// </summary>
+export auto ReadFileAsync(JobSystem &jobs, fs::path const &path, vector<uint8> &bytesOut)
+{
+    struct Awaiter
+    {
+        JobSystem &Jobs;
+        fs::path const &Path;
+        vector<uint8> &BytesOut;
+        optional<Error> Result;
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(coroutine_handle<> handle)
+        {
+            Jobs.Run([this, handle] {
+                Result = ReadFile(Path, BytesOut);
+                handle.resume();
+            });
+        }
+
+        optional<Error> await_resume() { return move(Result); }
+    };
+    return Awaiter{jobs, path, bytesOut, Success};
+}
 //
 //optional<Error> OpenFileRead(Location relativeTo, fs::path const &path, OpenedFile *outOpenedFile)
 //{
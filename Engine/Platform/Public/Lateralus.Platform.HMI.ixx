@@ -4,10 +4,14 @@ module;
 
 export module Lateralus.Platform.HMI;
 
+import <algorithm>;
 import <array>;
 import <functional>;
+import <mutex>;
 import <optional>;
 import <string>;
+import <variant>;
+import <vector>;
 
 import Lateralus.Core;
 import Lateralus.Core.Signal;
@@ -199,32 +203,144 @@ export enum class MouseButton {
 
 export enum class MouseButtonAction { Release, Press, Repeat };
 
+// Input events are queued by the platform's event callbacks, in the order they arrive. Their
+// handlers run in one batch, in that same order, when iInputProvider::DispatchEvents is called
+// (iWindow::PollEvents does it), so raising one never runs a subscriber.
+
 // Text callback one unicode character at a time (utf-8; characters may be multiple bytes).
-export using TextCallback = Signal<void(u8string_view), SignalLockMutex>;
+export using TextCallback = Signal<void(u8string_view), SignalLockCopyOnWrite>;
 // Key action callback one key at a time (press, release, etc).
-export using KeyActionCallback = Signal<void(KeyCode, KeyAction, KeyModifier), SignalLockMutex>;
+export using KeyActionCallback =
+    Signal<void(KeyCode, KeyAction, KeyModifier), SignalLockCopyOnWrite>;
 
 // On mouse move reports the current cursor position (x, y)
-export using CursorPositionCallback = Signal<void(double, double), SignalLockMutex>;
+export using CursorPositionCallback = Signal<void(double, double), SignalLockCopyOnWrite>;
 // (Desktop) cursor entered the window
-export using CursorEnterCallback = Signal<void(iWindow *), SignalLockMutex>;
+export using CursorEnterCallback = Signal<void(iWindow *), SignalLockCopyOnWrite>;
 // (Desktop) cursor exited the window
-export using CursorLeaveCallback = Signal<void(iWindow *), SignalLockMutex>;
+export using CursorLeaveCallback = Signal<void(iWindow *), SignalLockCopyOnWrite>;
 // (Desktop) Mouse button action (click down, release, etc).
 export using MouseButtonCallback =
-    Signal<void(MouseButton, MouseButtonAction, KeyModifier), SignalLockMutex>;
+    Signal<void(MouseButton, MouseButtonAction, KeyModifier), SignalLockCopyOnWrite>;
 // (Desktop) Scroll wheel delta
-export using ScrollWheelCallback = Signal<void(double, double), SignalLockMutex>;
+export using ScrollWheelCallback = Signal<void(double, double), SignalLockCopyOnWrite>;
+
+// The queued form of each callback's arguments.
+export struct TextEvent
+{
+    TextEvent() = default;
+    explicit TextEvent(u8string_view text) : Size(static_cast<uint8>(min(text.size(), usz(4))))
+    {
+        copy_n(text.begin(), Size, Bytes.begin());
+    }
+
+    u8string_view GetText() const { return u8string_view(Bytes.data(), Size); }
+
+    // One utf-8 character is at most four bytes.
+    array<char8_t, 4> Bytes{};
+    uint8 Size = 0;
+};
+
+export struct KeyActionEvent
+{
+    KeyCode Code;
+    KeyAction Action;
+    KeyModifier Modifiers;
+};
+
+export struct CursorPositionEvent
+{
+    double X;
+    double Y;
+};
+
+export struct CursorEnterEvent
+{
+    iWindow *Window;
+};
+
+export struct CursorLeaveEvent
+{
+    iWindow *Window;
+};
+
+export struct MouseButtonEvent
+{
+    MouseButton Button;
+    MouseButtonAction Action;
+    KeyModifier Modifiers;
+};
+
+export struct ScrollWheelEvent
+{
+    double X;
+    double Y;
+};
+
+export using InputEvent = variant<KeyActionEvent, TextEvent, CursorPositionEvent, CursorEnterEvent,
+                                  CursorLeaveEvent, MouseButtonEvent, ScrollWheelEvent>;
+
+// Events queued between dispatches past which only those ending something (releases, the cursor
+// leaving) and cursor moves are kept, so handlers never miss that a key was let go.
+export constexpr usz k_MaxQueuedInputEvents = 256;
 
 export class iInputProvider
 {
 public:
-    iInputProvider() = default;
+    iInputProvider()
+    {
+        m_Queued.reserve(k_MaxQueuedInputEvents);
+        m_Dispatching.reserve(k_MaxQueuedInputEvents);
+    }
     virtual ~iInputProvider() = default;
 
     virtual optional<Error> Init() = 0;
     virtual void Shutdown() = 0;
 
+    // Queues an event. Safe from any thread. Consecutive cursor moves are merged into the latest,
+    // as only where the cursor is now matters. Returns false when the queue is full and the event
+    // was dropped.
+    bool QueueEvent(InputEvent const &event)
+    {
+        lock_guard lock(m_QueueMutex);
+        if (holds_alternative<CursorPositionEvent>(event) && !m_Queued.empty() &&
+            holds_alternative<CursorPositionEvent>(m_Queued.back()))
+        {
+            m_Queued.back() = event;
+            return true;
+        }
+        if (m_Queued.size() >= k_MaxQueuedInputEvents && !IsKeptWhenFull(event))
+        {
+            ++m_DroppedCount;
+            return false;
+        }
+        m_Queued.push_back(event);
+        return true;
+    }
+
+    // Runs the handlers of every queued input event, in the order the events were queued. Call
+    // from the thread that owns the handlers, once per frame after polling. Events queued by the
+    // handlers wait for the next call.
+    void DispatchEvents()
+    {
+        {
+            lock_guard lock(m_QueueMutex);
+            m_Queued.swap(m_Dispatching);
+        }
+        for (InputEvent const &event : m_Dispatching)
+        {
+            visit([this](auto const &payload) { Invoke(payload); }, event);
+        }
+        m_Dispatching.clear();
+    }
+
+    // Events dropped because the queue was full.
+    usz GetDroppedCount() const
+    {
+        lock_guard lock(m_QueueMutex);
+        return m_DroppedCount;
+    }
+
     // Keyboard / Text
     ENCAPSULATE_SIGNAL(TextCallback, TextCallback);
     ENCAPSULATE_SIGNAL(KeyActionCallback, KeyActionCallback);
@@ -235,5 +351,44 @@ public:
     ENCAPSULATE_SIGNAL(CursorLeaveCallback, CursorLeaveCallback);
     ENCAPSULATE_SIGNAL(MouseButtonCallback, MouseButtonCallback);
     ENCAPSULATE_SIGNAL(ScrollWheelCallback, ScrollWheelCallback);
+
+private:
+    static bool IsKeptWhenFull(InputEvent const &event)
+    {
+        if (auto const *key = get_if<KeyActionEvent>(&event))
+        {
+            return key->Action == KeyAction::Release;
+        }
+        if (auto const *button = get_if<MouseButtonEvent>(&event))
+        {
+            return button->Action == MouseButtonAction::Release;
+        }
+        // Moves only add to the queue after some other kept event, so they can't fill it alone.
+        return holds_alternative<CursorPositionEvent>(event) ||
+               holds_alternative<CursorLeaveEvent>(event);
+    }
+
+    void Invoke(TextEvent const &event) { m_TextCallback.Invoke(event.GetText()); }
+    void Invoke(KeyActionEvent const &event)
+    {
+        m_KeyActionCallback.Invoke(event.Code, event.Action, event.Modifiers);
+    }
+    void Invoke(CursorPositionEvent const &event)
+    {
+        m_CursorPositionCallback.Invoke(event.X, event.Y);
+    }
+    void Invoke(CursorEnterEvent const &event) { m_CursorEnterCallback.Invoke(event.Window); }
+    void Invoke(CursorLeaveEvent const &event) { m_CursorLeaveCallback.Invoke(event.Window); }
+    void Invoke(MouseButtonEvent const &event)
+    {
+        m_MouseButtonCallback.Invoke(event.Button, event.Action, event.Modifiers);
+    }
+    void Invoke(ScrollWheelEvent const &event) { m_ScrollWheelCallback.Invoke(event.X, event.Y); }
+
+    mutable mutex m_QueueMutex;
+    vector<InputEvent> m_Queued;
+    // Swapped with m_Queued while dispatching, so neither gives up its capacity.
+    vector<InputEvent> m_Dispatching;
+    usz m_DroppedCount = 0;
 };
 } // namespace Lateralus::Platform::Input
@@ -0,0 +1,253 @@
+module;
+
+#include <Core.Compiler.h>
+#include <Core.Profile.h>
+
+#if PLATFORM_LINUX
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+export module Lateralus.Platform.PerfCounters;
+
+import <algorithm>;
+import <array>;
+import <atomic>;
+import <format>;
+import <optional>;
+
+import Lateralus.Core;
+import Lateralus.Core.Profile;
+import Lateralus.Platform.Error;
+
+using namespace std;
+using namespace Lateralus::Core;
+using Lateralus::Core::Profile::HardwareCounter;
+using Lateralus::Core::Profile::HardwareCounters;
+using Lateralus::Core::Profile::k_HardwareCounterCount;
+
+// Hardware performance counters for the profiler, read per thread through perf_event_open on
+// Linux. Once enabled, LAT_PROFILE_ZONE_COUNTERS zones carry how many cycles, instructions and
+// misses they took, and NewFrame keeps the same for each whole frame on the main thread.
+namespace Lateralus::Platform::PerfCounters
+{
+namespace
+{
+#if PLATFORM_LINUX
+struct CounterConfig
+{
+    uint32 Type;
+    uint64 Config;
+};
+
+constexpr uint64 GetCacheReadMisses(uint64 cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// Indexed by HardwareCounter.
+constexpr CounterConfig k_CounterConfigs[k_HardwareCounterCount] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, GetCacheReadMisses(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, GetCacheReadMisses(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int OpenCounter(CounterConfig const &config, int groupFd)
+{
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = config.Type;
+    attributes.config = config.Config;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+    // pid 0 and cpu -1: the calling thread, on whichever CPU it runs.
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, groupFd, 0));
+}
+
+// One thread's counters, opened the first time it reads them and closed when it exits.
+class ThreadCounters
+{
+public:
+    ThreadCounters()
+    {
+        m_Fds.fill(-1);
+        // Cycles lead the group, so the counters are always scheduled onto the CPU together and
+        // one read gets them all. Any other counter the CPU doesn't have is left out.
+        for (usz i = 0; i < k_HardwareCounterCount; ++i)
+        {
+            int const fd = OpenCounter(k_CounterConfigs[i], m_Fds[0]);
+            if (fd < 0)
+            {
+                if (i == 0)
+                {
+                    m_Error = errno;
+                    return;
+                }
+                continue;
+            }
+            m_Fds[i] = fd;
+            ioctl(fd, PERF_EVENT_IOC_ID, &m_Ids[i]);
+        }
+    }
+
+    ~ThreadCounters()
+    {
+        for (int const fd : m_Fds)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+
+    ThreadCounters(ThreadCounters const &) = delete;
+    ThreadCounters &operator=(ThreadCounters const &) = delete;
+
+    bool IsOpen() const { return m_Fds[0] >= 0; }
+    bool IsOpen(HardwareCounter counter) const { return m_Fds[static_cast<usz>(counter)] >= 0; }
+    int GetError() const { return m_Error; }
+
+    bool Read(HardwareCounters &countersOut) const
+    {
+        if (!IsOpen())
+        {
+            return false;
+        }
+        // How many counters there are, then a value and id for each.
+        array<uint64, 1 + 2 * k_HardwareCounterCount> buffer;
+        if (read(m_Fds[0], buffer.data(), sizeof(buffer)) < static_cast<ssize_t>(sizeof(uint64)))
+        {
+            return false;
+        }
+        countersOut.fill(0);
+        usz const count = min<usz>(buffer[0], k_HardwareCounterCount);
+        for (usz entry = 0; entry < count; ++entry)
+        {
+            for (usz i = 0; i < k_HardwareCounterCount; ++i)
+            {
+                if (m_Fds[i] >= 0 && m_Ids[i] == buffer[2 + 2 * entry])
+                {
+                    countersOut[i] = buffer[1 + 2 * entry];
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    array<int, k_HardwareCounterCount> m_Fds;
+    array<uint64, k_HardwareCounterCount> m_Ids{};
+    int m_Error = 0;
+};
+
+thread_local ThreadCounters t_Counters;
+
+// Counted zones can be in jobs too. See JobSystem::CurrentThread for why this isn't inlined.
+LAT_NOINLINE ThreadCounters &GetThreadCounters()
+{
+    return t_Counters;
+}
+
+bool ReadThreadCounters(HardwareCounters &countersOut)
+{
+    return GetThreadCounters().Read(countersOut);
+}
+#endif
+
+struct FrameState
+{
+    atomic<bool> Enabled = false;
+    // Read at the start of the frame in progress.
+    optional<HardwareCounters> FrameStart;
+    optional<HardwareCounters> LastFrame;
+    array<bool, k_HardwareCounterCount> Opened{};
+};
+
+FrameState &GetFrameState()
+{
+    static FrameState state;
+    return state;
+}
+} // namespace
+
+// Starts reading hardware counters for the profiler. Fails where the platform doesn't allow it,
+// e.g. in most virtual machines, or when perf_event_paranoid is above 2.
+export optional<Error> Enable()
+{
+#if PLATFORM_LINUX
+    ThreadCounters const &counters = GetThreadCounters();
+    if (!counters.IsOpen())
+    {
+        return Error(format("Couldn't open hardware counters: {}", strerror(counters.GetError())));
+    }
+
+    FrameState &state = GetFrameState();
+    for (usz i = 0; i < k_HardwareCounterCount; ++i)
+    {
+        state.Opened[i] = counters.IsOpen(static_cast<HardwareCounter>(i));
+    }
+    state.FrameStart.reset();
+    state.LastFrame.reset();
+    state.Enabled = true;
+    Core::Profile::SetHardwareCounterReader(ReadThreadCounters);
+    return Success;
+#else
+    return Error("Hardware counters are only read on Linux.");
+#endif
+}
+
+export void Disable()
+{
+    Core::Profile::SetHardwareCounterReader(nullptr);
+    GetFrameState().Enabled = false;
+}
+
+export bool IsEnabled() { return GetFrameState().Enabled; }
+
+// Whether the CPU had the counter when Enable was called. Those it lacks always read 0.
+export bool IsOpen(HardwareCounter counter)
+{
+    return GetFrameState().Opened[static_cast<usz>(counter)];
+}
+
+// The counters over the last whole frame on the main thread, once there's been one.
+export optional<HardwareCounters> const &GetLastFrame() { return GetFrameState().LastFrame; }
+
+// Ends one frame's counting and starts the next, sampling the finished frame's counters for
+// captures. Called by iWindow::NewFrame.
+export void NewFrame()
+{
+    FrameState &state = GetFrameState();
+    HardwareCounters now;
+    if (!state.Enabled || !Core::Profile::ReadHardwareCounters(now))
+    {
+        return;
+    }
+
+    if (state.FrameStart.has_value())
+    {
+        HardwareCounters frame;
+        for (usz i = 0; i < k_HardwareCounterCount; ++i)
+        {
+            frame[i] = now[i] - (*state.FrameStart)[i];
+            LAT_PROFILE_COUNTER(Core::Profile::HardwareCounterName(static_cast<HardwareCounter>(i)),
+                                frame[i]);
+        }
+        auto const cycles = frame[static_cast<usz>(HardwareCounter::Cycles)];
+        auto const instructions = frame[static_cast<usz>(HardwareCounter::Instructions)];
+        LAT_PROFILE_COUNTER("IPC", cycles == 0 ? 0.0
+                                               : static_cast<double>(instructions) /
+                                                     static_cast<double>(cycles));
+        state.LastFrame = frame;
+    }
+    state.FrameStart = now;
+}
+} // namespace Lateralus::Platform::PerfCounters
@@ -0,0 +1,289 @@
+module;
+
+#include <Core.Assert.h>
+#include <Core.Log.h>
+#include <Core.Profile.h>
+
+export module Lateralus.Platform.ProfileCapture;
+
+import <array>;
+import <chrono>;
+import <filesystem>;
+import <format>;
+import <fstream>;
+import <memory>;
+import <optional>;
+import <string>;
+import <string_view>;
+
+import Lateralus.Core;
+import Lateralus.Core.Memory;
+import Lateralus.Core.Profile;
+import Lateralus.Platform.Error;
+import Lateralus.Platform.FS;
+import Lateralus.Platform.HMI;
+
+namespace fs = std::filesystem;
+using namespace std;
+using namespace Lateralus::Core;
+
+// Captures stream what the profiler records to a Chrome Trace Event JSON file in
+// FS::Location::Temp, drained once a frame by iWindow::NewFrame so the capture can run for as long
+// as needed. Open the file in https://ui.perfetto.dev or chrome://tracing.
+//
+// Hitch capture instead watches how long frames take, from one iWindow::SwapBuffers to the next,
+// and when one is over budget writes the seconds before it to a file of its own.
+//
+// Everything here is for the main thread only.
+namespace Lateralus::Platform::ProfileCapture
+{
+// Windows made by CreateWindow start and stop a capture when this is pressed.
+export constexpr HMI::KeyCode k_ToggleKey = HMI::KeyCode::Key_F11;
+
+namespace
+{
+struct Capture
+{
+    fs::path Path;
+    ofstream File;
+    unique_ptr<Core::Profile::TraceWriter> Writer;
+};
+
+unique_ptr<Capture> &GetCapture()
+{
+    static unique_ptr<Capture> capture;
+    return capture;
+}
+
+// Counter names have to outlive the capture, so they're made once and never freed.
+char const *MemoryCounterName(MemoryTag tag)
+{
+    static array<string, k_MemoryTagCount> const *names = [] {
+        auto *names = new array<string, k_MemoryTagCount>;
+        for (usz index = 0; index < k_MemoryTagCount; ++index)
+        {
+            (*names)[index] = format("Memory {}", MemoryTagName(static_cast<MemoryTag>(index)));
+        }
+        return names;
+    }();
+    return (*names)[static_cast<usz>(tag)].c_str();
+}
+
+// Opens a new trace file in FS::Location::Temp, named for the time.
+optional<Error> OpenTraceFile(string_view prefix, fs::path &pathOut, ofstream &fileOut)
+{
+    fs::path directory;
+    if (auto err = FS::GetLocationPath(FS::Location::Temp, directory); err.has_value())
+    {
+        return err;
+    }
+
+    auto const now = chrono::floor<chrono::milliseconds>(chrono::system_clock::now());
+    pathOut = directory / format("{}-{:%Y%m%d-%H%M%S}.trace.json", prefix, now);
+    fileOut.open(pathOut, ios::binary | ios::trunc);
+    if (!fileOut)
+    {
+        return Error(format("Couldn't open profile capture {}", pathOut.string()));
+    }
+    return Success;
+}
+} // namespace
+
+export bool IsCapturing() { return GetCapture() != nullptr; }
+
+// Starts a capture, if one isn't running, and sets pathOut to the file it's written to.
+export optional<Error> Start(fs::path &pathOut)
+{
+    if (IsCapturing())
+    {
+        return Error("A profile capture is already running.");
+    }
+
+    auto capture = make_unique<Capture>();
+    if (auto err = OpenTraceFile("Lateralus", capture->Path, capture->File); err.has_value())
+    {
+        return err;
+    }
+    capture->Writer = make_unique<Core::Profile::TraceWriter>(capture->File);
+
+    pathOut = capture->Path;
+    GetCapture() = move(capture);
+    return Success;
+}
+
+// Samples each memory tag as a counter, so hitch captures have them too, then writes what's been
+// recorded since the last call to the running capture, if any.
+export void Update()
+{
+    for (usz index = 0; index < k_MemoryTagCount; ++index)
+    {
+        auto const tag = static_cast<MemoryTag>(index);
+        LAT_PROFILE_COUNTER(MemoryCounterName(tag), GetMemoryTagStats(tag).CurrentBytes);
+    }
+
+    if (unique_ptr<Capture> const &capture = GetCapture(); capture != nullptr)
+    {
+        LAT_PROFILE_ZONE("ProfileCapture::Update");
+        capture->Writer->Drain();
+    }
+}
+
+// Finishes the running capture and sets pathOut to its file.
+export optional<Error> Stop(fs::path &pathOut)
+{
+    unique_ptr<Capture> capture = move(GetCapture());
+    if (capture == nullptr)
+    {
+        return Error("No profile capture is running.");
+    }
+
+    capture->Writer->Finish();
+    if (uint64 const lost = capture->Writer->GetLostCount(); lost != 0)
+    {
+        LOG_WARN("Profile capture lost {} events that were overwritten before they were written",
+                 lost);
+    }
+    pathOut = capture->Path;
+    capture->File.close();
+    if (!capture->File)
+    {
+        return Error(format("Couldn't write profile capture {}", pathOut.string()));
+    }
+    return Success;
+}
+
+// Starts a capture if none is running, otherwise stops it, logging where it's written.
+export void Toggle()
+{
+    fs::path path;
+    if (!IsCapturing())
+    {
+        if (auto err = Start(path); err.has_value())
+        {
+            LOG_ERROR("Couldn't start profile capture: {}", err.value().GetErrorMessage());
+            return;
+        }
+        LOG_INFO("Profile capture started: {}", path.string());
+    }
+    else
+    {
+        if (auto err = Stop(path); err.has_value())
+        {
+            LOG_ERROR("Couldn't stop profile capture: {}", err.value().GetErrorMessage());
+            return;
+        }
+        LOG_INFO("Profile capture written: {}", path.string());
+    }
+}
+
+export struct HitchSettings
+{
+    // A frame taking longer than this, from one SwapBuffers to the next, is a hitch.
+    double BudgetMilliseconds = 100.0;
+    // How long before the end of a hitch to save. The rings may not keep all of it when zones
+    // are recorded quickly; the file starts from the oldest they still have.
+    double WindowSeconds = 3.0;
+};
+
+namespace
+{
+struct HitchState
+{
+    optional<HitchSettings> Settings;
+    // When the last frame ended, or 0 before the first.
+    uint64 LastFrameEnd = 0;
+    // When the last saved window ended. Hitches inside the window after it aren't saved again.
+    uint64 LastSaveEnd = 0;
+    uint64 HitchCount = 0;
+};
+
+HitchState &GetHitchState()
+{
+    static HitchState state;
+    return state;
+}
+
+optional<Error> SaveHitch(uint64 since, fs::path &pathOut)
+{
+    ofstream file;
+    if (auto err = OpenTraceFile("Lateralus-Hitch", pathOut, file); err.has_value())
+    {
+        return err;
+    }
+    Core::Profile::TraceWriter writer(file, since);
+    writer.Finish();
+    file.close();
+    if (!file)
+    {
+        return Error(format("Couldn't write profile capture {}", pathOut.string()));
+    }
+    return Success;
+}
+} // namespace
+
+// Starts watching for hitches, or changes the settings if already watching.
+export void EnableHitchCapture(HitchSettings const &settings)
+{
+    LAT_ASSERT(settings.BudgetMilliseconds > 0.0 && settings.WindowSeconds > 0.0);
+    // Calibrates now, rather than in the middle of timing a frame.
+    Core::Profile::GetTicksPerSecond();
+    HitchState &state = GetHitchState();
+    state.Settings = settings;
+    state.LastFrameEnd = 0;
+}
+
+export void DisableHitchCapture() { GetHitchState().Settings.reset(); }
+
+export bool IsHitchCaptureEnabled() { return GetHitchState().Settings.has_value(); }
+
+// Hitches seen while enabled, including those too close to the last to be saved.
+export uint64 GetHitchCount() { return GetHitchState().HitchCount; }
+
+// Ends the frame for hitch capture, saving it and the seconds before if it took too long. Called by
+// iWindow::SwapBuffers.
+export void EndFrame()
+{
+    HitchState &state = GetHitchState();
+    if (!state.Settings.has_value())
+    {
+        return;
+    }
+
+    uint64 const now = Core::Profile::GetTicks();
+    uint64 const previous = state.LastFrameEnd;
+    state.LastFrameEnd = now;
+    if (previous == 0)
+    {
+        return;
+    }
+    double const milliseconds = Core::Profile::TicksToMilliseconds(now - previous);
+    if (milliseconds <= state.Settings->BudgetMilliseconds)
+    {
+        return;
+    }
+
+    state.HitchCount++;
+    auto const window =
+        static_cast<uint64>(state.Settings->WindowSeconds *
+                            static_cast<double>(Core::Profile::GetTicksPerSecond()));
+    if (state.LastSaveEnd != 0 && now - state.LastSaveEnd < window)
+    {
+        LOG_WARN("Hitch: frame took {:.1f} ms, within the last saved window", milliseconds);
+        return;
+    }
+
+    fs::path path;
+    if (auto err = SaveHitch(now > window ? now - window : 0, path); err.has_value())
+    {
+        LOG_ERROR("Hitch: frame took {:.1f} ms, but couldn't save it: {}", milliseconds,
+                  err.value().GetErrorMessage());
+    }
+    else
+    {
+        LOG_WARN("Hitch: frame took {:.1f} ms, saved to {}", milliseconds, path.string());
+    }
+    state.LastSaveEnd = now;
+    // Saving takes time the next frame shouldn't be blamed for.
+    state.LastFrameEnd = Core::Profile::GetTicks();
+}
+} // namespace Lateralus::Platform::ProfileCapture
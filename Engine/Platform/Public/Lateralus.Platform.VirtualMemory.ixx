@@ -0,0 +1,475 @@
+module;
+
+#include <Core.Assert.h>
+
+#if PLATFORM_WIN64
+#define MICROSOFT_WINDOWS_WINBASE_H_DEFINE_INTERLOCKED_CPLUSPLUS_OVERLOADS 0 // [#hack]
+#define __SPECSTRINGS_STRICT_LEVEL 0                                         // [#hack]
+#undef APIENTRY
+#include <windows.h>
+#undef __nullnullterminated // [#hack]
+#else
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+export module Lateralus.Platform.VirtualMemory;
+
+import <algorithm>;
+import <cstddef>;
+import <format>;
+import <memory_resource>;
+import <new>;
+import <optional>;
+import <string_view>;
+import <utility>;
+
+import Lateralus.Core;
+import Lateralus.Core.Memory;
+import Lateralus.Platform.Error;
+
+using namespace std;
+using namespace Lateralus::Core;
+
+namespace Lateralus::Platform::VirtualMemory
+{
+Error LastError(string_view what)
+{
+#if PLATFORM_WIN64
+    return Error(format("{} failed. Windows error code: {}", what, GetLastError()));
+#else
+    int const error = errno;
+    return Error(format("{} failed. errno {}: {}", what, error, strerror(error)));
+#endif
+}
+
+// Transparent huge pages are 2 MiB on x64 and the usual arm64 configurations.
+constexpr usz k_HugePageSize = 2 * 1024 * 1024;
+
+// The size of a page, the unit of Commit and Decommit.
+export usz GetPageSize()
+{
+#if PLATFORM_WIN64
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return static_cast<usz>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// The size and alignment Reserve rounds up to.
+export usz GetReserveGranularity()
+{
+#if PLATFORM_WIN64
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return GetPageSize();
+#endif
+}
+
+/// <summary>
+/// Reserves address space without backing it with memory. Nothing in the range may be touched
+/// until it's committed, and it's given back with Release.
+///
+/// hugePages asks the system to back the range with huge pages, which cuts TLB misses on large
+/// tables that are walked often. On Linux the range is aligned for transparent huge pages and
+/// marked with madvise. Windows only offers huge pages as locked memory committed up front, so
+/// the flag is ignored there.
+/// </summary>
+export optional<Error> Reserve(usz bytes, void *&addressOut, bool hugePages = false)
+{
+    LAT_ASSERT(bytes != 0);
+    addressOut = nullptr;
+#if PLATFORM_WIN64
+    (void)hugePages;
+    void *address = VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+    if (address == nullptr)
+    {
+        return LastError("VirtualAlloc reserving address space");
+    }
+    addressOut = address;
+#else
+    bytes = AlignUp(bytes, GetPageSize());
+    // Over-reserve by a huge page so the range can start on one, then unmap the excess.
+    usz const padding = hugePages ? k_HugePageSize : 0;
+    void *mapped = mmap(nullptr, bytes + padding, PROT_NONE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mapped == MAP_FAILED)
+    {
+        return LastError("mmap reserving address space");
+    }
+    auto *begin = static_cast<std::byte *>(mapped);
+    auto *aligned = begin;
+    if (hugePages)
+    {
+        aligned = reinterpret_cast<std::byte *>(
+            AlignUp(reinterpret_cast<uintptr_t>(begin), k_HugePageSize));
+        if (aligned != begin)
+        {
+            munmap(begin, aligned - begin);
+        }
+        usz const tail = padding - (aligned - begin);
+        if (tail != 0)
+        {
+            munmap(aligned + bytes, tail);
+        }
+        // Only a hint: kernels with transparent huge pages disabled refuse it.
+        madvise(aligned, bytes, MADV_HUGEPAGE);
+    }
+    addressOut = aligned;
+#endif
+    return Success;
+}
+
+// Backs whole pages of a reserved range with zeroed memory, readable and writable.
+export optional<Error> Commit(void *address, usz bytes)
+{
+#if PLATFORM_WIN64
+    if (VirtualAlloc(address, bytes, MEM_COMMIT, PAGE_READWRITE) == nullptr)
+    {
+        return LastError("VirtualAlloc committing memory");
+    }
+#else
+    if (mprotect(address, bytes, PROT_READ | PROT_WRITE) != 0)
+    {
+        return LastError("mprotect committing memory");
+    }
+#endif
+    return Success;
+}
+
+// Gives committed pages back to the system, keeping the address space reserved. Committing them
+// again gives zeroed memory.
+export optional<Error> Decommit(void *address, usz bytes)
+{
+#if PLATFORM_WIN64
+    if (!VirtualFree(address, bytes, MEM_DECOMMIT))
+    {
+        return LastError("VirtualFree decommitting memory");
+    }
+#else
+    if (madvise(address, bytes, MADV_DONTNEED) != 0 || mprotect(address, bytes, PROT_NONE) != 0)
+    {
+        return LastError("Decommitting memory");
+    }
+#endif
+    return Success;
+}
+
+// Releases a whole range returned by Reserve, committed or not. bytes is the size reserved.
+export optional<Error> Release(void *address, usz bytes)
+{
+#if PLATFORM_WIN64
+    (void)bytes;
+    if (!VirtualFree(address, 0, MEM_RELEASE))
+    {
+        return LastError("VirtualFree releasing address space");
+    }
+#else
+    if (munmap(address, AlignUp(bytes, GetPageSize())) != 0)
+    {
+        return LastError("munmap releasing address space");
+    }
+#endif
+    return Success;
+}
+
+// Pages are committed at least this many bytes at a time, to keep system calls rare.
+constexpr usz k_CommitGranularity = 64 * 1024;
+
+/// <summary>
+/// A linear arena that grows in place: it reserves address space for the most it will ever hold
+/// and commits pages as allocations reach them, so it never moves or copies anything and only
+/// uses the memory it has needed. Allocation returns nullptr, or throws std::bad_alloc through the
+/// std::pmr::memory_resource interface, once the reservation is used up.
+///
+/// Unlike LinearArena it's for one thread at a time. Committed pages count against
+/// MemoryTag::Platform.
+/// </summary>
+export class VirtualArena : public pmr::memory_resource
+{
+public:
+    VirtualArena() = default;
+    VirtualArena(VirtualArena const &) = delete;
+    VirtualArena &operator=(VirtualArena const &) = delete;
+
+    ~VirtualArena() override
+    {
+        if (m_Base != nullptr)
+        {
+            TrackFree(MemoryTag::Platform, m_Committed);
+            Release(m_Base, m_Reserved);
+        }
+    }
+
+    optional<Error> Init(usz reserveBytes, bool hugePages = false)
+    {
+        LAT_ASSERT(m_Base == nullptr);
+        void *base = nullptr;
+        if (optional<Error> error = Reserve(reserveBytes, base, hugePages))
+        {
+            return error;
+        }
+        m_Base = static_cast<std::byte *>(base);
+        m_Reserved = reserveBytes;
+        // Committing a huge page at a time lets the system back each one with a huge page.
+        m_Granularity = hugePages ? k_HugePageSize : std::max(k_CommitGranularity, GetPageSize());
+        return Success;
+    }
+
+    void *Allocate(usz bytes, usz alignment = alignof(std::max_align_t))
+    {
+        LAT_ASSERT(m_Base != nullptr);
+        usz const begin = AlignUp(m_Used, alignment);
+        usz const end = begin + bytes;
+        if (end > m_Reserved)
+        {
+            return nullptr;
+        }
+        if (end > m_Committed)
+        {
+            usz const committed = std::min(AlignUp(end, m_Granularity), m_Reserved);
+            if (Commit(m_Base + m_Committed, committed - m_Committed))
+            {
+                return nullptr;
+            }
+            TrackAlloc(MemoryTag::Platform, committed - m_Committed);
+            m_Committed = committed;
+        }
+        m_Used = end;
+        return m_Base + begin;
+    }
+
+    // Frees everything, keeping the pages committed for reuse.
+    void Reset() { m_Used = 0; }
+
+    // Decommits the pages past what's in use.
+    void Trim()
+    {
+        usz const keep = AlignUp(m_Used, m_Granularity);
+        if (keep < m_Committed && !Decommit(m_Base + keep, m_Committed - keep))
+        {
+            TrackFree(MemoryTag::Platform, m_Committed - keep);
+            m_Committed = keep;
+        }
+    }
+
+    usz GetUsed() const { return m_Used; }
+    usz GetCommitted() const { return m_Committed; }
+    usz GetReserved() const { return m_Reserved; }
+
+private:
+    void *do_allocate(usz bytes, usz alignment) override
+    {
+        void *pointer = Allocate(bytes, alignment);
+        if (pointer == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+
+    void do_deallocate(void *, usz, usz) override {}
+
+    bool do_is_equal(pmr::memory_resource const &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::byte *m_Base = nullptr;
+    usz m_Reserved = 0;
+    usz m_Committed = 0;
+    usz m_Used = 0;
+    usz m_Granularity = k_CommitGranularity;
+};
+
+/// <summary>
+/// A vector whose storage never moves. Init reserves address space for the most elements it can
+/// ever hold and pages are committed as it grows, so growing never copies, there's no spike
+/// while a big table doubles, and pointers to elements stay valid until they're erased.
+///
+/// Growing past the count given to Init, or failing to commit pages, throws std::bad_alloc.
+/// Committed pages count against MemoryTag::Platform.
+/// </summary>
+export template <typename T> class VirtualVector
+{
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+    VirtualVector() = default;
+    VirtualVector(VirtualVector &&other) noexcept
+        : m_Data(std::exchange(other.m_Data, nullptr)), m_Size(std::exchange(other.m_Size, 0)),
+          m_Capacity(std::exchange(other.m_Capacity, 0)),
+          m_CommittedBytes(std::exchange(other.m_CommittedBytes, 0)),
+          m_MaxSize(std::exchange(other.m_MaxSize, 0))
+    {
+    }
+    VirtualVector &operator=(VirtualVector &&other) noexcept
+    {
+        std::swap(m_Data, other.m_Data);
+        std::swap(m_Size, other.m_Size);
+        std::swap(m_Capacity, other.m_Capacity);
+        std::swap(m_CommittedBytes, other.m_CommittedBytes);
+        std::swap(m_MaxSize, other.m_MaxSize);
+        return *this;
+    }
+    VirtualVector(VirtualVector const &) = delete;
+    VirtualVector &operator=(VirtualVector const &) = delete;
+
+    ~VirtualVector()
+    {
+        if (m_Data != nullptr)
+        {
+            clear();
+            TrackFree(MemoryTag::Platform, m_CommittedBytes);
+            Release(m_Data, GetReservedBytes());
+        }
+    }
+
+    optional<Error> Init(usz maxSize, bool hugePages = false)
+    {
+        LAT_ASSERT(m_Data == nullptr && maxSize != 0);
+        void *data = nullptr;
+        if (optional<Error> error = Reserve(maxSize * sizeof(T), data, hugePages))
+        {
+            return error;
+        }
+        m_Data = static_cast<T *>(data);
+        m_MaxSize = maxSize;
+        return Success;
+    }
+
+    template <typename... Args> T &emplace_back(Args &&...args)
+    {
+        if (m_Size == m_Capacity)
+        {
+            Grow(m_Size + 1);
+        }
+        T *element = new (m_Data + m_Size) T(std::forward<Args>(args)...);
+        m_Size++;
+        return *element;
+    }
+
+    void push_back(T const &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    void pop_back()
+    {
+        LAT_ASSERT(m_Size != 0);
+        m_Data[--m_Size].~T();
+    }
+
+    void resize(usz size)
+    {
+        reserve(size);
+        while (m_Size < size)
+        {
+            new (m_Data + m_Size) T();
+            m_Size++;
+        }
+        while (m_Size > size)
+        {
+            pop_back();
+        }
+    }
+
+    // Commits memory for count elements up front.
+    void reserve(usz count)
+    {
+        if (count > m_Capacity)
+        {
+            Grow(count);
+        }
+    }
+
+    void clear()
+    {
+        while (m_Size != 0)
+        {
+            pop_back();
+        }
+    }
+
+    // Decommits the pages past the last element.
+    void shrink_to_fit()
+    {
+        usz const keepBytes = AlignUp(m_Size * sizeof(T), GetPageSize());
+        if (keepBytes < m_CommittedBytes &&
+            !Decommit(reinterpret_cast<std::byte *>(m_Data) + keepBytes,
+                      m_CommittedBytes - keepBytes))
+        {
+            TrackFree(MemoryTag::Platform, m_CommittedBytes - keepBytes);
+            m_CommittedBytes = keepBytes;
+            m_Capacity = keepBytes / sizeof(T);
+        }
+    }
+
+    T &operator[](usz index)
+    {
+        LAT_ASSERT(index < m_Size);
+        return m_Data[index];
+    }
+    T const &operator[](usz index) const
+    {
+        LAT_ASSERT(index < m_Size);
+        return m_Data[index];
+    }
+
+    T &front() { return (*this)[0]; }
+    T &back() { return (*this)[m_Size - 1]; }
+
+    T *data() { return m_Data; }
+    T const *data() const { return m_Data; }
+
+    iterator begin() { return m_Data; }
+    iterator end() { return m_Data + m_Size; }
+    const_iterator begin() const { return m_Data; }
+    const_iterator end() const { return m_Data + m_Size; }
+
+    usz size() const { return m_Size; }
+    bool empty() const { return m_Size == 0; }
+    // Elements that fit in the committed pages.
+    usz capacity() const { return m_Capacity; }
+    // Elements that fit in the reserved address space.
+    usz max_size() const { return m_MaxSize; }
+
+private:
+    usz GetReservedBytes() const { return m_MaxSize * sizeof(T); }
+
+    // Commits at least half as much again, so growing one element at a time stays cheap.
+    void Grow(usz count)
+    {
+        LAT_ASSERT(m_Data != nullptr);
+        if (count > m_MaxSize)
+        {
+            throw std::bad_alloc();
+        }
+        usz const pageSize = GetPageSize();
+        usz const wantedBytes = std::max(
+            {count * sizeof(T), m_CommittedBytes + m_CommittedBytes / 2, k_CommitGranularity});
+        usz const newBytes = std::min(AlignUp(wantedBytes, pageSize),
+                                      AlignUp(GetReservedBytes(), pageSize));
+        if (Commit(reinterpret_cast<std::byte *>(m_Data) + m_CommittedBytes,
+                   newBytes - m_CommittedBytes))
+        {
+            throw std::bad_alloc();
+        }
+        TrackAlloc(MemoryTag::Platform, newBytes - m_CommittedBytes);
+        m_CommittedBytes = newBytes;
+        m_Capacity = std::min(newBytes / sizeof(T), m_MaxSize);
+    }
+
+    T *m_Data = nullptr;
+    usz m_Size = 0;
+    usz m_Capacity = 0;
+    usz m_CommittedBytes = 0;
+    usz m_MaxSize = 0;
+};
+} // namespace Lateralus::Platform::VirtualMemory
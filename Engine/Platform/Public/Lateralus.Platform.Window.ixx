@@ -5,6 +5,7 @@ module;
 export module Lateralus.Platform.Window;
 
 import Lateralus.Core;
+import Lateralus.Core.Task;
 import Lateralus.Platform.Error;
 import Lateralus.Platform.Platform;
 import <memory>;
@@ -31,7 +32,8 @@ public:
     // Poll events periodically (once per frame is typical)
     virtual void PollEvents() = 0;
 
-    // Call once to begin a new frame.
+    // Call once to begin a new frame. Also moves the frame arena on, freeing what was allocated
+    // from it two frames ago (see Core::GetFrameArena), and marks the frame for the profiler.
     virtual void NewFrame() = 0;
 
     // Clear once per frame before rendering anything
@@ -40,8 +42,16 @@ public:
     // Render once per frame before swapping buffers.
     virtual void Render() = 0;
 
-    // Swap buffers to end the render frame.
+    // Swap buffers to end the render frame. Frames are timed from one call to the next for
+    // ProfileCapture::EnableHitchCapture.
     virtual void SwapBuffers() = 0;
+
+    // co_await window.AfterPollEvents() continues a coroutine on the thread polling events, right
+    // after the next PollEvents has handled input.
+    ResumeQueue &AfterPollEvents() { return m_AfterPollEvents; }
+
+protected:
+    ResumeQueue m_AfterPollEvents;
 };
 
 export struct WindowCreateContext
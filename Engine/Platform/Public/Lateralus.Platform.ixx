@@ -3,6 +3,8 @@ export module Lateralus.Platform;
 import <memory>;
 import <optional>;
 
+import Lateralus.Core.Memory;
+
 import Lateralus.Platform.Platform;
 #if PLATFORM_WIN64
 import Lateralus.Platform.Platform.Windows;
@@ -24,18 +26,18 @@ namespace Lateralus::Platform
 export shared_ptr<iPlatform> CreatePlatform()
 {
 #if PLATFORM_WIN64 || PLATFORM_WIN32
-    return make_shared<Windows::Platform>();
+    return Core::MakeTaggedShared<Windows::Platform>(Core::MemoryTag::Platform);
 #else
-    return make_shared<Null::Platform>();
+    return Core::MakeTaggedShared<Null::Platform>(Core::MemoryTag::Platform);
 #endif
 }
 
 export shared_ptr<iWindow> CreateWindow()
 {
 #if ENABLE_GLFW
-    return make_shared<GLFW::Window>();
+    return Core::MakeTaggedShared<GLFW::Window>(Core::MemoryTag::Platform);
 #else
-    return make_shared<Null::Window>();
+    return Core::MakeTaggedShared<Null::Window>(Core::MemoryTag::Platform);
 #endif
 }
 } // namespace Lateralus::Platform
\ No newline at end of file
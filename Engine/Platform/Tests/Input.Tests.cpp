@@ -3,10 +3,101 @@
 
 import Lateralus.Core;
 import Lateralus.Platform;
+import Lateralus.Platform.Error;
+import Lateralus.Platform.HMI;
 import <array>;
+import <format>;
+import <optional>;
+import <string>;
+import <string_view>;
+import <vector>;
 
 namespace Lateralus::Platform::Tests
 {
+using namespace HMI;
+
+namespace
+{
+class TestInputProvider : public iInputProvider
+{
+public:
+    std::optional<Error> Init() override { return Success; }
+    void Shutdown() override {}
+};
+
+// Records every callback as one line, in the order they ran.
+struct InputLog
+{
+    explicit InputLog(iInputProvider &input)
+    {
+        input.GetKeyActionCallback() += [this](KeyCode code, KeyAction action, KeyModifier) {
+            Lines.push_back(std::format("key {} {}", static_cast<int>(code),
+                                        static_cast<int>(action)));
+        };
+        input.GetTextCallback() += [this](std::u8string_view text) {
+            Lines.push_back("text " + std::string(text.begin(), text.end()));
+        };
+        input.GetCursorPositionCallback() += [this](double x, double y) {
+            Lines.push_back(std::format("cursor {} {}", x, y));
+        };
+        input.GetMouseButtonCallback() += [this](MouseButton button, MouseButtonAction action,
+                                                 KeyModifier) {
+            Lines.push_back(std::format("button {} {}", static_cast<int>(button),
+                                        static_cast<int>(action)));
+        };
+    }
+
+    std::vector<std::string> Lines;
+};
+} // namespace
+
 TEST(Platform, InputTest) {}
 
+TEST(Platform_Input, DispatchesInArrivalOrder)
+{
+    TestInputProvider input;
+    InputLog log(input);
+
+    input.QueueEvent(MouseButtonEvent{MouseButton::Left, MouseButtonAction::Press, {}});
+    input.QueueEvent(CursorPositionEvent{1.0, 2.0});
+    input.QueueEvent(CursorPositionEvent{3.0, 4.0});
+    input.QueueEvent(KeyActionEvent{KeyCode::Key_A, KeyAction::Press, {}});
+    input.QueueEvent(TextEvent(u8"a"));
+    input.QueueEvent(CursorPositionEvent{5.0, 6.0});
+    input.QueueEvent(MouseButtonEvent{MouseButton::Left, MouseButtonAction::Release, {}});
+    EXPECT_TRUE(log.Lines.empty());
+
+    input.DispatchEvents();
+    std::vector<std::string> const expected = {"button 0 1", "cursor 3 4", "key 65 1", "text a",
+                                               "cursor 5 6", "button 0 0"};
+    EXPECT_EQ(log.Lines, expected);
+
+    log.Lines.clear();
+    input.DispatchEvents();
+    EXPECT_TRUE(log.Lines.empty());
+}
+
+TEST(Platform_Input, KeepsReleasesWhenFull)
+{
+    TestInputProvider input;
+    InputLog log(input);
+
+    for (usz i = 0; i < k_MaxQueuedInputEvents; ++i)
+    {
+        EXPECT_TRUE(input.QueueEvent(KeyActionEvent{KeyCode::Key_B, KeyAction::Repeat, {}}));
+    }
+    EXPECT_FALSE(input.QueueEvent(KeyActionEvent{KeyCode::Key_C, KeyAction::Press, {}}));
+    EXPECT_TRUE(input.QueueEvent(CursorPositionEvent{1.0, 1.0}));
+    EXPECT_TRUE(input.QueueEvent(CursorPositionEvent{2.0, 2.0}));
+    EXPECT_TRUE(input.QueueEvent(KeyActionEvent{KeyCode::Key_B, KeyAction::Release, {}}));
+    EXPECT_TRUE(
+        input.QueueEvent(MouseButtonEvent{MouseButton::Right, MouseButtonAction::Release, {}}));
+    EXPECT_EQ(input.GetDroppedCount(), 1u);
+
+    input.DispatchEvents();
+    ASSERT_EQ(log.Lines.size(), k_MaxQueuedInputEvents + 3);
+    EXPECT_EQ(log.Lines[k_MaxQueuedInputEvents], "cursor 2 2");
+    EXPECT_EQ(log.Lines[k_MaxQueuedInputEvents + 1], "key 66 0");
+    EXPECT_EQ(log.Lines[k_MaxQueuedInputEvents + 2], "button 1 0");
+}
 } // namespace Lateralus::Platform::Tests
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <Core.Profile.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Profile;
+import Lateralus.Platform.Error;
+import Lateralus.Platform.PerfCounters;
+import <optional>;
+import <thread>;
+
+using namespace std;
+
+namespace Lateralus::Platform::PerfCounters::Tests
+{
+namespace
+{
+volatile uint64 g_Sink = 0;
+
+void Spin()
+{
+    for (uint64 i = 0; i < 1'000'000; ++i)
+    {
+        g_Sink = g_Sink + i;
+    }
+}
+} // namespace
+
+TEST(Platform_PerfCounters, CountsZonesAndFrames)
+{
+    if (auto err = Enable(); err.has_value())
+    {
+        GTEST_SKIP() << err.value().GetErrorMessage();
+    }
+    EXPECT_TRUE(IsEnabled());
+    EXPECT_TRUE(IsOpen(Core::Profile::HardwareCounter::Cycles));
+
+    NewFrame();
+    EXPECT_FALSE(GetLastFrame().has_value());
+    Spin();
+    NewFrame();
+    ASSERT_TRUE(GetLastFrame().has_value());
+    Core::Profile::HardwareCounters const frame = GetLastFrame().value();
+    EXPECT_GT(frame[static_cast<usz>(Core::Profile::HardwareCounter::Cycles)], 1'000'000u);
+    EXPECT_GT(frame[static_cast<usz>(Core::Profile::HardwareCounter::Instructions)], 1'000'000u);
+
+    // Other threads open their own counters on first use.
+    thread([] {
+        Core::Profile::SetThreadName("PerfCounters");
+        LAT_PROFILE_ZONE_COUNTERS("Spin");
+        Spin();
+    }).join();
+    bool found = false;
+    for (Core::Profile::ThreadCapture const &capture : Core::Profile::CaptureZones())
+    {
+        if (capture.Name == "PerfCounters")
+        {
+            ASSERT_EQ(capture.Zones.size(), 1u);
+            EXPECT_TRUE(capture.Zones[0].HasCounters);
+            EXPECT_GT(capture.Zones[0].Counters[static_cast<usz>(
+                          Core::Profile::HardwareCounter::Instructions)],
+                      1'000'000u);
+            found = true;
+        }
+    }
+    EXPECT_TRUE(found);
+
+    Disable();
+    EXPECT_FALSE(IsEnabled());
+}
+} // namespace Lateralus::Platform::PerfCounters::Tests
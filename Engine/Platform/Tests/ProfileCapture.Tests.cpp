@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <Core.Profile.h>
+
+import Lateralus.Core;
+import Lateralus.Core.Profile;
+import Lateralus.Platform.Error;
+import Lateralus.Platform.ProfileCapture;
+import <chrono>;
+import <filesystem>;
+import <fstream>;
+import <sstream>;
+import <string>;
+import <thread>;
+
+using namespace std;
+
+namespace Lateralus::Platform::ProfileCapture::Tests
+{
+TEST(Platform_ProfileCapture, StartUpdateStop)
+{
+    filesystem::path path;
+    ASSERT_FALSE(Start(path).has_value());
+    EXPECT_TRUE(IsCapturing());
+    EXPECT_TRUE(Start(path).has_value());
+
+    {
+        LAT_PROFILE_ZONE("Captured");
+    }
+    Core::Profile::MarkFrame();
+    Update();
+
+    filesystem::path stopped;
+    ASSERT_FALSE(Stop(stopped).has_value());
+    EXPECT_EQ(stopped, path);
+    EXPECT_FALSE(IsCapturing());
+    EXPECT_TRUE(Stop(stopped).has_value());
+
+    stringstream json;
+    json << ifstream(path).rdbuf();
+    EXPECT_NE(json.str().find("\"Captured\""), string::npos);
+    EXPECT_NE(json.str().find("\"Memory Core\""), string::npos);
+    EXPECT_TRUE(json.str().ends_with("]}\n"));
+    filesystem::remove(path);
+}
+
+TEST(Platform_ProfileCapture, SavesHitches)
+{
+    auto const tempFiles = [] {
+        usz count = 0;
+        for (filesystem::directory_entry const &entry :
+             filesystem::directory_iterator(filesystem::temp_directory_path()))
+        {
+            count += entry.path().filename().string().starts_with("Lateralus-Hitch-") ? 1 : 0;
+        }
+        return count;
+    };
+    usz const before = tempFiles();
+    uint64 const hitches = GetHitchCount();
+
+    EXPECT_FALSE(IsHitchCaptureEnabled());
+    EnableHitchCapture({.BudgetMilliseconds = 20.0, .WindowSeconds = 1.0});
+    EXPECT_TRUE(IsHitchCaptureEnabled());
+    EndFrame();
+    EndFrame();
+    EXPECT_EQ(GetHitchCount(), hitches);
+
+    {
+        LAT_PROFILE_ZONE("Hitch");
+        this_thread::sleep_for(chrono::milliseconds(30));
+    }
+    EndFrame();
+    EXPECT_EQ(GetHitchCount(), hitches + 1);
+    EXPECT_EQ(tempFiles(), before + 1);
+
+    // Inside the window just saved, so counted but not saved again.
+    this_thread::sleep_for(chrono::milliseconds(30));
+    EndFrame();
+    EXPECT_EQ(GetHitchCount(), hitches + 2);
+    EXPECT_EQ(tempFiles(), before + 1);
+
+    DisableHitchCapture();
+    EXPECT_FALSE(IsHitchCaptureEnabled());
+    this_thread::sleep_for(chrono::milliseconds(30));
+    EndFrame();
+    EXPECT_EQ(GetHitchCount(), hitches + 2);
+
+    for (filesystem::directory_entry const &entry :
+         filesystem::directory_iterator(filesystem::temp_directory_path()))
+    {
+        if (entry.path().filename().string().starts_with("Lateralus-Hitch-"))
+        {
+            stringstream json;
+            json << ifstream(entry.path()).rdbuf();
+            if (json.str().find("\"Hitch\"") != string::npos)
+            {
+                filesystem::remove(entry.path());
+            }
+        }
+    }
+    EXPECT_EQ(tempFiles(), before);
+}
+} // namespace Lateralus::Platform::ProfileCapture::Tests
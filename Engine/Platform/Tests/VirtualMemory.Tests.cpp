@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+import Lateralus.Core;
+import Lateralus.Platform.Error;
+import Lateralus.Platform.VirtualMemory;
+import <cstring>;
+import <memory_resource>;
+import <new>;
+import <optional>;
+import <string>;
+import <vector>;
+
+using namespace std;
+
+namespace Lateralus::Platform::VirtualMemory::Tests
+{
+TEST(Platform_VirtualMemory, ReserveCommitDecommit)
+{
+    usz const pageSize = GetPageSize();
+    usz const size = 64 * pageSize;
+    void *address = nullptr;
+    ASSERT_FALSE(Reserve(size, address).has_value());
+    ASSERT_NE(address, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(address) % GetReserveGranularity(), 0u);
+
+    auto *bytes = static_cast<unsigned char *>(address);
+    ASSERT_FALSE(Commit(bytes + pageSize, 2 * pageSize).has_value());
+    memset(bytes + pageSize, 0x5A, 2 * pageSize);
+    EXPECT_EQ(bytes[2 * pageSize], 0x5A);
+
+    // Decommitted pages come back zeroed.
+    EXPECT_FALSE(Decommit(bytes + pageSize, 2 * pageSize).has_value());
+    ASSERT_FALSE(Commit(bytes + pageSize, 2 * pageSize).has_value());
+    EXPECT_EQ(bytes[2 * pageSize], 0);
+    EXPECT_FALSE(Release(address, size).has_value());
+}
+
+TEST(Platform_VirtualMemory, HugePagesAreAligned)
+{
+    usz const size = 8 * 1024 * 1024;
+    void *address = nullptr;
+    ASSERT_FALSE(Reserve(size, address, true).has_value());
+#if PLATFORM_LINUX
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(address) % (2 * 1024 * 1024), 0u);
+#endif
+    ASSERT_FALSE(Commit(address, size).has_value());
+    memset(address, 1, size);
+    EXPECT_FALSE(Release(address, size).has_value());
+}
+
+TEST(Platform_VirtualMemory, ArenaGrowsInPlace)
+{
+    VirtualArena arena;
+    ASSERT_FALSE(arena.Init(16 * 1024 * 1024).has_value());
+    EXPECT_EQ(arena.GetCommitted(), 0u);
+
+    void *first = arena.Allocate(100);
+    ASSERT_NE(first, nullptr);
+    usz const committed = arena.GetCommitted();
+    EXPECT_GE(committed, 100u);
+    // Allocations run on past the first commit without moving what came before.
+    void *previous = first;
+    for (int i = 0; i < 1000; ++i)
+    {
+        void *next = arena.Allocate(1000, 16);
+        ASSERT_NE(next, nullptr);
+        EXPECT_GT(next, previous);
+        memset(next, i, 1000);
+        previous = next;
+    }
+    EXPECT_GT(arena.GetCommitted(), committed);
+    EXPECT_LE(arena.GetUsed(), arena.GetCommitted());
+
+    // Running out of address space fails instead of moving.
+    EXPECT_EQ(arena.Allocate(32 * 1024 * 1024), nullptr);
+    EXPECT_THROW((void)arena.allocate(32 * 1024 * 1024), bad_alloc);
+
+    arena.Reset();
+    EXPECT_EQ(arena.Allocate(100), first);
+    arena.Trim();
+    EXPECT_LT(arena.GetCommitted(), 1000u * 1000u);
+
+    pmr::vector<int> values(&arena);
+    values.assign(10000, 7);
+    EXPECT_EQ(values[9999], 7);
+}
+
+TEST(Platform_VirtualMemory, VectorNeverMoves)
+{
+    VirtualVector<string> strings;
+    ASSERT_FALSE(strings.Init(1'000'000).has_value());
+    EXPECT_EQ(strings.max_size(), 1'000'000u);
+    strings.emplace_back("first");
+    string *const first = &strings.front();
+    string const *const data = strings.data();
+    for (int i = 1; i < 100000; ++i)
+    {
+        strings.push_back(to_string(i));
+    }
+    EXPECT_EQ(strings.data(), data);
+    EXPECT_EQ(&strings.front(), first);
+    EXPECT_EQ(*first, "first");
+    EXPECT_EQ(strings.back(), "99999");
+    EXPECT_GE(strings.capacity(), strings.size());
+    EXPECT_LE(strings.capacity(), strings.max_size());
+
+    strings.resize(10);
+    EXPECT_EQ(strings.size(), 10u);
+    strings.shrink_to_fit();
+    EXPECT_LT(strings.capacity(), 100000u);
+    strings.resize(20);
+    EXPECT_EQ(strings[19], "");
+
+    usz count = 0;
+    for (string const &value : strings)
+    {
+        count += value.empty() ? 0 : 1;
+    }
+    EXPECT_EQ(count, 10u);
+
+    VirtualVector<string> moved = std::move(strings);
+    EXPECT_EQ(moved.size(), 20u);
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_TRUE(strings.empty());
+}
+
+TEST(Platform_VirtualMemory, VectorThrowsPastMaxSize)
+{
+    VirtualVector<int> values;
+    ASSERT_FALSE(values.Init(1000).has_value());
+    values.resize(1000);
+    EXPECT_EQ(values.capacity(), 1000u);
+
+    EXPECT_THROW(values.emplace_back(1), std::bad_alloc);
+    EXPECT_THROW(values.reserve(1001), std::bad_alloc);
+    EXPECT_THROW(values.resize(2000), std::bad_alloc);
+    EXPECT_EQ(values.size(), 1000u);
+    EXPECT_EQ(values.capacity(), 1000u);
+}
+} // namespace Lateralus::Platform::VirtualMemory::Tests